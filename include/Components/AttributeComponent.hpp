@@ -6,6 +6,7 @@
 
 
 #include "Components/Component.hpp"
+#include "Components/ComponentTypes.hpp"
 
 
 
@@ -18,6 +19,9 @@ namespace Asteroid
 
 	public:
 
+		//The slot Entity::Get<T>() looks this component up in.
+		static constexpr ComponentTypes m_componentType{ ComponentTypes::ATTRIBUTE };
+
 		AttributeComponent();
 
 		void Init(EntityHandle l_ownerEntityHandle, uint32_t l_hp);
@@ -28,6 +32,11 @@ namespace Asteroid
 
 		void SetHP(const uint32_t l_hp);
 
+
+		void Snapshot(SnapshotWriter& l_writer) const override;
+
+		void Restore(SnapshotReader& l_reader) override;
+
 	protected:
 
 		uint32_t m_hp{};
@@ -26,11 +26,14 @@ namespace Asteroid
 		void SetState(const AsteroidStates l_newState);
 
 
-		bool Update(UpdateComponents& l_updateContext) override;
+		bool Update(UpdateComponents& l_updateContext);
 
 		AsteroidStates GetState() const;
 
 
+		void Snapshot(SnapshotWriter& l_writer) const override;
+
+		void Restore(SnapshotReader& l_reader) override;
 
 	private:
 
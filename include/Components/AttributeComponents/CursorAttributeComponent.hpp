@@ -24,7 +24,7 @@ namespace Asteroid
 		void Init(EntityHandle l_ownerEntityHandle, uint32_t l_hp, RayMovementComponent* l_movementComp
 			, IndefiniteRepeatableAnimationComponent* l_mainAnimComponents);
 
-		bool Update(UpdateComponents& l_updateContext) override;
+		bool Update(UpdateComponents& l_updateContext);
 
 	private:
 
@@ -20,8 +20,6 @@ namespace Asteroid
 
 		void Init(EntityHandle l_ownerEntityHandle, uint32_t l_hp);
 
-		bool Update(UpdateComponents& l_updateContext) override;
-
 		void DecrementHPByOne();
 
 		void ResetHealth();
@@ -3,6 +3,7 @@
 
 
 #include "Components/Component.hpp"
+#include "Components/ComponentTypes.hpp"
 #include "Entities/EntityHandle.hpp"
 
 
@@ -19,6 +20,9 @@ namespace Asteroid
 
 	public:
 
+		//The slot Entity::Get<T>() looks this component up in.
+		static constexpr ComponentTypes m_componentType{ ComponentTypes::COLLISION };
+
 		CollisionComponent();
 
 
@@ -52,6 +56,10 @@ namespace Asteroid
 		virtual ~CollisionComponent() = default;
 
 
+		void Snapshot(SnapshotWriter& l_writer) const override;
+
+		void Restore(SnapshotReader& l_reader) override;
+
 	protected:
 
 		
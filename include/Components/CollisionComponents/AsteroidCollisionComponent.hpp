@@ -21,7 +21,7 @@ namespace Asteroid
 		AsteroidCollisionComponent();
 
 
-		bool Update(UpdateComponents& l_updateContext) override;
+		bool Update(UpdateComponents& l_updateContext);
 
 
 		void CollisionReaction(IEvent* l_collisionEvent) override;
@@ -40,6 +40,11 @@ namespace Asteroid
 
 		void SetBulletHitFlag(const uint32_t l_hitBullet);
 
+
+		void Snapshot(SnapshotWriter& l_writer) const override;
+
+		void Restore(SnapshotReader& l_reader) override;
+
 	private:
 
 		OnceRepeatableAnimationComponent* m_fireExplosionAnimation{};
@@ -19,8 +19,6 @@ namespace Asteroid
 
 		BulletCollisionComponent();
 
-		bool Update(UpdateComponents& l_updateContext) override;
-
 		void CollisionReaction(IEvent* l_collisionEvent) override;
 
 
@@ -6,8 +6,7 @@
 
 
 #include "Components/CollisionComponent.hpp"
-#include <vector>
-#include <utility>
+#include <bitset>
 
 
 namespace Asteroid
@@ -21,8 +20,6 @@ namespace Asteroid
 
 		PlayerCollisionComponent();
 
-		bool Update(UpdateComponents& l_updateContext) override;
-
 
 
 		void Init(EntityHandle l_ownerEntityHandle
@@ -36,17 +33,23 @@ namespace Asteroid
 
 		void CollisionReaction(IEvent* l_collisionEvent) override;
 
+		void AllowCollisionAgain(const uint32_t l_collidedEntityID);
+
+
+		void Snapshot(SnapshotWriter& l_writer) const override;
 
-		std::vector<std::pair<uint32_t, bool>> GetAlreadyRegisteredCollisionIDs() const;
-		   
+		void Restore(SnapshotReader& l_reader) override;
 
-		void SetAlreadyRegisteredCollisionIDs(const std::vector<std::pair<uint32_t, bool>>& l_registeredCollisions);
 
 	private:
 
 		PlayerAttributeComponent* m_attribComponent{};
 		uint32_t m_frameTimeToFlushRegisteredCollisionIDs{};
-		std::vector<std::pair<uint32_t, bool>> m_alreadyRegisteredCollisionEntityIDs;
+		//There can never be more registered collisions than there are asteroids.
+		//Bit i is set while the entity with id i cannot hurt the player again. A bitset keeps 
+		//the component small enough to fit in a block of the allocator pools.
+		static constexpr uint32_t m_maxNumEntities{ 256U };
+		std::bitset<m_maxNumEntities> m_collisionBlockedEntityIDs{};
 	};
 
 
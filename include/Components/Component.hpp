@@ -7,19 +7,26 @@
 namespace Asteroid
 {
 	struct UpdateComponents;
+	class SnapshotWriter;
+	class SnapshotReader;
 
 	class Component
 	{
 	public:
 		virtual ~Component() = default;
 
-		virtual bool Update(UpdateComponents& l_updateContext) = 0;
-
 		Component();
 
 
 		void Init(EntityHandle l_ownerEntityHandle);
 
+
+		//Writes/reads the component's mutable state as fixed size blocks.
+		//Restore() must read exactly what Snapshot() wrote and in the same order.
+		virtual void Snapshot(SnapshotWriter& l_writer) const = 0;
+
+		virtual void Restore(SnapshotReader& l_reader) = 0;
+
 	protected:
 		EntityHandle m_ownerEntityHandle;
 	};
@@ -25,6 +25,7 @@ namespace Asteroid
 		STATE,
 		ACTIVE_BASED_STATE,
 
+		TOTAL_NUM_COMPONENT_TYPES
 	};
 
 }
\ No newline at end of file
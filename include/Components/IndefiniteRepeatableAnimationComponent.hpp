@@ -4,6 +4,7 @@
 
 
 #include "Components/Component.hpp"
+#include "Components/ComponentTypes.hpp"
 
 #include <glm.hpp>
 
@@ -17,6 +18,7 @@ namespace Asteroid
 
 
 	struct AnimationMetaData;
+	struct ArchetypeTable;
 	class MovementComponent;
 	class ActiveBasedStateComponent;
 	
@@ -24,12 +26,18 @@ namespace Asteroid
 	{
 	public:
 
+		//The slot Entity::Get<T>() looks this component up in.
+		static constexpr ComponentTypes m_componentType{ ComponentTypes::INDEFINITE_ENTITY_ANIMATION };
+
 		IndefiniteRepeatableAnimationComponent();
 
-		virtual bool Update(UpdateComponents& l_updateContext) override;
+		bool Update(UpdateComponents& l_updateContext);
 
 
+		//The current frame offset is kept in row l_archetypeRow of l_archetype.
 		void Init(const EntityHandle l_entityHandle
+			, ArchetypeTable& l_archetype
+			, const uint32_t l_archetypeRow
 			, const AnimationMetaData* l_animationMetaData
 			, const MovementComponent* l_movementComponent
 			, ActiveBasedStateComponent* l_activeStateComponent
@@ -54,13 +62,19 @@ namespace Asteroid
 		uint32_t GetFrameCountToActivateVisbility() const;
 		uint32_t GetFrameCountToDeactivateVisbility() const;
 
+
+		void Snapshot(SnapshotWriter& l_writer) const override;
+
+		void Restore(SnapshotReader& l_reader) override;
+
 	private:
 
 		const AnimationMetaData* m_animationMetaData;
 		const MovementComponent* m_movementComponent;
 		ActiveBasedStateComponent* m_activeStateComponent;
 
-		uint32_t m_currentOffset{};
+		ArchetypeTable* m_archetype{};
+		uint32_t m_archetypeRow{};
 		bool m_isInWindowBound{true};
 		bool m_isVisible;
 
@@ -5,6 +5,7 @@
 
 #include <glm.hpp>
 #include "Components/Component.hpp"
+#include "Components/ComponentTypes.hpp"
 #include <gtc/matrix_transform.hpp>
 
 
@@ -13,34 +14,43 @@
 namespace Asteroid
 {
 
+	struct ArchetypeTable;
+
 	class MovementComponent : public Component
 	{
 	public:
+
+		//The slot Entity::Get<T>() looks this component up in.
+		static constexpr ComponentTypes m_componentType{ ComponentTypes::MOVEMENT };
 		
 		MovementComponent();
 
 		virtual ~MovementComponent() = default;
 
-		void SetSpeed(const glm::vec2& l_newSpeed);
+		void SetSpeed(const float l_newSpeed);
 
 		float GetCurrentAngleOfRotation() const;
 
-		const glm::vec2& GetSpeed() const;
+		float GetSpeed() const;
 
 		void SetAngleOfRotation(const float l_theta);
 
-		void Init(EntityHandle l_ownerEntityHandle);
+		//The speed and pause state are kept in row l_archetypeRow of l_archetype.
+		void Init(EntityHandle l_ownerEntityHandle, ArchetypeTable& l_archetype, const uint32_t l_archetypeRow);
 
 		void SetPauseState(const bool l_pauseState);
 
 		bool GetPauseState() const;
 
+
+		void Snapshot(SnapshotWriter& l_writer) const override;
+
+		void Restore(SnapshotReader& l_reader) override;
+
 	protected:
 		float m_thetaDegrees{};
-		
-		bool m_pauseMovement{ false };
 
-		//Speed along X and Y axis
-		glm::vec2 m_speed{0.f};
+		ArchetypeTable* m_archetype{};
+		uint32_t m_archetypeRow{};
 	};
 }
\ No newline at end of file
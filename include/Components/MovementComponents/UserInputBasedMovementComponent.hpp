@@ -16,9 +16,7 @@ namespace Asteroid
 
 		UserInputBasedMovementComponent();
 
-		bool Update(UpdateComponents& l_updateContext) override;
-
-		void Init(EntityHandle l_ownerEntityHandle);
+		bool Update(UpdateComponents& l_updateContext);
 
 	private:
 
@@ -4,6 +4,7 @@
 
 
 #include "Components/Component.hpp"
+#include "Components/ComponentTypes.hpp"
 #include <glm.hpp>
 
 
@@ -21,12 +22,14 @@ namespace Asteroid
 
 		OnceRepeatableAnimationComponent();
 
-		bool Update(UpdateComponents& l_updateContext) override;
+		bool Update(UpdateComponents& l_updateContext);
 
 		void StartAnimation();
 
 
+		//l_componentSlot is the slot of the entity the component is added to, since this class can fill more than one.
 		void Init(const EntityHandle l_entityHandle
+			, const ComponentTypes l_componentSlot
 			, const AnimationMetaData* l_animationMetaData
 			, const MovementComponent* l_movementComponent
 			, const bool l_followEntity = true);
@@ -43,8 +46,14 @@ namespace Asteroid
 
 		void Reset();
 
+
+		void Snapshot(SnapshotWriter& l_writer) const override;
+
+		void Restore(SnapshotReader& l_reader) override;
+
 	private:
 
+		ComponentTypes m_componentSlot{};
 		const AnimationMetaData* m_animationMetaData;
 		const MovementComponent* m_movementComponent;
 
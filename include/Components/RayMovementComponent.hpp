@@ -20,19 +20,17 @@ namespace Asteroid
 		void SetRayDirection(const glm::vec2& l_direction);
 		void SetInitialT(const float l_initialT);
 
-		virtual bool Update(UpdateComponents& l_updateContext) override;
-
-
-		void Init(EntityHandle l_ownerEntityHandle);
-
-
 		const glm::vec2& GetInitialPos() const;
 		const glm::vec2& GetRayDirection() const;
 		float GetInitalT() const;
 
+
+		void Snapshot(SnapshotWriter& l_writer) const override;
+
+		void Restore(SnapshotReader& l_reader) override;
+
 	private:
 		glm::vec2 m_initialPos{};
-		glm::vec2 m_rayDirection{};
 		float m_initialT{};
 	};
 }
\ No newline at end of file
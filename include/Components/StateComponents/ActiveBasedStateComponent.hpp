@@ -6,6 +6,7 @@
 
 
 #include "Components/StateComponent.hpp"
+#include "Components/ComponentTypes.hpp"
 #include "Components/IndefiniteRepeatableAnimationComponent.hpp"
 
 
@@ -19,9 +20,12 @@ namespace Asteroid
 	{
 	public:
 
+		//The slot Entity::Get<T>() looks this component up in.
+		static constexpr ComponentTypes m_componentType{ ComponentTypes::ACTIVE_BASED_STATE };
+
 		ActiveBasedStateComponent();
 
-		bool Update(UpdateComponents& l_updateContext) override;
+		bool Update(UpdateComponents& l_updateContext);
 
 
 		void Init(EntityHandle l_ownerEntityHandle
@@ -42,6 +46,11 @@ namespace Asteroid
 
 		
 
+
+		void Snapshot(SnapshotWriter& l_writer) const override;
+
+		void Restore(SnapshotReader& l_reader) override;
+
 	private:
 
 		CollisionComponent* m_collisionComponent{};
@@ -2,6 +2,7 @@
 
 
 
+#include <glm.hpp>
 
 namespace Asteroid
 {
@@ -13,6 +14,12 @@ namespace Asteroid
 		float m_deltaTime{};
 		Engine* m_engine{};
 		uint32_t m_totalNumAsteroidsHitByBullets{};
+
+		//Window size of the frame being simulated. Systems read it from here since they may run off the main thread.
+		glm::ivec2 m_windowSize{};
+
+		//Set while frames are re-simulated to rebuild a past state that is never shown.
+		bool m_skipRendering{};
 	};
 
 }
\ No newline at end of file
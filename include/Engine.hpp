@@ -6,18 +6,32 @@
 #include "Time.hpp"
 #include "Systems/GpuResouceManager.hpp"
 #include "Systems/Renderer.hpp"
+#include "Systems/RenderQueue.hpp"
+#include "Systems/ComponentSystems.hpp"
+#include "Systems/SystemScheduler.hpp"
+#include "Systems/JobSystem.hpp"
 #include "Systems/InputSystem.hpp"
 #include "Systems/EntityConnector.hpp"
 #include "Entities/EntityType.hpp"
 #include "Entities/EntityHandle.hpp"
 #include "Entities/Entity.hpp"
+#include "Entities/ArchetypeTable.hpp"
 #include "GeometryPrimitives/Circle.hpp"
 #include "Entities/EntitySpawnerFromPools.hpp"
 #include "Components/AnimationMetaData.hpp"
 #include "Systems/Grid.hpp"
 #include "Systems/MemoryAlloc.hpp"
+#include "Systems/FrameArena.hpp"
+#include "Systems/PoolMemoryResource.hpp"
+#include "Systems/AllocatorStatsPanel.hpp"
+#include "Systems/JobSystemStatsPanel.hpp"
+#include "Systems/MemorySnapshotHistory.hpp"
+#include "Systems/QuickSave.hpp"
+#include "Systems/GameSave.hpp"
 #include "Systems/CallbacksTimer.hpp"
 #include "Systems/TimeRewind/TimeRewind.hpp"
+#include "Systems/TimeRewind/InputReplayLog.hpp"
+#include "Systems/InputFrame.hpp"
 #include <vector>
 #include <glm.hpp>
 #include "Systems/EventSystem/EventManager.hpp"
@@ -29,6 +43,7 @@ struct SDL_Renderer;
 namespace Asteroid
 {
 
+	struct UpdateComponents;
 
 	class Engine
 	{
@@ -51,14 +66,19 @@ namespace Asteroid
 		const Entity& GetEntityFromType(const EntityType l_type) const;
 
 
+		std::vector<Entity>& GetEntities();
 		const std::vector<Entity>& GetEntities() const;
 
+		const ArchetypeTables& GetArchetypes() const;
+
 
 
 		const AnimationMetaData* GetAnimationMeta(const AnimationType l_type) const;
 
 		RenderSystem::Renderer* GetRenderer();
 
+		RenderSystem::RenderQueue& GetRenderQueue();
+
 		const InputSystem& GetInputSystem() const;
 
 		void GetCurrentWindowSize(glm::ivec2& l_windowRes) const;
@@ -80,13 +100,63 @@ namespace Asteroid
 
 		void InitEntitiesAndPools();
 
+		//Adds the systems a frame runs to m_systemScheduler together with the data each of them 
+		//touches. Must be called after InitEntitiesAndPools().
+		void InitSystems();
+
+		//Adds l_component to l_entity and, if its type is updated every frame, to m_componentSystems as well.
+		template<typename T>
+		void AddComponent(Entity& l_entity, const ComponentTypes l_componentType, T* l_component);
+
+		//Everything a frame does to the game apart from updating the delayed callbacks.
+		void SimulateFrame(UpdateComponents& l_updateComponent, const InputFrame& l_inputFrame);
+
+		void FillInputFrame(InputFrame& l_inputFrame, const glm::ivec2& l_windowSize, const bool l_timeRewinded) const;
+
+		//Handles rewinding, scrubbing and replay playback in INPUT_REPLAY mode, then records the
+		//input of the current frame into l_inputFrame and the log. Returns true if time was rewinded.
+		bool UpdateInputReplay(UpdateComponents& l_updateComponent, InputFrame& l_inputFrame, const glm::ivec2& l_windowSize
+			, const float l_scrubTime, const bool l_isScrubbing, const bool l_commitScrub, const uint32_t l_rewindSpeed);
+
+		//Restores the keyframe before l_frameIndex and re-simulates up to the start of that frame without rendering.
+		void ResimulateToFrame(const uint32_t l_frameIndex, UpdateComponents& l_updateComponent);
+
+		//Called whenever a level ends. In INPUT_REPLAY mode the level is saved as a replay first.
+		void FlushTimeRewind();
+
+		//Components are only reported as written while their entity is active. Anything that
+		//touches inactive entities calls m_allocator.MarkAllDirty() instead.
+		void MarkActiveEntitiesDirty();
+
+		void TakeQuickSave(const UpdateComponents& l_updateComponent);
+		bool LoadQuickSave(UpdateComponents& l_updateComponent);
+
+		bool SaveGameToFile(const UpdateComponents& l_updateComponent);
+		bool LoadGameFromFile(UpdateComponents& l_updateComponent);
+
+		//Brings back the state saved right after initialization and starts l_level from it.
+		//It replaces the pending callbacks, so it must not be called from within one of them.
+		void RestartLevel(UpdateComponents& l_updateComponent, const uint32_t l_level);
+
+		//Drops the rewind history without saving it as a replay.
+		void DiscardRewindHistory();
+
 	private:
 
 		EngineInitData m_initialData;
 
+		//Declared early so it outlives everything that starts jobs.
+		JobSystem m_jobSystem{};
+
+		//Backs the containers of the engine. Kept apart from m_allocator so restoring a pool 
+		//snapshot of the components never takes memory away from a container.
+		MemoryAlloc m_containerAllocator{};
+		PoolMemoryResource m_containerMemoryResource{ m_containerAllocator };
+
 		//Wanted to have pointer here but vector of entities might grow
 		//and invalidate the ptr.
 		uint32_t m_playerEntityHandle{};
+		ArchetypeTables m_archetypes{};
 		std::vector<Entity> m_entities{};
 		std::vector<Circle> m_circleBoundsEntities{};
 		std::vector<AnimationMetaData> m_animationMetaData;
@@ -98,15 +168,32 @@ namespace Asteroid
 		uint32_t m_backgroundStars2TextureHandle{};
 
 		RenderSystem::Renderer m_renderer;
+		RenderSystem::RenderQueue m_renderQueue{};
+		ComponentSystems<ComponentUpdatePipeline> m_componentSystems{};
+		SystemScheduler m_systemScheduler{};
 		InputSystem m_inputSystem;
 		EntitySpawnerFromPools m_entitySpawnerFromPools;
 		Grid m_grid;
 		CallbacksTimer m_callbacksTimer{};
 		TimeRewind m_timeRewind{};
+		TimeRewindMode m_timeRewindMode{ TimeRewindMode::STATE_SNAPSHOTS };
+		InputReplayLog m_inputReplayLog{};
+		bool m_isPlayingReplay{};
+		uint32_t m_replayFrameIndex{};
 
 		MemoryAlloc m_allocator{};
+		MemorySnapshotHistory m_componentSnapshots{};
+		QuickSave m_quickSave{};
+		std::vector<uint8_t> m_levelStartSave{};
+		std::vector<uint8_t> m_gameSave{};
+
+		EventManager m_eventManager{ &m_containerMemoryResource };
+
+		//Collision events and anything else that is thrown away at the end of the frame.
+		DoubleBufferedFrameArena m_frameArena{};
 
-		EventManager m_eventManager{};
+		AllocatorStatsPanel m_allocatorStatsPanel{};
+		JobSystemStatsPanel m_jobSystemStatsPanel{};
 
 		GpuResourceManager m_gpuResourceManager;
 
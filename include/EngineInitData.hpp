@@ -9,7 +9,10 @@
 #include <SDL3/SDL_init.h>
 #include <vector>
 #include <utility>
+#include <thread>
+#include <algorithm>
 #include "Components/AnimationMetaData.hpp"
+#include "Systems/TimeRewind/TimeRewindInitData.hpp"
 
 
 namespace Asteroid
@@ -21,5 +24,30 @@ namespace Asteroid
 		std::string m_windowTitle;
 		std::vector<std::pair<std::string, std::string>> m_mappedTextureNamesToTheirPaths;
 		std::vector<AnimationMetaData> m_animationMetaData{};
+		TimeRewindInitData m_timeRewindInitData{};
+
+		//F5 writes the current level here and F9 loads it back when there is no quicksave in memory.
+		std::string m_quickSaveFilePath{ "QuickSave.bin" };
+
+		//Locks the pools of the allocators into memory once they are set up, so they are never paged out.
+		bool m_lockAllocatorMemory{ false };
+
+		//Per size class allocator counters are appended here every m_allocatorStatsDumpIntervalInSeconds.
+		std::string m_allocatorStatsFilePath{ "AllocatorStats.csv" };
+		float m_allocatorStatsDumpIntervalInSeconds{ 5.f };
+
+		//If not zero, the game loop counts heap allocations and quits after this many frames past 
+		//the warm up. GameLoop() fails if any of them allocated.
+		uint32_t m_totalNumAllocationCheckFrames{};
+		uint32_t m_totalNumAllocationWarmUpFrames{ 300U };
+
+		//Threads the JobSystem runs jobs on besides the main thread. Zero runs every job on the main thread.
+		uint32_t m_totalNumJobWorkers{ std::max(std::thread::hardware_concurrency(), 1U) - 1U };
+
+		//Pins every job worker to its own core. Only has an effect on Linux.
+		bool m_pinJobWorkersToCores{ false };
+
+		//Checks every frame that the systems only touch the data they declared. Slow, meant for debugging.
+		bool m_verifySystemAccess{ false };
 	};
 }
\ No newline at end of file
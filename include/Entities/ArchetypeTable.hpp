@@ -0,0 +1,83 @@
+#pragma once
+
+
+
+#include "Entities/EntityType.hpp"
+#include <glm.hpp>
+#include <vector>
+#include <array>
+#include <cinttypes>
+
+
+namespace Asteroid
+{
+
+	enum class ArchetypeFlags : uint8_t
+	{
+		ACTIVE = 1U << 0,
+		MOVEMENT_PAUSED = 1U << 1
+	};
+
+
+	//The per frame state of every entity of one type laid out column by column, so systems
+	//can walk a single column from start to end. Rows are only added during initialization
+	//and never removed, so a row index stays valid for the lifetime of the table.
+	struct ArchetypeTable final
+	{
+		uint32_t AddRow(const uint32_t l_entityIndex, const glm::vec2& l_initialPos, const bool l_isActive);
+
+		uint32_t GetTotalNumRows() const;
+
+		bool HasFlag(const uint32_t l_row, const ArchetypeFlags l_flag) const;
+
+		//Setting or clearing ACTIVE adds the row to or removes it from the active rows in O(1).
+		void SetFlag(const uint32_t l_row, const ArchetypeFlags l_flag, const bool l_state);
+
+		//The rows that have the ACTIVE flag, in no particular order. Removing a row moves the last
+		//one into its place, so a pass that walks them back to front may deactivate the current row.
+		const std::vector<uint32_t>& GetActiveRows() const;
+
+		EntityType m_type{};
+
+		std::vector<uint32_t> m_entityIndices{};
+		std::vector<glm::vec2> m_positions{};
+		std::vector<glm::vec2> m_rayDirections{};
+		std::vector<float> m_speeds{};
+		std::vector<uint32_t> m_animationOffsets{};
+		std::vector<uint8_t> m_flags{};
+
+		//Sparse set of the active rows, only written by SetFlag(). m_activeRowSlots holds where
+		//each row is in m_activeRows, or m_inactiveRowSlot if it is not active.
+		static constexpr uint32_t m_inactiveRowSlot{ UINT32_MAX };
+		std::vector<uint32_t> m_activeRows{};
+		std::vector<uint32_t> m_activeRowSlots{};
+	};
+
+
+	class ArchetypeTables final
+	{
+	public:
+
+		ArchetypeTables();
+
+		ArchetypeTable& Get(const EntityType l_type);
+		const ArchetypeTable& Get(const EntityType l_type) const;
+
+		//Calls l_function with the entity index of every active entity, one table after the other.
+		//l_function may deactivate the entity it is called with but must not activate any.
+		template<typename F>
+		void ForEachActiveEntity(F&& l_function) const
+		{
+			for (const auto& l_table : m_tables) {
+				const auto& lv_activeRows = l_table.GetActiveRows();
+
+				for (uint32_t i = (uint32_t)lv_activeRows.size(); 0U < i; --i) {
+					l_function(l_table.m_entityIndices[lv_activeRows[i - 1U]]);
+				}
+			}
+		}
+
+	private:
+		std::array<ArchetypeTable, (size_t)EntityType::TOTAL_NUM_ENTITY_TYPES> m_tables{};
+	};
+}
\ No newline at end of file
@@ -8,28 +8,47 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <array>
+#include <cassert>
+#include <type_traits>
 #include "Components/ComponentTypes.hpp"
 #include "EntityType.hpp"
 #include "Components/Component.hpp"
+#include "Systems/Handle.hpp"
 
 
 
 namespace Asteroid
 {
 
+	class SnapshotWriter;
+	class SnapshotReader;
+	class MemoryAlloc;
+	struct ArchetypeTable;
+
 	class Entity
 	{
 	public:
 
-		Entity(const glm::vec2& l_initialPos, uint32_t l_id, const EntityType l_type, const bool l_isActive);
+		//The position and active state live in row l_archetypeRow of l_archetype, which must outlive the entity.
+		Entity(ArchetypeTable& l_archetype, const uint32_t l_archetypeRow, uint32_t l_id, const EntityType l_type);
 
 		Entity(Entity&&) = default;
 			
-		void AddComponent(const ComponentTypes l_componentType, Component* l_component);
+		//False if the entity already has a component in that slot.
+		bool AddComponent(const ComponentTypes l_componentType, Component* l_component);
 
 		Component* GetComponent(const ComponentTypes l_componentType) const;
 
-		bool Update(UpdateComponents& l_updateComponents);
+		bool HasComponent(const ComponentTypes l_componentType) const;
+
+		//The slot is taken from T::m_componentType at compile time, so this is a single indexed load.
+		template<typename T>
+		T* Get() const;
+
+		//For component classes that can fill more than one slot, such as the once repeatable animations.
+		template<typename T>
+		T* Get(const ComponentTypes l_componentType) const;
 
 		const glm::vec2& GetCurrentPos() const;
 
@@ -42,18 +61,70 @@ namespace Asteroid
 
 		uint32_t GetID() const;
 
+		//Every time an entity is taken from its pool again it starts a new generation, so the handles
+		//made during its previous life stop resolving.
+		void Recycle();
+		uint32_t GetGeneration() const;
+		//Only for bringing back a saved state, so handles made before the save resolve again.
+		void SetGeneration(const uint32_t l_generation);
+		Handle<Entity> GetHandle() const;
+
+		//nullptr if the entity l_handle was made for has been recycled since.
+		static Entity* Resolve(std::vector<Entity>& l_entities, const Handle<Entity> l_handle);
+
 		void SetActiveState(const bool l_activeState);
 
 		bool GetActiveState() const;
 
+		ArchetypeTable& GetArchetype() const;
+		uint32_t GetArchetypeRow() const;
+
+
+		//Writes the entity's own state followed by the state of each of its components.
+		void Snapshot(SnapshotWriter& l_writer) const;
+
+		//The active state is not part of the snapshot and is left to the caller.
+		void Restore(SnapshotReader& l_reader);
+
+		//Reports the blocks of all components as written to the allocator they live in.
+		void MarkComponentsDirty(MemoryAlloc& l_allocator) const;
+
 	protected:
 
-		glm::vec2 m_currentPos;
+		ArchetypeTable* m_archetype;
+		uint32_t m_archetypeRow;
 		uint32_t m_id;
+		uint32_t m_generation{};
 		EntityType m_type;
-		bool m_isActive;
 
 
-		std::vector<std::pair<ComponentTypes , Component*>> m_components;
+		static constexpr uint32_t m_totalNumComponentSlots{ (uint32_t)ComponentTypes::TOTAL_NUM_COMPONENT_TYPES };
+
+		std::array<Component*, m_totalNumComponentSlots> m_components{};
+		uint32_t m_componentsMask{};
+
+		//Components snapshot in the order they were added, which the snapshot format relies on.
+		std::array<ComponentTypes, m_totalNumComponentSlots> m_componentsOrder{};
+		uint32_t m_totalNumComponents{};
 	};
+
+
+	template<typename T>
+	T* Entity::Get() const
+	{
+		return Get<T>(T::m_componentType);
+	}
+
+
+	template<typename T>
+	T* Entity::Get(const ComponentTypes l_componentType) const
+	{
+		static_assert(true == std::is_base_of_v<Component, T>, "Entity::Get() only returns components.");
+
+		Component* lv_component = m_components[(uint32_t)l_componentType];
+
+		assert(nullptr == lv_component || nullptr != dynamic_cast<T*>(lv_component));
+
+		return static_cast<T*>(lv_component);
+	}
 }
\ No newline at end of file
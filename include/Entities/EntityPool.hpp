@@ -12,6 +12,9 @@ namespace Asteroid
 {
 
 	class Entity;
+	class SnapshotWriter;
+	class SnapshotReader;
+	struct ArchetypeTable;
 
 	class EntityPool
 	{
@@ -24,7 +27,9 @@ namespace Asteroid
 
 		EntityHandle GetNextInactiveEntityHandle();
 
-		void Update(const std::vector<Entity>& l_entities);
+		//Costs O(active entities) of the pool. l_table has to be the table of the pool's type so
+		//entities activated without going through the pool, e.g. by a rewind, are taken out of it.
+		void Update(const std::vector<Entity>& l_entities, const ArchetypeTable& l_table);
 
 
 		void Reset();
@@ -32,6 +37,14 @@ namespace Asteroid
 		uint32_t GetTotalNumInactiveEntities() const;
 		uint32_t GetTotalNumActiveEntities() const;
 
+		//The reuse order of the active entities cannot be derived from the entities themselves.
+		void Snapshot(SnapshotWriter& l_writer) const;
+		void Restore(SnapshotReader& l_reader);
+
+		//Reads past what Snapshot() writes and checks it can be restored into this pool. Every index
+		//has to be UINT32_MAX or one of the entities of the pool. Nothing of the pool is changed.
+		bool ValidateSnapshot(SnapshotReader& l_reader) const;
+
 	private:
 		//This vector will either have a valid entity index or UINT32_MAX
 		std::vector<uint32_t> m_inactiveEntityIndices{};
@@ -14,6 +14,8 @@ namespace Asteroid
 
 	class InputSystem;
 	class Engine;
+	class SnapshotWriter;
+	class SnapshotReader;
 	
 	class EntitySpawnerFromPools
 	{
@@ -28,6 +30,16 @@ namespace Asteroid
 
 		void ResetPools();
 
+		//Spawning is the only consumer of randomness, so this is the whole random state of the game.
+		const std::mt19937& GetRandomEngine() const;
+		void SetRandomEngine(const std::mt19937& l_randomEngine);
+
+		void SnapshotPools(SnapshotWriter& l_writer) const;
+		void RestorePools(SnapshotReader& l_reader);
+
+		//True if l_reader holds exactly what SnapshotPools() writes and every index in it belongs to its pool.
+		bool ValidatePoolsSnapshot(SnapshotReader& l_reader) const;
+
 	private:
 
 		bool BulletSpawnConditionMet(const bool l_timeRewinded);
@@ -12,6 +12,8 @@ namespace Asteroid
 		PLAYER = 0,
 		BULLET,
 		ASTEROID,
-		CURSOR
+		CURSOR,
+
+		TOTAL_NUM_ENTITY_TYPES
 	};
 }
\ No newline at end of file
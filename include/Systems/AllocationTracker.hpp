@@ -0,0 +1,53 @@
+#pragma once
+
+
+
+
+
+#include <cinttypes>
+#include <cstddef>
+
+
+namespace Asteroid
+{
+
+	/*
+	* Opt-in check that the game loop does not allocate once it has warmed up. Global operator new
+	* is always hooked, and InstallLibraryHooks() routes the allocations of SDL and ImGui through 
+	* the tracker too. Nothing is counted unless Enable() was called.
+	*/
+	namespace AllocationTracker
+	{
+
+		enum class LoopPhase : uint32_t
+		{
+			INPUT = 0,
+			SIMULATION,
+			UI,
+			RENDERING,
+			TOTAL_NUM_PHASES
+		};
+
+
+		void Enable(const uint32_t l_totalNumWarmUpFrames);
+		bool IsEnabled();
+
+		//Has to be called before SDL and ImGui allocate anything.
+		void InstallLibraryHooks();
+
+		void BeginFrame();
+		void SetPhase(const LoopPhase l_phase);
+
+		//Returns false if the frame allocated after the warm up, in which case a report with 
+		//the allocations per phase and the call stacks of the first few is printed.
+		bool EndFrame();
+
+		//Frames after the warm up.
+		uint64_t GetTotalNumFramesChecked();
+		uint64_t GetTotalNumFramesThatAllocated();
+
+		//Called by the hooks.
+		void RecordAllocation(const size_t l_sizeInBytes);
+	}
+
+}
\ No newline at end of file
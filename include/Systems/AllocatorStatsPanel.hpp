@@ -0,0 +1,66 @@
+#pragma once
+
+
+
+
+
+#include "Systems/MemoryPoolStats.hpp"
+#include "Systems/MemoryAlloc.hpp"
+#include <array>
+#include <string>
+#include <fstream>
+#include <cinttypes>
+
+
+namespace Asteroid
+{
+
+	/*
+	* Shows the per size class counters of the allocators in an ImGui window and appends them 
+	* to a CSV file every few seconds, so pool sizes can be tuned from what the game really uses.
+	*/
+	class AllocatorStatsPanel final
+	{
+	public:
+
+		static constexpr uint32_t m_maxNumAllocators{ 2U };
+
+		//An empty path or a zero interval disables the CSV dump.
+		void Init(const std::string& l_csvFilePath, const float l_dumpIntervalInSeconds);
+
+		//l_name has to outlive the panel.
+		void AddAllocator(const char* l_name, MemoryAlloc& l_allocator);
+
+		//Samples the counters once a second to work out the rates.
+		void Update(const float l_timeInSeconds);
+
+		void Render() const;
+
+	private:
+
+		struct TrackedAllocator
+		{
+			const char* m_name{};
+			MemoryAlloc* m_allocator{};
+			std::array<SizeClassStats, MemoryAlloc::m_totalNumPools> m_stats{};
+			std::array<float, MemoryAlloc::m_totalNumPools> m_allocationsPerSecond{};
+			std::array<float, MemoryAlloc::m_totalNumPools> m_freesPerSecond{};
+		};
+
+		void DumpToCsv(const float l_timeInSeconds);
+
+	private:
+
+		static constexpr float m_sampleIntervalInSeconds{ 1.f };
+
+		std::array<TrackedAllocator, m_maxNumAllocators> m_allocators{};
+		uint32_t m_totalNumAllocators{};
+
+		float m_lastSampleTime{};
+		float m_lastDumpTime{};
+		float m_dumpIntervalInSeconds{};
+
+		std::ofstream m_csvFile{};
+	};
+
+}
\ No newline at end of file
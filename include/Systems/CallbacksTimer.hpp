@@ -5,7 +5,9 @@
 
 
 #include "Systems/DelayedSetStateCallback.hpp"
+#include "Systems/DelayedCallbackState.hpp"
 #include <vector>
+#include <deque>
 
 
 namespace Asteroid
@@ -23,13 +25,31 @@ namespace Asteroid
 
 		void FlushAllCallbacks();
 
-		const std::vector<DelayedSetStateCallback>& GetDelayedCallbacks() const;
-		void SetDelayedCallbacks(const std::vector<DelayedSetStateCallback>& l_delayedCallbacks);
+		//Fills l_states with the state of the pending callbacks and returns the smallest id among them.
+		//If there are none, the id the next added callback is going to get is returned.
+		uint32_t GetDelayedCallbackStates(std::vector<DelayedCallbackState>& l_states) const;
+
+		//Rebuilds the pending callbacks from their states. All the ids must still be registered.
+		void RestoreDelayedCallbacks(const DelayedCallbackState* l_states, const uint32_t l_totalNumStates);
+
+		//Every added callback stays registered so it can be restored later on.
+		//Once nothing can reference the old ones anymore they can be released.
+		void ReleaseRegisteredCallbacksOlderThan(const uint32_t l_id);
+
+		void CopyPendingCallbacks(std::vector<DelayedSetStateCallback>& l_callbacks) const;
+
+		//The callbacks are registered again under new ids since their old ones may have been released.
+		void ReplacePendingCallbacks(const std::vector<DelayedSetStateCallback>& l_callbacks);
 
 
 	private:
 
 		std::vector<DelayedSetStateCallback> m_delayedSetStateCallbacks{};
+
+		//m_registeredCallbacks[i] is the callback with id m_firstRegisteredCallbackID + i.
+		std::deque<DelayedSetStateCallback> m_registeredCallbacks{};
+		uint32_t m_firstRegisteredCallbackID{};
+		uint32_t m_nextCallbackID{};
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+
+
+
+#include "Entities/Entity.hpp"
+#include "Entities/ArchetypeTable.hpp"
+#include <vector>
+#include <tuple>
+#include <array>
+#include <bit>
+#include <type_traits>
+#include <cinttypes>
+
+
+namespace Asteroid
+{
+
+	struct UpdateComponents;
+	class UserInputBasedMovementComponent;
+	class CursorAttributeComponent;
+	class AsteroidAttributeComponent;
+	class AsteroidCollisionComponent;
+	class ActiveBasedStateComponent;
+	class IndefiniteRepeatableAnimationComponent;
+	class OnceRepeatableAnimationComponent;
+
+
+	template<typename... T>
+	struct ComponentTypeList final
+	{
+		template<typename U>
+		static constexpr bool m_contains{ (std::is_same_v<U, T> || ...) };
+	};
+
+
+	/*
+	* The component types that are updated every frame. The order they run in follows from the 
+	* data the systems that update them declare in Engine::InitSystems(): movement -> steering ->
+	* collision bookkeeping -> state -> animation. Component types that do nothing per frame are not listed.
+	*/
+	using ComponentUpdatePipeline = ComponentTypeList<
+		UserInputBasedMovementComponent,
+		CursorAttributeComponent,
+		AsteroidAttributeComponent,
+		AsteroidCollisionComponent,
+		ActiveBasedStateComponent,
+		IndefiniteRepeatableAnimationComponent,
+		OnceRepeatableAnimationComponent>;
+
+
+	//The slots a component type of the pipeline is kept in, one bit per ComponentTypes value for each entity type.
+	template<typename T>
+	struct ComponentSlots final
+	{
+		std::array<uint32_t, (size_t)EntityType::TOTAL_NUM_ENTITY_TYPES> m_slotMasks{};
+	};
+
+
+	template<typename TypeList>
+	class ComponentSystems;
+
+	//Keeps which slots hold each pipeline component type, so each type can be updated on its own by a 
+	//system of the SystemScheduler. Only the active rows of the archetype tables are walked, so the cost 
+	//of an update follows the number of active entities instead of the number of registered components.
+	//Component::Update() is not virtual, so every call is bound at compile time.
+	template<typename... T>
+	class ComponentSystems<ComponentTypeList<T...>> final
+	{
+	public:
+
+		static_assert((uint32_t)ComponentTypes::TOTAL_NUM_COMPONENT_TYPES <= 32U, "The slot masks only have 32 bits.");
+
+		template<typename U>
+		void Register(const EntityType l_ownerType, const ComponentTypes l_componentSlot)
+		{
+			static_assert(true == ComponentTypeList<T...>::template m_contains<U>, "The component type is not part of the pipeline.");
+
+			std::get<ComponentSlots<U>>(m_slots).m_slotMasks[(size_t)l_ownerType] |= (1U << (uint32_t)l_componentSlot);
+		}
+
+		//Updates every component of type U owned by an active entity. Stops at the first component that fails.
+		template<typename U>
+		bool UpdateType(UpdateComponents& l_updateContext, const std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes)
+		{
+			for (uint32_t i = 0; i < (uint32_t)EntityType::TOTAL_NUM_ENTITY_TYPES; ++i) {
+				if (false == UpdateType<U>(l_updateContext, l_entities, l_archetypes, (EntityType)i)) {
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		//Same as above but only for the components owned by entities of l_ownerType, so the 
+		//entity types can be updated by different systems. The rows are walked back to front
+		//since an update may deactivate its own entity.
+		template<typename U>
+		bool UpdateType(UpdateComponents& l_updateContext, const std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, const EntityType l_ownerType)
+		{
+			const uint32_t lv_slotMask = std::get<ComponentSlots<U>>(m_slots).m_slotMasks[(size_t)l_ownerType];
+
+			//Types that never had a U are skipped before their table is touched.
+			if (0U == lv_slotMask) {
+				return true;
+			}
+
+			const auto& lv_table = l_archetypes.Get(l_ownerType);
+			const auto& lv_activeRows = lv_table.GetActiveRows();
+
+			for (uint32_t i = (uint32_t)lv_activeRows.size(); 0U < i; --i) {
+				const auto& lv_owner = l_entities[lv_table.m_entityIndices[lv_activeRows[i - 1U]]];
+
+				for (uint32_t lv_slots = lv_slotMask; 0U != lv_slots; lv_slots &= (lv_slots - 1U)) {
+					U* lv_component = lv_owner.Get<U>((ComponentTypes)std::countr_zero(lv_slots));
+
+					if (nullptr == lv_component) {
+						continue;
+					}
+
+					if (false == lv_component->Update(l_updateContext)) {
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+
+	private:
+		std::tuple<ComponentSlots<T>...> m_slots{};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+
+
+
+
+#include <cinttypes>
+
+
+namespace Asteroid
+{
+
+	enum class DelayedCallbackType : uint32_t
+	{
+		//Callbacks that only make sense outside of a level, such as the ones moving on to the next level.
+		//They are never written into a save.
+		NONE = 0,
+		ACTIVATE_COLLISION,
+		DEACTIVATE_COLLISION,
+		SHOW_MAIN_ANIMATION,
+		RESUME_MOVEMENT,
+		DEACTIVATE_ENTITY,
+		ALLOW_PLAYER_COLLISION_AGAIN
+	};
+
+
+	//What a DelayedSetStateCallback does in a form that can be written into a save file.
+	//DelayedCallbacks::Create() turns it back into the callable.
+	struct DelayedCallbackDescriptor final
+	{
+		DelayedCallbackType m_type{};
+		uint32_t m_entityID{};
+
+		//The callback does nothing once the entity has been recycled and is in another generation.
+		uint32_t m_entityGeneration{};
+
+		//Only used by ALLOW_PLAYER_COLLISION_AGAIN as the id of the asteroid the player collided with.
+		uint32_t m_argument{};
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+
+
+
+#include <cinttypes>
+
+
+
+namespace Asteroid
+{
+
+	//The part of a DelayedSetStateCallback that changes from frame to frame. The callable 
+	//itself is kept by CallbacksTimer and looked up by id, so this can be memcpy'd freely.
+	struct DelayedCallbackState final
+	{
+		uint32_t m_id{};
+		uint32_t m_currentFrame{};
+	};
+
+
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+
+
+
+
+#include "Systems/DelayedSetStateCallback.hpp"
+#include "Systems/DelayedCallbackDescriptor.hpp"
+#include <vector>
+
+
+namespace Asteroid
+{
+
+	class Entity;
+
+	namespace DelayedCallbacks
+	{
+		//Builds the callback described by l_descriptor for the entity it refers to in l_entities, which has to outlive the callback.
+		//Every delayed callback of a level is made here, so a save only has to store the descriptors.
+		DelayedSetStateCallback Create(std::vector<Entity>& l_entities, const DelayedCallbackDescriptor& l_descriptor, const uint32_t l_maxNumFrames);
+	}
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 
 
+#include "Systems/DelayedCallbackDescriptor.hpp"
 #include <functional>
 
 
@@ -17,6 +18,11 @@ namespace Asteroid
 		std::function<void()> m_callback{};
 		uint32_t m_currentFrame{};
 		uint32_t m_maxNumFrames{};
+
+		DelayedCallbackDescriptor m_descriptor{};
+
+		//Assigned by CallbacksTimer when the callback is added.
+		uint32_t m_id{};
 	};
 
 
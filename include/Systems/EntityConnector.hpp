@@ -29,7 +29,7 @@ namespace Asteroid
 		const glm::vec2& RequestPositionFromPlayer();
 		float RequestAngleRotationFromPlayer();
 
-		const glm::vec2& RequestSpeedFromPlayer();
+		float RequestSpeedFromPlayer();
 
 	private:
 		static constexpr uint32_t m_totalNumCachedIndices{32U};
@@ -7,6 +7,8 @@
 #include "Systems/EventSystem/IEvent.hpp"
 #include "Systems/EventSystem/EventType.hpp"
 #include "Entities/EntityHandle.hpp"
+#include "Systems/Handle.hpp"
+#include <vector>
 
 
 namespace Asteroid
@@ -18,8 +20,10 @@ namespace Asteroid
 	{
 	public:
 
-		EventCollision(Entity* l_entity1
-			, Entity* l_entity2
+		//l_entities has to outlive the event.
+		EventCollision(const Handle<Entity> l_entity1
+			, const Handle<Entity> l_entity2
+			, std::vector<Entity>* l_entities
 			, CallbacksTimer* l_callbackTimer);
 
 
@@ -30,9 +34,12 @@ namespace Asteroid
 		EventCollision& operator=(EventCollision&&) = default;
 
 
+		//nullptr once the entity has been recycled since the collision.
 		Entity* GetEntity1();
 		Entity* GetEntity2();
 
+		std::vector<Entity>& GetEntities();
+
 		std::string GetName() const override;
 
 		size_t GetTrueTypeSize() const override;
@@ -44,8 +51,9 @@ namespace Asteroid
 		CallbacksTimer* m_callbackTimer{};
 
 	private:
-		Entity* m_entity1;
-		Entity* m_entity2;
+		Handle<Entity> m_entity1;
+		Handle<Entity> m_entity2;
+		std::vector<Entity>* m_entities;
 		EventType m_type{ 0xe0dcc046 };
 
 	};
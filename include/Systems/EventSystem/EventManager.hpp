@@ -6,6 +6,7 @@
 #include <vector>
 #include <unordered_map>
 #include <array>
+#include <memory_resource>
 #include "Systems/EventSystem/EventType.hpp"
 
 
@@ -19,12 +20,13 @@ namespace Asteroid
 	{
 		static constexpr uint32_t m_totalNumQueues{ 2U };
 
-		typedef std::unordered_map<EventType, std::vector<std::function<void()>>> EventTypesMappedToDelegates;
-		typedef std::array<std::unordered_map<EventType,EventType>, m_totalNumQueues> EventQueues;
+		typedef std::pmr::unordered_map<EventType, std::pmr::vector<std::function<void()>>> EventTypesMappedToDelegates;
+		typedef std::array<std::pmr::unordered_map<EventType,EventType>, m_totalNumQueues> EventQueues;
 
 	public:
 
-		EventManager() = default;
+		//The containers of the manager allocate from l_memoryResource.
+		explicit EventManager(std::pmr::memory_resource* l_memoryResource);
 		EventManager(const EventManager&) = delete;
 		EventManager(EventManager&&) = default;
 
@@ -42,8 +44,8 @@ namespace Asteroid
 
 	private:
 
-		EventTypesMappedToDelegates m_eventTypesMappedToTheirDelegates{};
-		EventQueues m_eventQueues{};
+		EventTypesMappedToDelegates m_eventTypesMappedToTheirDelegates;
+		EventQueues m_eventQueues;
 		uint32_t m_currentActiveQueueIndex{};
 	};
 
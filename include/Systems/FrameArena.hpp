@@ -0,0 +1,94 @@
+#pragma once
+
+
+
+
+
+#include <cinttypes>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <memory>
+#include <new>
+#include <utility>
+
+
+namespace Asteroid
+{
+
+	/*
+	* Linear allocator for data that only lives until the end of the frame. Allocating bumps 
+	* an offset and Reset() gives everything back at once by setting it to zero. Destructors 
+	* are never run, so only objects whose destructors do nothing but free memory should live here.
+	* 
+	* Allocations that do not fit anymore go into overflow chunks, which are freed on the next 
+	* Reset() and make the arena grow so that a frame of that size fits next time.
+	*/
+	class FrameArena final
+	{
+	public:
+
+		FrameArena() = default;
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		FrameArena(FrameArena&&) = default;
+		FrameArena& operator=(FrameArena&&) = default;
+
+		void Init(const size_t l_sizeInBytes);
+
+		//l_alignment has to be a power of two.
+		void* Allocate(const size_t l_sizeInBytes, const size_t l_alignment);
+
+		template<typename T, typename... Args>
+		T* Create(Args&&... l_args)
+		{
+			return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(l_args)...);
+		}
+
+		//Debug builds fill the memory given back with m_poisonValue so use after reset stands out.
+		void Reset();
+
+		size_t GetCapacityInBytes() const;
+		size_t GetNumBytesAllocated() const;
+
+	private:
+
+		static constexpr unsigned char m_poisonValue{ 0xDD };
+
+		std::unique_ptr<unsigned char[]> m_buffer{};
+		size_t m_capacityInBytes{};
+		size_t m_offset{};
+
+		std::vector<std::unique_ptr<unsigned char[]>> m_overflowChunks{};
+		size_t m_numOverflowBytes{};
+	};
+
+
+
+	/*
+	* Two arenas used in turns, for data that has to survive one more frame than the one 
+	* it was allocated in, e.g. events sitting in the queue of the previous frame.
+	*/
+	class DoubleBufferedFrameArena final
+	{
+	public:
+
+		void Init(const size_t l_sizeInBytesPerArena);
+
+		//Makes the arena of two frames ago the current one and resets it.
+		void SwapAndReset();
+
+		//Resets both arenas. Nothing allocated from either may be used afterwards.
+		void ResetAll();
+
+		FrameArena& GetCurrent();
+
+	private:
+
+		std::array<FrameArena, 2U> m_arenas{};
+		uint32_t m_currentArenaIndex{};
+	};
+
+}
\ No newline at end of file
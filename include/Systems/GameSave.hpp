@@ -0,0 +1,50 @@
+#pragma once
+
+
+
+
+
+#include <vector>
+#include <string>
+#include <cinttypes>
+#include <cstddef>
+
+
+namespace Asteroid
+{
+
+	class Entity;
+	class CallbacksTimer;
+	class EntitySpawnerFromPools;
+
+	//Everything outside of the entities that a save brings back.
+	struct GameSaveLevelState final
+	{
+		uint32_t m_level{};
+		float m_time{};
+		uint32_t m_totalNumAsteroidsHitByBullets{};
+	};
+
+
+	namespace GameSave
+	{
+		//Writes the state of the level into l_save in exactly the form it is stored on disk.
+		//Fails if a pending callback cannot be described, which only happens outside of a level.
+		bool Capture(const std::vector<Entity>& l_entities, const CallbacksTimer& l_callbacksTimer, const EntitySpawnerFromPools& l_spawner
+			, const GameSaveLevelState& l_levelState, std::vector<uint8_t>& l_save);
+
+
+		//The header, the sizes of all sections, the id and type of every saved entity and the indices
+		//of the pools are checked before anything is touched, so nothing changes if it fails.
+		bool Apply(const uint8_t* l_save, const size_t l_sizeInBytes, std::vector<Entity>& l_entities, CallbacksTimer& l_callbacksTimer
+			, EntitySpawnerFromPools& l_spawner, GameSaveLevelState& l_levelState);
+
+
+		bool WriteToFile(const std::string& l_filePath, const std::vector<uint8_t>& l_save);
+
+		//Maps the file and applies it straight from the mapping without copying it first.
+		bool LoadFromFile(const std::string& l_filePath, std::vector<Entity>& l_entities, CallbacksTimer& l_callbacksTimer
+			, EntitySpawnerFromPools& l_spawner, GameSaveLevelState& l_levelState);
+	}
+
+}
\ No newline at end of file
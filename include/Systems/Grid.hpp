@@ -15,7 +15,9 @@ namespace Asteroid
 	class Entity;
 	class CallbacksTimer;
 	class EventManager;
-	class MemoryAlloc;
+	class FrameArena;
+	class JobSystem;
+	class ArchetypeTables;
 
 	class Grid final
 	{
@@ -26,9 +28,10 @@ namespace Asteroid
 
 		void Init(const glm::ivec2& l_fullSizedWindowSize);
 
-		void Update(const glm::ivec2& l_currentWindowSize, const std::vector<Circle>& l_circleBounds, const std::vector<Entity>& l_entities);
+		//Cells are filled in parallel on l_jobSystem, each job owns the bits of the cells it was given.
+		void Update(const glm::ivec2& l_currentWindowSize, const std::vector<Circle>& l_circleBounds, const std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, JobSystem& l_jobSystem);
 
-		void DoCollisionDetection(const std::vector<Circle>& l_circleBounds, std::vector<Entity>& l_entities, CallbacksTimer& l_timer, EventManager& l_eventManager, MemoryAlloc& l_memAlloc);
+		void DoCollisionDetection(const std::vector<Circle>& l_circleBounds, std::vector<Entity>& l_entities, CallbacksTimer& l_timer, EventManager& l_eventManager, FrameArena& l_frameArena);
 
 
 		uint32_t GetTotalNumNonEmptyCells() const;
@@ -50,6 +53,9 @@ namespace Asteroid
 		static constexpr uint32_t m_cellWidth{128U};
 		static constexpr uint32_t m_cellHeight{ 128U };
 
+		//Cells per job when the cells are filled. Each one tests every circle, so a few make a job worth starting.
+		static constexpr uint32_t m_totalNumCellsPerJob{ 8U };
+
 		//This indicates that each cell can have at most 4x32 objects in it at any time
 		static constexpr uint32_t m_totalNumUint32PerCell{4U};
 	};
@@ -0,0 +1,69 @@
+#pragma once
+
+
+
+
+
+#include <cinttypes>
+
+
+namespace Asteroid
+{
+
+	/*
+	* 32 bit reference to a T living in a slot that gets reused, such as a pool block or an entity. 
+	* The low bits are the index of the slot and the high bits the generation the slot was in when 
+	* the handle was made. Every time the slot is given to a new object its generation changes, so 
+	* resolving a handle to an object that is gone fails instead of returning whatever lives there now.
+	* 
+	* Generations wrap around after m_generationMask + 1 reuses of the same slot.
+	*/
+	template<typename T>
+	class Handle final
+	{
+	public:
+
+		static constexpr uint32_t m_totalNumIndexBits{ 22U };
+		static constexpr uint32_t m_indexMask{ (1U << m_totalNumIndexBits) - 1U };
+		static constexpr uint32_t m_generationMask{ UINT32_MAX >> m_totalNumIndexBits };
+
+		//The all ones index is never handed out, so a null handle resolves to nothing.
+		static constexpr uint32_t m_maxNumIndices{ m_indexMask };
+
+		constexpr Handle() = default;
+
+		constexpr Handle(const uint32_t l_index, const uint32_t l_generation)
+			: m_value(((l_generation & m_generationMask) << m_totalNumIndexBits) | (l_index & m_indexMask))
+		{
+
+		}
+
+		constexpr uint32_t GetIndex() const
+		{
+			return m_value & m_indexMask;
+		}
+
+		constexpr uint32_t GetGeneration() const
+		{
+			return m_value >> m_totalNumIndexBits;
+		}
+
+		//l_generation is the full counter of the slot, only its low bits are kept in the handle.
+		constexpr bool IsOfGeneration(const uint32_t l_generation) const
+		{
+			return (l_generation & m_generationMask) == GetGeneration();
+		}
+
+		constexpr bool IsNull() const
+		{
+			return m_indexMask == GetIndex();
+		}
+
+		constexpr bool operator==(const Handle&) const = default;
+
+	private:
+
+		uint32_t m_value{ UINT32_MAX };
+	};
+
+}
\ No newline at end of file
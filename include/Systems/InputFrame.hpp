@@ -0,0 +1,40 @@
+#pragma once
+
+
+
+
+#include <glm.hpp>
+#include <cinttypes>
+
+
+
+namespace Asteroid
+{
+
+	//Everything a single frame of the simulation consumes from the outside world. Replaying the
+	//same sequence of these from the same starting state reproduces the same frames.
+	struct InputFrame final
+	{
+		//Bit i refers to InputSystem::Keys i and bit j of the mouse masks to InputSystem::Mouse j.
+		uint16_t m_keysDown{};
+		uint16_t m_keysUp{};
+		uint16_t m_keysPressedThisFrame{};
+		uint8_t m_mouseButtonsPressed{};
+		uint8_t m_mouseButtonsUp{};
+		uint8_t m_totalNumLeftMouseClicks{};
+		uint8_t m_totalNumRightMouseClicks{};
+		bool m_isMouseHidden{};
+
+		//Spawning is skipped on the frame right after a rewind.
+		bool m_timeRewinded{};
+
+		glm::vec2 m_mousePos{};
+		glm::ivec2 m_windowSize{};
+
+		//Seconds since the start of the level when the frame began and the milliseconds it simulated.
+		float m_time{};
+		float m_deltaTime{};
+	};
+
+
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 
 
+#include "Systems/InputFrame.hpp"
 #include <glm.hpp>
 #include <array>
 #include <SDL3/SDL_events.h>
@@ -26,6 +27,8 @@ namespace Asteroid
 			KEY_C = 5,
 			KEY_F = 6,
 			KEY_T = 7,
+			KEY_F5 = 8,
+			KEY_F9 = 9,
 
 
 			//Maximum number of possible keys. 
@@ -76,6 +79,12 @@ namespace Asteroid
 		void SetMousePos(const glm::vec2& l_mousePos);
 		void SetHiddenStateOfMouse(const bool l_isHidden);
 
+		//Only the input part of l_inputFrame is touched. 
+		void GetInputFrame(InputFrame& l_inputFrame) const;
+
+		//Overrides the state registered from the events with a recorded one.
+		void SetInputFrame(const InputFrame& l_inputFrame);
+
 	private:
 
 		void RegisterKeyboardInputs(const SDL_Event& l_event);
@@ -87,6 +96,9 @@ namespace Asteroid
 
 	private:
 		static constexpr uint32_t m_totalNumInputKeysToProcess{ (uint32_t)Keys::KEY_MAXIMUM };
+
+		//Keys that are actually registered, which is all an InputFrame has to store.
+		static constexpr uint32_t m_totalNumRecordedKeys{ (uint32_t)Keys::KEY_F9 + 1U };
 		
 		std::array<KeyStates, m_totalNumInputKeysToProcess> m_keyStates{};
 		std::array<bool, m_totalNumInputKeysToProcess> m_notAllowedRepetitionKeys{};
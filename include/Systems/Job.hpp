@@ -0,0 +1,39 @@
+#pragma once
+
+
+
+#include <atomic>
+#include <cinttypes>
+
+
+namespace Asteroid
+{
+
+	//Runs the indices [l_begin, l_end) of whatever l_data describes.
+	using JobFunction = void(*)(void* l_data, const uint32_t l_begin, const uint32_t l_end);
+
+
+	//Counts the jobs started against it that have not finished yet. Several batches 
+	//can share one counter, and it can be reused once it is done.
+	class JobCounter final
+	{
+	public:
+
+		bool IsDone() const;
+
+	private:
+		friend class JobSystem;
+
+		std::atomic<uint32_t> m_totalNumPendingJobs{};
+	};
+
+
+	struct Job final
+	{
+		JobFunction m_function{};
+		void* m_data{};
+		uint32_t m_begin{};
+		uint32_t m_end{};
+		JobCounter* m_counter{};
+	};
+}
\ No newline at end of file
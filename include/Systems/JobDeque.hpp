@@ -0,0 +1,59 @@
+#pragma once
+
+
+
+#include "Systems/Job.hpp"
+#include <atomic>
+#include <array>
+#include <cinttypes>
+
+
+namespace Asteroid
+{
+
+	/*
+	* Chase-Lev work stealing deque of a fixed capacity. The thread that owns it pushes and pops 
+	* at the bottom without taking a lock, while any other thread may steal from the top.
+	* Jobs are stored by value, so nothing has to outlive the deque.
+	*/
+	class JobDeque final
+	{
+	public:
+
+		static constexpr uint32_t m_capacity{ 4096U };
+
+		//Owner thread only. Returns false if the deque is full.
+		bool Push(const Job& l_job);
+
+		//Owner thread only. Returns false if the deque is empty.
+		bool Pop(Job& l_job);
+
+		//Any thread. Returns false if the deque is empty or another thread took the job first.
+		bool Steal(Job& l_job);
+
+	private:
+
+		static_assert(0U == (m_capacity & (m_capacity - 1U)), "The capacity of the deque has to be a power of two.");
+
+		static constexpr int64_t m_mask{ (int64_t)m_capacity - 1 };
+
+		//A thief reads a slot before it knows the job is its own, while the owner may already be 
+		//writing the slot again. Relaxed atomics make that read well defined and cost nothing on x86.
+		struct JobSlot final
+		{
+			std::atomic<JobFunction> m_function{};
+			std::atomic<void*> m_data{};
+			std::atomic<uint32_t> m_begin{};
+			std::atomic<uint32_t> m_end{};
+			std::atomic<JobCounter*> m_counter{};
+		};
+
+		static void Write(JobSlot& l_slot, const Job& l_job);
+		static Job Read(const JobSlot& l_slot);
+
+		//Kept on different cache lines since thieves hammer the top while the owner works the bottom.
+		alignas(64) std::atomic<int64_t> m_top{};
+		alignas(64) std::atomic<int64_t> m_bottom{};
+		alignas(64) std::array<JobSlot, m_capacity> m_jobs{};
+	};
+}
\ No newline at end of file
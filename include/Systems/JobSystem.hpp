@@ -0,0 +1,118 @@
+#pragma once
+
+
+
+#include "Systems/Job.hpp"
+#include "Systems/JobDeque.hpp"
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cinttypes>
+
+
+namespace Asteroid
+{
+
+	struct JobWorkerStats final
+	{
+		uint64_t m_busyTimeInNanoseconds{};
+		uint64_t m_totalNumJobsExecuted{};
+		uint64_t m_totalNumJobsStolen{};
+	};
+
+
+	/*
+	* Work stealing job system. Every thread has its own deque it pushes to and pops from, and a
+	* thread that runs out of jobs steals from the others. Waiting on a counter runs other jobs 
+	* in the meantime, so a job can start more jobs and wait on them without deadlocking.
+	* Thread 0 is the thread that called Init(), the workers are 1 to GetTotalNumThreads() - 1.
+	* Only these threads may start jobs or wait on them.
+	*/
+	class JobSystem final
+	{
+	public:
+
+		JobSystem() = default;
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		~JobSystem();
+
+		//With zero workers every job runs on the thread that waits on it. Pinning only has an effect on Linux.
+		void Init(const uint32_t l_totalNumWorkers, const bool l_pinWorkersToCores);
+
+		void Run(const JobFunction l_function, void* l_data, const uint32_t l_begin, const uint32_t l_end, JobCounter& l_counter);
+
+		//Splits [0, l_count) into jobs of at most l_grainSize indices each.
+		void ParallelFor(const uint32_t l_count, const uint32_t l_grainSize, const JobFunction l_function, void* l_data, JobCounter& l_counter);
+
+		//l_functor is called as l_functor(l_begin, l_end) and has to outlive the wait on l_counter.
+		template<typename F>
+		void ParallelFor(const uint32_t l_count, const uint32_t l_grainSize, F& l_functor, JobCounter& l_counter)
+		{
+			ParallelFor(l_count, l_grainSize
+				, [](void* l_data, const uint32_t l_begin, const uint32_t l_end) -> void
+				{
+					(*static_cast<F*>(l_data))(l_begin, l_end);
+				}
+			, &l_functor, l_counter);
+		}
+
+		//Runs jobs until every job started against l_counter is done.
+		void Wait(const JobCounter& l_counter);
+
+		uint32_t GetTotalNumThreads() const;
+
+		//True if no job is queued or running. Code that reaches into state the workers use 
+		//without locks, like the thread caches of a MemoryAlloc, asserts this first.
+		bool IsIdle() const;
+
+		JobWorkerStats GetStats(const uint32_t l_threadIndex) const;
+
+	private:
+
+		struct alignas(64) ThreadData final
+		{
+			JobDeque m_deque{};
+
+			std::atomic<uint64_t> m_busyTimeInNanoseconds{};
+			std::atomic<uint64_t> m_totalNumJobsExecuted{};
+			std::atomic<uint64_t> m_totalNumJobsStolen{};
+		};
+
+		//Pushes to the deque of the calling thread, or runs the job right away if it is full.
+		void Push(const Job& l_job);
+
+		void WakeWorkers(const uint32_t l_totalNumNewJobs);
+
+		//Pops from the deque of l_threadIndex or steals from another one. Returns false if there was nothing to run.
+		bool TryExecuteJob(const uint32_t l_threadIndex);
+
+		void Execute(const Job& l_job, const uint32_t l_threadIndex, const bool l_stolen);
+
+		void WorkerLoop(const uint32_t l_threadIndex);
+
+		static uint32_t GetCurrentThreadIndex();
+
+	private:
+
+		std::unique_ptr<ThreadData[]> m_threadData{};
+		uint32_t m_totalNumThreads{};
+
+		//Lets idle workers sleep instead of spinning.
+		std::atomic<uint32_t> m_totalNumQueuedJobs{};
+		std::atomic<uint32_t> m_totalNumSleepingWorkers{};
+
+		//Counted from Push() until the job has run, before its counter is released.
+		std::atomic<uint32_t> m_totalNumJobsInFlight{};
+		std::atomic<bool> m_stopWorkers{};
+		std::mutex m_sleepMutex;
+		std::condition_variable m_wakeCondition;
+
+		std::vector<std::thread> m_workers{};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+
+
+
+
+#include "Systems/JobSystem.hpp"
+#include <vector>
+#include <cinttypes>
+
+
+namespace Asteroid
+{
+
+	/*
+	* Shows in an ImGui window how busy every thread of the JobSystem was over the last second,
+	* together with how many jobs it ran and how many of those it stole from other threads.
+	*/
+	class JobSystemStatsPanel final
+	{
+	public:
+
+		void Init(const JobSystem& l_jobSystem);
+
+		//Samples the counters once a second to work out the rates.
+		void Update(const float l_timeInSeconds);
+
+		void Render() const;
+
+	private:
+
+		struct TrackedThread
+		{
+			JobWorkerStats m_stats{};
+			float m_utilization{};
+			float m_jobsPerSecond{};
+			float m_stealsPerSecond{};
+		};
+
+	private:
+
+		static constexpr float m_sampleIntervalInSeconds{ 1.f };
+
+		const JobSystem* m_jobSystem{};
+		std::vector<TrackedThread> m_threads{};
+
+		float m_lastSampleTime{};
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+
+
+
+
+#include <cinttypes>
+#include <cstddef>
+#include <string>
+
+
+namespace Asteroid
+{
+
+	//A file of fixed size mapped into the address space for reading and writing.
+	//The OS pages it in and out on demand, so it does not count towards resident memory
+	//the way a heap allocation of the same size would.
+	class MappedFile final
+	{
+	public:
+
+		MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		//Creates the file (or truncates an existing one) to l_sizeInBytes and maps it.
+		bool Open(const std::string& l_filePath, const size_t l_sizeInBytes);
+
+		//Same as Open() but the file must not exist yet, and it is deleted as soon as it is closed,
+		//even if the process dies. Used for scratch data that is only needed while mapped.
+		bool OpenTemporary(const std::string& l_filePath, const size_t l_sizeInBytes);
+
+		//Maps the whole of an existing file read only. The mapped data must not be written to.
+		bool OpenForReading(const std::string& l_filePath);
+
+		void Close();
+
+		bool IsOpen() const;
+
+		uint8_t* GetData() const;
+
+		size_t GetSizeInBytes() const;
+
+		~MappedFile();
+
+	private:
+
+		bool OpenForWriting(const std::string& l_filePath, const size_t l_sizeInBytes, const bool l_isTemporary);
+
+	private:
+
+#ifdef _WIN32
+		void* m_fileHandle{};
+		void* m_mappingHandle{};
+#else
+		int m_fileDescriptor{ -1 };
+#endif
+
+		uint8_t* m_data{};
+		size_t m_sizeInBytes{};
+	};
+
+}
\ No newline at end of file
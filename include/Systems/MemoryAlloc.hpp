@@ -5,45 +5,239 @@
 
 
 #include "Systems/MemoryPool.hpp"
+#include "Systems/Handle.hpp"
 #include "Systems/LogSystem.hpp"
+#include <array>
+#include <cassert>
+#include <new>
+#include <utility>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
 
 
 namespace Asteroid
 {
 
 
+	/*
+	* All pools live in one reserved range of address space, pool i in the i-th sub range of 
+	* m_poolRegionSizeInBytes bytes. The pool owning a block follows from shifting its offset 
+	* in the range, so freeing a block needs neither its size nor its type.
+	* 
+	* Any thread can create and destroy objects. Each thread allocates from its own magazines, 
+	* one per pool, and only locks a pool to move m_magazineBatchSize blocks between the pool 
+	* and a magazine at once.
+	* 
+	* Everything touching the pools as a whole (snapshots, ReleaseEmptySlabs(), GetPool()) 
+	* must only run while no other thread is using the allocator.
+	*/
 	class MemoryAlloc final
 	{
 
 	public:
 
+		static constexpr uint32_t m_totalNumPools{ 6U };
+		static constexpr uint32_t m_magazineCapacity{ 32U };
+		static constexpr uint32_t m_magazineBatchSize{ m_magazineCapacity / 2U };
+
+		//Pool i holds blocks of (i + 1) * m_sizeClassInBytes bytes. Slabs are page aligned, so every block
+		//is aligned to the biggest power of two its size is a multiple of, e.g. 64 bytes in the 64 byte pool.
+		static constexpr size_t m_sizeClassInBytes{ 16U };
+
+		//Address space only. Slabs are committed in it as the pools grow.
+		static constexpr uint32_t m_poolRegionShift{ 26U };
+		static constexpr size_t m_poolRegionSizeInBytes{ size_t{ 1U } << m_poolRegionShift };
+
 		MemoryAlloc();
+		~MemoryAlloc();
+
+		MemoryAlloc(const MemoryAlloc&) = delete;
+		MemoryAlloc& operator=(const MemoryAlloc&) = delete;
+
+
+		//Slabs the pools chained while under pressure are kept until this is called. Flushes the
+		//thread caches first, so it has the same precondition as FlushThreadCaches().
+		void ReleaseEmptySlabs();
+
+		//Keeps the slabs the pools have now resident. Returns false if any of them could not be locked.
+		bool LockPoolMemory();
+
+		//Gives the blocks cached by every thread back to the pools. The caches are used without locks
+		//by the threads owning them, so no other thread may allocate from or free into this allocator 
+		//while it runs. In the engine that means between frames, with the JobSystem idle.
+		void FlushThreadCaches();
+
+		//m_totalNumPools if the block is not in the region of this allocator.
+		uint32_t GetPoolIndexOfBlock(const void* l_block) const;
+		bool OwnsBlock(const void* l_block) const;
+
+
+		//The pool is picked at compile time from the size and alignment of T. Types asking for 
+		//cache line alignment with alignas(64) end up in the 64 byte pool.
+		template<typename T>
+		static constexpr uint32_t GetPoolIndexOf()
+		{
+			static_assert(sizeof(T) <= m_totalNumPools * m_sizeClassInBytes, "Type is too big to fit in any of the blocks of the pools.");
+			static_assert(m_totalNumPools != GetPoolIndexOfSize(sizeof(T), alignof(T)), "None of the pools has blocks aligned enough for this type.");
+
+			return GetPoolIndexOfSize(sizeof(T), alignof(T));
+		}
+
+		//Smallest pool whose blocks are big and aligned enough, or m_totalNumPools if there is none.
+		static constexpr uint32_t GetPoolIndexOfSize(const size_t l_sizeInBytes, const size_t l_alignment)
+		{
+			for (uint32_t i = 0; i < m_totalNumPools; ++i) {
+
+				const size_t lv_blockSizeInBytes = (i + 1U) * m_sizeClassInBytes;
 
+				if (0U != l_sizeInBytes && l_sizeInBytes <= lv_blockSizeInBytes && 0U == lv_blockSizeInBytes % l_alignment) {
+					return i;
+				}
+			}
 
-		void* Allocate(const size_t l_blockSize);
+			return m_totalNumPools;
+		}
 
 
+		template<typename T, typename... Args>
+		T* Create(Args&&... l_args)
+		{
+			void* lv_block = AllocateBlock(GetPoolIndexOf<T>(), sizeof(T));
+
+			return new(lv_block) T(std::forward<Args>(l_args)...);
+		}
 
+
+		//l_object must be destroyed as the exact type it was created as, never through a base class.
 		template<typename T>
-		bool Destruct(T* l_block, const size_t l_sizeOfBlock)
+		bool Destroy(T* l_object)
 		{
-			if (nullptr == l_block) {
-				LOG(Severity::WARNING, Channel::MEMORY, "Tried to destruct a nullptr.");
+			using namespace LogSystem;
+
+			if (nullptr == l_object) {
+				LOG(Severity::WARNING, Channel::MEMORY, "Tried to destroy a nullptr.");
+				return false;
+			}
+
+			const uint32_t lv_poolIndex = GetPoolIndexOfBlock(l_object);
+
+			if (m_totalNumPools == lv_poolIndex) {
+				LOG(Severity::WARNING, Channel::MEMORY, "Tried to destroy an object that was not created by this allocator.");
 				return false;
 			}
 
-			l_block->~T();
-			
-			return Deallocate(l_block, l_sizeOfBlock);
+			assert(GetPoolIndexOf<T>() == lv_poolIndex);
+
+			l_object->~T();
+
+			DeallocateBlock(lv_poolIndex, l_object, sizeof(T));
+
+			return true;
+		}
+
+
+		//The handle stays valid for as long as l_object is not destroyed.
+		template<typename T>
+		Handle<T> GetHandle(const T* l_object) const
+		{
+			const MemoryPool& lv_pool = *m_pools[GetPoolIndexOf<T>()];
+
+			uint32_t lv_blockIndex{};
+			const bool lv_ownsBlock = lv_pool.FindBlockHandle(l_object, lv_blockIndex);
+			assert(true == lv_ownsBlock && lv_blockIndex < Handle<T>::m_maxNumIndices);
+
+			return (true == lv_ownsBlock) ? Handle<T>{ lv_blockIndex, lv_pool.GetBlockGeneration(lv_blockIndex) } : Handle<T>{};
+		}
+
+		//nullptr if the object l_handle was made for has been destroyed since.
+		template<typename T>
+		T* Resolve(const Handle<T> l_handle)
+		{
+			MemoryPool& lv_pool = *m_pools[GetPoolIndexOf<T>()];
+
+			if (l_handle.GetIndex() >= lv_pool.GetMaxNumBlocks()) {
+				return nullptr;
+			}
+
+			unsigned char* lv_block = lv_pool.GetBlock(l_handle.GetIndex());
+
+			if (nullptr == lv_block || false == l_handle.IsOfGeneration(lv_pool.GetBlockGeneration(l_handle.GetIndex()))) {
+				return nullptr;
+			}
+
+			return std::launder(reinterpret_cast<T*>(lv_block));
+		}
+
+
+		//Gives back a block that holds no object any more. The stats count the whole block as freed, 
+		//so only Destroy() and the pmr containers keep the wasted bytes exact.
+		bool Free(void* l_block);
+
+
+
+		//Write API for anything living in the pools. Every write made through the returned 
+		//pointer is picked up by the next snapshot of the pools.
+		template<typename T>
+		T* Write(T* l_block)
+		{
+			MarkDirty(l_block);
+			return l_block;
 		}
 
+		void MarkDirty(const void* l_block);
+		void MarkAllDirty();
+
+		MemoryPool& GetPool(const uint32_t l_poolIndex);
+
+		//Safe to call while other threads allocate, though their latest counts may be missing.
+		SizeClassStats GetStats(const uint32_t l_poolIndex);
+
 	private:
 
-		bool Deallocate(void* l_block, const size_t l_sizeOfBlock);
+		//Hands out blocks by size for the pmr containers.
+		friend class PoolMemoryResource;
+
+		struct Magazine
+		{
+			std::array<void*, m_magazineCapacity> m_blocks{};
+			uint32_t m_totalNumBlocks{};
+
+			//Blocks freed into or handed out again straight from the magazine. Their dirty marks 
+			//are set in the pool the next time it is locked anyway, which is before any snapshot.
+			std::array<void*, m_magazineCapacity> m_blocksToMarkDirty{};
+			uint32_t m_totalNumBlocksToMarkDirty{};
 
+			//Only written by the thread owning the magazine, so they are never contended.
+			std::atomic<uint64_t> m_totalNumAllocations{};
+			std::atomic<uint64_t> m_totalNumFrees{};
+			std::atomic<uint64_t> m_totalNumBytesAllocated{};
+			std::atomic<uint64_t> m_totalNumBytesFreed{};
+		};
+
+		struct ThreadCache
+		{
+			std::thread::id m_threadID{};
+			std::array<Magazine, m_totalNumPools> m_magazines{};
+		};
+
+		ThreadCache& GetThreadCache();
+
+		//l_sizeInBytes is what the caller asked for and only feeds the stats.
+		void* AllocateBlock(const uint32_t l_poolIndex, const size_t l_sizeInBytes);
+		void DeallocateBlock(const uint32_t l_poolIndex, void* l_block, const size_t l_sizeInBytes);
+
+		//The pool of l_poolIndex has to be locked by the caller for these.
+		void MarkPendingBlocksDirty(const uint32_t l_poolIndex, Magazine& l_magazine);
+		void ReturnBlocksToPool(const uint32_t l_poolIndex, Magazine& l_magazine, const uint32_t l_totalNumBlocks);
 
 	private:
 
+		//Declared before the pools since they are committed in it.
+		unsigned char* m_region;
+
 		MemoryPool m_pool16;
 		MemoryPool m_pool32;
 		MemoryPool m_pool48;
@@ -51,6 +245,15 @@ namespace Asteroid
 		MemoryPool m_pool80;
 		MemoryPool m_pool96;
 
+		std::array<MemoryPool*, m_totalNumPools> m_pools{};
+		std::array<std::mutex, m_totalNumPools> m_poolMutexes{};
+
+		//Tells the caches of this allocator apart from the ones of allocators destroyed before.
+		uint32_t m_instanceID;
+
+		std::vector<std::unique_ptr<ThreadCache>> m_threadCaches{};
+		std::mutex m_threadCachesMutex{};
+
 	};
 
 }
\ No newline at end of file
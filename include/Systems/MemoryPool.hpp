@@ -5,7 +5,11 @@
 
 
 
+#include "Systems/MemoryPoolState.hpp"
+#include "Systems/MemoryPoolStats.hpp"
 #include <cinttypes>
+#include <cstddef>
+#include <vector>
 
 namespace Asteroid
 {
@@ -18,22 +22,33 @@ namespace Asteroid
 		//Block size is assumed to always be multiple of 16.
 
 		/* 
-		* Bytes requested will be rounded to the nearest multiple of 
-		* l_blockSizes bigger than or equal to the requested bytes.
+		* The pool is a chain of slabs of equal size. Bytes requested are the size of each slab 
+		* and will be rounded up to whole pages, which are then filled with as many blocks as fit.
+		* Slabs are committed back to back in l_region, address space reserved by the owner of the 
+		* pool that has to stay reserved for as long as the pool lives. It is page aligned, so a 
+		* block is aligned to the biggest power of two its size is a multiple of, up to a page.
+		* Every slab ends in the generations of its blocks.
+		* The first slab is committed here and another one is chained whenever the pool runs out 
+		* of free blocks, until the region is full.
 		*/
-		MemoryPool(const size_t l_minBytesToAllocate, const size_t l_blockSizes);
+		MemoryPool(unsigned char* l_region, const size_t l_regionSizeInBytes, const size_t l_minBytesToAllocate, const size_t l_blockSizes);
 		
 
 		/*
-		* The returned void* is going to be cast to the type by the user and modified 
-		* through the course of the program. That naturally violates strict aliasing rule
-		* that compiler assumes us to respect when doing optimizations. 
-		* One way to respect this rule and still do type punning is to use memcpy().
-		* But due to how much refactoring that required, we wont respect that rule 
-		* and just build the project without optimization flags turned on.
+		* The returned block is raw storage. Objects are started in it with placement new 
+		* (see MemoryAlloc::Create()) and only accessed through the pointers that returns. 
+		* The pool itself only touches the block through memcpy() while it is free, so
+		* no type punning happens and the project can be built with optimizations.
 		*/
 		void* Allocate();
 
+		//Decommits the slabs, except for the first one, that have no allocated block.
+		//Returns the number of slabs released.
+		uint32_t ReleaseEmptySlabs();
+
+		//Keeps the slabs there are now resident. Returns false if any of them could not be locked.
+		bool LockSlabs();
+
 
 		MemoryPool(const MemoryPool&) = delete;
 		MemoryPool& operator=(const MemoryPool&) = delete;
@@ -42,21 +57,100 @@ namespace Asteroid
 		bool Deallocate(void* l_block);
 
 
+		/*
+		* Dirty block tracking. Every block remembers the write generation it was last written in, 
+		* and a block is dirty if that is the current generation. Allocate() and Deallocate() mark 
+		* the blocks they touch. Writes made through the returned pointers have to be reported 
+		* with MarkBlockDirty() since the pool cannot see them.
+		*/
+		void MarkBlockDirty(const void* l_block);
+		void MarkAllBlocksDirty();
+		bool IsBlockDirty(const uint32_t l_blockIndex) const;
+
+		//Every block becomes clean.
+		void StartNewWriteGeneration();
+
+		//Constant time, since the slab a block is in follows from its offset in the region.
+		bool OwnsBlock(const void* l_block) const;
+
+		//Returns false if the block is not in any of the slabs.
+		bool FindBlockHandle(const void* l_block, uint32_t& l_blockHandle) const;
+
+
+		/*
+		* Every block has a generation, which the owner of the pool bumps whenever it is given back 
+		* so handles to the object that lived in it stop resolving (see Handle). They only touch the 
+		* counter of that one block, so any thread holding the block may call them.
+		*/
+		void IncrementBlockGeneration(const void* l_block);
+		uint32_t GetBlockGeneration(const uint32_t l_blockIndex) const;
+		void SetBlockGeneration(const uint32_t l_blockIndex, const uint32_t l_generation);
+
+		//No block index is ever this big. Unlike GetTotalNumBlocks() this never changes.
+		uint32_t GetMaxNumBlocks() const;
+
+		//Includes the blocks of released slabs, whose indices stay reserved. GetBlock() returns nullptr for them.
+		uint32_t GetTotalNumBlocks() const;
+		size_t GetBlockSizeInBytes() const;
+
+		unsigned char* GetBlock(const uint32_t l_blockIndex);
+		const unsigned char* GetBlock(const uint32_t l_blockIndex) const;
+
+		//Changes every time a slab is chained or released, since block indices and 
+		//free list states from before then no longer describe the pool.
+		uint32_t GetSlabLayoutVersion() const;
+
+		MemoryPoolState GetState() const;
+		void SetState(const MemoryPoolState& l_state);
+
+		MemoryPoolStats GetStats() const;
+
 
-		~MemoryPool();
+
+	private:
+
+		void AddSlab();
+
+		unsigned char* GetGenerationOfBlock(const uint32_t l_blockHandle) const;
+
+		void WriteFreeBlock(const uint32_t l_blockHandle, const uint32_t l_nextBlockHandle);
+		uint32_t ReadNextFreeBlockHandle(const uint32_t l_blockHandle) const;
 
 	private:
 
 		static constexpr uint32_t m_gaurdDebugValue{ 0x12345678 };
+		static constexpr uint32_t m_endOfFreeList{ UINT32_MAX };
 
 		size_t m_blockSizeInBytes;
 
-		unsigned char* m_array{ nullptr };
-		size_t m_totalBytesAllocatedForPool{ 0U };
+		//Slab i starts at m_region + i * m_slabSizeInBytes. Everything committed in the region 
+		//is given back when its owner releases it.
+		unsigned char* m_region;
+		size_t m_regionSizeInBytes;
+
+		//Block handle h lives in slab h / m_totalNumBlocksPerSlab. Slabs not committed are nullptr.
+		//Only the first m_totalNumSlabSlots can be committed.
+		std::vector<unsigned char*> m_slabs{};
+		uint32_t m_totalNumSlabSlots{ 0U };
 
-		uint32_t m_headHandleOfFreeList{0U};
+		//The whole committed range, which may end in a few bytes too small for another block.
+		size_t m_slabSizeInBytes{ 0U };
+		uint32_t m_totalNumBlocksPerSlab{ 0U };
+		uint32_t m_maxNumSlabs{ 0U };
+		uint32_t m_slabLayoutVersion{ 0U };
+
+		uint32_t m_headHandleOfFreeList{ m_endOfFreeList };
 		uint32_t m_totalNumFreeList{0U};
 
+		//Blocks of the slabs that are not released.
+		uint32_t m_totalNumLiveBlocks{ 0U };
+		uint32_t m_highWaterMarkBlocksInUse{ 0U };
+		uint64_t m_totalNumExhaustedAllocations{ 0U };
+
+		//Blocks start out in the first generation so all of them are dirty until the first snapshot.
+		std::vector<uint32_t> m_blockWriteGenerations{};
+		uint32_t m_currentWriteGeneration{ 1U };
+
 
 	};
 
@@ -0,0 +1,22 @@
+#pragma once
+
+
+
+
+#include <cinttypes>
+
+
+
+namespace Asteroid
+{
+
+	//Free list bookkeeping of a MemoryPool. Together with the contents of its blocks this is 
+	//everything needed to put a pool back into an earlier state.
+	struct MemoryPoolState final
+	{
+		uint32_t m_headHandleOfFreeList{};
+		uint32_t m_totalNumFreeList{};
+	};
+
+
+}
\ No newline at end of file
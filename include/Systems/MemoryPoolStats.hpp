@@ -0,0 +1,41 @@
+#pragma once
+
+
+
+
+#include <cinttypes>
+#include <cstddef>
+
+
+
+namespace Asteroid
+{
+
+	//What a MemoryPool knows about its own use. Blocks cached in the magazines of MemoryAlloc count as in use.
+	struct MemoryPoolStats final
+	{
+		size_t m_blockSizeInBytes{};
+		uint32_t m_totalNumSlabs{};
+		uint32_t m_totalNumBlocks{};
+		uint32_t m_totalNumBlocksInUse{};
+		uint32_t m_highWaterMarkBlocksInUse{};
+
+		//Allocations that found no free block, which would have failed before the pool could chain slabs.
+		uint64_t m_totalNumExhaustedAllocations{};
+	};
+
+
+	//One size class of a MemoryAlloc, as seen by the objects created in it.
+	struct SizeClassStats final
+	{
+		MemoryPoolStats m_pool{};
+
+		uint64_t m_totalNumAllocations{};
+		uint64_t m_totalNumFrees{};
+
+		//Bytes of the blocks of live objects that lie past the end of the objects.
+		uint64_t m_totalNumWastedBytes{};
+	};
+
+
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+
+
+
+
+#include "Systems/MemoryAlloc.hpp"
+#include "Systems/MemoryPoolState.hpp"
+#include "Systems/TimeRewind/FrameRecordLog.hpp"
+#include <array>
+#include <vector>
+#include <cinttypes>
+#include <cstddef>
+
+
+namespace Asteroid
+{
+
+	/*
+	* Type agnostic snapshots of everything living in the pools of a MemoryAlloc, which is where 
+	* all the components are. The generation of a block is saved with its contents, so handles 
+	* resolve again to whatever lived in the block at the time of the restored snapshot. A mirror 
+	* of the pools holds the newest snapshot. Taking a snapshot only copies the blocks that are 
+	* dirty since the previous one into the mirror, and the old contents of those blocks are kept 
+	* as an undo record so older snapshots can be restored too.
+	* 
+	* The mirror and the undo records share one page aligned arena.
+	*/
+	class MemorySnapshotHistory final
+	{
+	public:
+
+		MemorySnapshotHistory();
+
+		MemorySnapshotHistory(const MemorySnapshotHistory&) = delete;
+		MemorySnapshotHistory& operator=(const MemorySnapshotHistory&) = delete;
+
+		~MemorySnapshotHistory();
+
+		//l_historyBudgetInBytes is what the undo records can use on top of the mirror.
+		void Init(MemoryAlloc& l_allocator, const size_t l_historyBudgetInBytes);
+
+		//Both flush the thread caches of the allocator, so they share the precondition of
+		//MemoryAlloc::FlushThreadCaches(): nothing else may use the allocator meanwhile.
+		void TakeSnapshot();
+
+		//0 is the newest snapshot. Every snapshot newer than the restored one is dropped.
+		//Fails if a pool chained or released a slab since the snapshots were taken.
+		bool RestoreSnapshot(const uint32_t l_totalNumSnapshotsBack);
+
+		uint32_t GetTotalNumSnapshots() const;
+
+		//Bytes copied into the mirror by the last TakeSnapshot().
+		size_t GetLastSnapshotSizeInBytes() const;
+
+		void Clear();
+
+	private:
+
+		//Header of every block stored in an undo record.
+		struct UndoBlock final
+		{
+			uint32_t m_poolIndex{};
+			uint32_t m_blockIndex{};
+			uint32_t m_blockGeneration{};
+		};
+
+		void RestoreNewestSnapshot();
+
+		bool HasSlabLayoutChanged() const;
+
+		void ApplyUndoRecord(const uint8_t* l_record, const size_t l_sizeInBytes);
+
+	private:
+
+		MemoryAlloc* m_allocator{};
+
+		uint8_t* m_arena{};
+		size_t m_arenaSizeInBytes{};
+
+		std::array<uint8_t*, MemoryAlloc::m_totalNumPools> m_mirrors{};
+		std::array<uint16_t*, MemoryAlloc::m_totalNumPools> m_mirrorGenerations{};
+		std::array<MemoryPoolState, MemoryAlloc::m_totalNumPools> m_mirrorStates{};
+
+		//Layout of the pools the mirrors were sized for.
+		std::array<uint32_t, MemoryAlloc::m_totalNumPools> m_slabLayoutVersions{};
+		size_t m_historyBudgetInBytes{};
+
+		//Undo record i turns snapshot i + 1 back into snapshot i.
+		FrameRecordLog m_undoRecords{};
+		std::vector<uint8_t> m_undoRecord{};
+
+		size_t m_lastSnapshotSizeInBytes{};
+		bool m_hasSnapshot{};
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+
+
+
+namespace Asteroid
+{
+	struct ArchetypeTable;
+
+	namespace MovementSystem
+	{
+		//Moves every active and unpaused row of l_archetype along its ray direction. It does what
+		//RayMovementComponent::Update() used to do for each entity, walking only the active rows.
+		void UpdateRayMovement(ArchetypeTable& l_archetype, const float l_deltaTime);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+
+
+
+
+#include <memory_resource>
+#include <cstddef>
+
+
+namespace Asteroid
+{
+
+	class MemoryAlloc;
+
+	/*
+	* Lets the pmr containers allocate from the pools of a MemoryAlloc. Requests no pool has 
+	* blocks big or aligned enough for go to l_upstream.
+	*/
+	class PoolMemoryResource final : public std::pmr::memory_resource
+	{
+	public:
+
+		explicit PoolMemoryResource(MemoryAlloc& l_allocator, std::pmr::memory_resource* l_upstream = std::pmr::new_delete_resource());
+
+		PoolMemoryResource(const PoolMemoryResource&) = delete;
+		PoolMemoryResource& operator=(const PoolMemoryResource&) = delete;
+
+	private:
+
+		void* do_allocate(const size_t l_sizeInBytes, const size_t l_alignment) override;
+		void do_deallocate(void* l_block, const size_t l_sizeInBytes, const size_t l_alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& l_other) const noexcept override;
+
+		bool FitsInPools(const size_t l_sizeInBytes, const size_t l_alignment) const;
+
+	private:
+
+		MemoryAlloc& m_allocator;
+		std::pmr::memory_resource* m_upstream;
+	};
+
+}
\ No newline at end of file
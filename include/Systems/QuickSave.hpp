@@ -0,0 +1,43 @@
+#pragma once
+
+
+
+
+
+#include "Systems/DelayedSetStateCallback.hpp"
+#include "Entities/ArchetypeTable.hpp"
+#include <glm.hpp>
+#include <vector>
+#include <random>
+
+
+namespace Asteroid
+{
+
+	//Everything outside of the allocator pools that a quicksave has to bring back. The 
+	//components themselves are restored by a MemorySnapshotHistory over the pools.
+	struct QuickSave final
+	{
+		//Positions, active states and the rest of the per entity columns.
+		ArchetypeTables m_archetypes{};
+
+		//Entities live outside of the pools, so their generations are kept here for the
+		//handles of the pending callbacks to resolve after a load.
+		std::vector<uint32_t> m_entityGenerations{};
+
+		std::vector<DelayedSetStateCallback> m_pendingCallbacks{};
+
+		std::vector<uint8_t> m_spawnerPools{};
+		std::mt19937 m_randomEngine{};
+
+		glm::vec2 m_mousePos{};
+		bool m_isMouseHidden{};
+
+		float m_time{};
+		uint32_t m_totalNumAsteroidsHitByBullets{};
+		uint32_t m_level{};
+
+		bool m_isValid{};
+	};
+
+}
\ No newline at end of file
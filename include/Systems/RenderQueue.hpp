@@ -0,0 +1,44 @@
+#pragma once
+
+
+
+#include "Systems/RenderingData.hpp"
+#include "Components/ComponentTypes.hpp"
+#include <vector>
+#include <cinttypes>
+
+
+namespace Asteroid
+{
+	namespace RenderSystem
+	{
+		class Renderer;
+
+
+		struct RenderSubmission final
+		{
+			uint32_t m_sortKey{};
+			RenderingData m_renderData{};
+		};
+
+
+		//Collects what the animation components want drawn during the frame so it can be drawn in
+		//one go afterwards. Entities are drawn in the order they were created and the sprites of one
+		//entity in the order of their component slots, no matter which system submitted them first.
+		class RenderQueue final
+		{
+		public:
+
+			//Enough for every slot of every entity, so submitting never allocates.
+			void Reserve(const uint32_t l_totalNumEntities);
+
+			void Submit(const uint32_t l_entityIndex, const ComponentTypes l_componentSlot, const RenderingData& l_renderData);
+
+			//Draws everything submitted since the last flush and empties the queue.
+			bool Flush(Renderer& l_renderer);
+
+		private:
+			std::vector<RenderSubmission> m_submissions{};
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+
+
+
+#include <cinttypes>
+#include <cstddef>
+#include <type_traits>
+
+
+namespace Asteroid
+{
+
+	//Reads back state blocks in the exact order they were written by a SnapshotWriter.
+	class SnapshotReader final
+	{
+	public:
+
+		SnapshotReader(const uint8_t* l_data, const size_t l_sizeInBytes);
+
+
+		template<typename T>
+		void Read(T& l_stateBlock)
+		{
+			static_assert(true == std::is_trivially_copyable_v<T>, "Snapshot state blocks must be trivially copyable.");
+
+			ReadBytes(&l_stateBlock, sizeof(T));
+		}
+
+
+		template<typename T>
+		void ReadArray(T* l_stateBlocks, const uint32_t l_count)
+		{
+			static_assert(true == std::is_trivially_copyable_v<T>, "Snapshot state blocks must be trivially copyable.");
+
+			ReadBytes(l_stateBlocks, sizeof(T) * l_count);
+		}
+
+
+		//Same as Read() but the read position is not advanced.
+		template<typename T>
+		void Peek(T& l_stateBlock) const
+		{
+			static_assert(true == std::is_trivially_copyable_v<T>, "Snapshot state blocks must be trivially copyable.");
+
+			PeekBytes(&l_stateBlock, sizeof(T));
+		}
+
+
+		void ReadBytes(void* l_data, const size_t l_sizeInBytes);
+
+		void PeekBytes(void* l_data, const size_t l_sizeInBytes) const;
+
+		void SkipBytes(const size_t l_sizeInBytes);
+
+		size_t GetTotalNumRemainingBytes() const;
+
+
+		bool IsAtEnd() const;
+
+	private:
+
+		const uint8_t* m_data;
+		size_t m_sizeInBytes;
+		size_t m_currentOffset{};
+	};
+
+}
\ No newline at end of file
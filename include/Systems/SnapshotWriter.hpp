@@ -0,0 +1,52 @@
+#pragma once
+
+
+
+
+#include <vector>
+#include <cinttypes>
+#include <cstddef>
+#include <type_traits>
+
+
+namespace Asteroid
+{
+
+	//Appends fixed size, trivially copyable state blocks to the end of a byte buffer.
+	//The buffer is owned by the caller so it can be reused frame after frame without reallocating.
+	class SnapshotWriter final
+	{
+	public:
+
+		explicit SnapshotWriter(std::vector<uint8_t>& l_buffer);
+
+
+		template<typename T>
+		void Write(const T& l_stateBlock)
+		{
+			static_assert(true == std::is_trivially_copyable_v<T>, "Snapshot state blocks must be trivially copyable.");
+
+			WriteBytes(&l_stateBlock, sizeof(T));
+		}
+
+
+		template<typename T>
+		void WriteArray(const T* l_stateBlocks, const uint32_t l_count)
+		{
+			static_assert(true == std::is_trivially_copyable_v<T>, "Snapshot state blocks must be trivially copyable.");
+
+			WriteBytes(l_stateBlocks, sizeof(T) * l_count);
+		}
+
+
+		void WriteBytes(const void* l_data, const size_t l_sizeInBytes);
+
+
+		size_t GetTotalBytesWritten() const;
+
+	private:
+
+		std::vector<uint8_t>& m_buffer;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+
+
+#include "Entities/EntityType.hpp"
+#include <cinttypes>
+
+
+namespace Asteroid
+{
+
+	//Data every entity type has its own copy of. The first ones are the columns of the archetype
+	//tables, the rest stand for the state kept inside the components of that entity type.
+	enum class EntityData : uint32_t
+	{
+		POSITIONS = 0,
+		RAY_DIRECTIONS,
+		SPEEDS,
+		ANIMATION_OFFSETS,
+		FLAGS,
+
+		MOVEMENT_COMPONENTS,
+		ANIMATION_COMPONENTS,
+		COLLISION_COMPONENTS,
+		STATE_COMPONENTS,
+		ATTRIBUTE_COMPONENTS,
+
+		TOTAL_NUM_ENTITY_DATA
+	};
+
+
+	//Data that is not owned by an entity type.
+	enum class SharedData : uint32_t
+	{
+		INPUT = 0,
+		HIT_COUNTER,
+		RENDER_QUEUE,
+
+		TOTAL_NUM_SHARED_DATA
+	};
+
+
+	//What a system reads and writes. Writing something implies being allowed to read it as well.
+	class SystemAccess final
+	{
+	public:
+
+		SystemAccess& Reads(const EntityType l_type, const EntityData l_data);
+		SystemAccess& Writes(const EntityType l_type, const EntityData l_data);
+
+		SystemAccess& Reads(const SharedData l_data);
+		SystemAccess& Writes(const SharedData l_data);
+
+		//Two systems conflict if one of them writes something the other one reads or writes.
+		bool ConflictsWith(const SystemAccess& l_other) const;
+
+		bool CanRead(const uint32_t l_bit) const;
+		bool CanWrite(const uint32_t l_bit) const;
+
+		static uint32_t GetBit(const EntityType l_type, const EntityData l_data);
+		static uint32_t GetBit(const SharedData l_data);
+
+	private:
+		uint64_t m_reads{};
+		uint64_t m_writes{};
+	};
+
+
+	/*
+	* Debug mode of the SystemScheduler. While a system runs, the accessors of the archetype columns 
+	* and the render queue report what they touch, and anything the system did not declare is printed
+	* and counted. Outside of a system, or with verification off, the reports do nothing.
+	*/
+	namespace SystemAccessCheck
+	{
+		//l_reportedViolations remembers what was already printed for the system, so it is only printed once.
+		void BeginSystem(const char* l_systemName, const SystemAccess* l_access, uint64_t* l_reportedViolations);
+		void EndSystem();
+
+		void OnRead(const EntityType l_type, const EntityData l_data);
+		void OnWrite(const EntityType l_type, const EntityData l_data);
+
+		void OnRead(const SharedData l_data);
+		void OnWrite(const SharedData l_data);
+
+		uint32_t GetTotalNumViolations();
+	}
+}
\ No newline at end of file
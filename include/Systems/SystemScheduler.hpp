@@ -0,0 +1,82 @@
+#pragma once
+
+
+
+#include "Systems/SystemAccess.hpp"
+#include "Systems/Job.hpp"
+#include <functional>
+#include <vector>
+#include <atomic>
+#include <cinttypes>
+
+
+namespace Asteroid
+{
+
+	struct UpdateComponents;
+	class JobSystem;
+
+
+	/*
+	* Runs the systems of a frame as jobs of the JobSystem. Each system declares what it reads and
+	* writes, and two systems that conflict run in the order they were added. Everything else may 
+	* run at the same time. The dependency graph is built once in Start(), a frame only resets the
+	* counts of pending dependencies, so Run() does not allocate.
+	*/
+	class SystemScheduler final
+	{
+	public:
+
+		using SystemFunction = std::function<bool(UpdateComponents&)>;
+
+		SystemScheduler() = default;
+
+		SystemScheduler(const SystemScheduler&) = delete;
+		SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+		//l_name has to outlive the scheduler.
+		void AddSystem(const char* l_name, const SystemAccess& l_access, SystemFunction&& l_function);
+
+		//No system can be added afterwards. When l_verifyAccess is set, what the systems touch 
+		//is checked against what they declared.
+		void Start(JobSystem& l_jobSystem, const bool l_verifyAccess);
+
+		//Returns once every system ran. False if one of them failed or, with verification on, 
+		//touched data it did not declare.
+		bool Run(UpdateComponents& l_updateContext);
+
+	private:
+
+		struct SystemNode final
+		{
+			const char* m_name{};
+			SystemAccess m_access{};
+			SystemFunction m_function{};
+
+			//Systems that can only start after this one is done.
+			std::vector<uint32_t> m_dependents{};
+			uint32_t m_totalNumDependencies{};
+
+			uint64_t m_reportedAccessViolations{};
+		};
+
+		//Job function, l_begin is the index of the system.
+		static void RunSystemJob(void* l_scheduler, const uint32_t l_begin, const uint32_t l_end);
+
+		//Runs l_systemIndex, then starts the dependents it was the last dependency of.
+		void ExecuteSystem(const uint32_t l_systemIndex);
+
+	private:
+
+		std::vector<SystemNode> m_systems{};
+		std::vector<std::atomic<uint32_t>> m_totalNumPendingDependencies{};
+
+		JobSystem* m_jobSystem{};
+		JobCounter m_frameCounter{};
+		UpdateComponents* m_updateContext{};
+		std::atomic<bool> m_frameResult{ true };
+
+		bool m_verifyAccess{};
+		bool m_isStarted{};
+	};
+}
\ No newline at end of file
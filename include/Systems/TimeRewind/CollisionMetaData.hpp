@@ -4,8 +4,7 @@
 
 
 
-#include <vector>
-#include <utility>
+#include <cinttypes>
 
 
 namespace Asteroid
@@ -14,7 +13,6 @@ namespace Asteroid
 
 	struct CollisionMetaData final
 	{
-		std::vector<std::pair<uint32_t, bool>> m_alreadyRegisteredCollisionEntityIDs{};
 		uint32_t m_hitBullet{};
 		bool m_isCollisionActive{};
 		bool m_resetCollision{};
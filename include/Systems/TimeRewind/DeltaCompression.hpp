@@ -0,0 +1,33 @@
+#pragma once
+
+
+
+
+
+#include <vector>
+#include <cinttypes>
+#include <cstddef>
+
+
+namespace Asteroid
+{
+	namespace DeltaCompression
+	{
+		/*
+		* XORs the two snapshots byte by byte (the shorter one is treated as zero padded) and 
+		* run length encodes the zero bytes of the result. Consecutive frames differ in only 
+		* a handful of bytes, so most of the delta ends up as long zero runs.
+		* 
+		* The output is a list of [zero run : uint16][literal run : uint16][literal bytes].
+		*/
+		void CompressXorDelta(const std::vector<uint8_t>& l_olderSnapshot, const std::vector<uint8_t>& l_newerSnapshot, std::vector<uint8_t>& l_compressedDelta);
+
+
+		/*
+		* Since XOR is its own inverse, applying the delta to either of the two snapshots 
+		* it was built from yields the other one. l_resultSizeInBytes is the size of the 
+		* snapshot being reconstructed.
+		*/
+		void ApplyCompressedXorDelta(const uint8_t* l_compressedDelta, const size_t l_compressedDeltaSizeInBytes, std::vector<uint8_t>& l_snapshot, const size_t l_resultSizeInBytes);
+	}
+}
\ No newline at end of file
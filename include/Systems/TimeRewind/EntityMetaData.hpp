@@ -15,8 +15,8 @@ namespace Asteroid
 	{
 		glm::vec2 m_pos{};
 		uint32_t m_id{};
+		uint32_t m_generation{};
 		EntityType m_type{};
-		bool m_isActive{};
 	};
 
 }
\ No newline at end of file
@@ -4,25 +4,56 @@
 
 
 
-#include "Systems/TimeRewind/EntityFrameTimeRewind.hpp"
-#include "Systems/DelayedSetStateCallback.hpp"
-#include <array>
+#include "Systems/DelayedCallbackState.hpp"
+#include <glm.hpp>
 #include <vector>
+#include <bitset>
 
 
 namespace Asteroid
 {
 
-	struct Frame final
+	//Everything about a frame except its entities snapshot and delayed callbacks.
+	//It is trivially copyable so it can be written as is into a frame record.
+	struct FrameHeader final
 	{
 		//194 is the total number of entities we always initialize 
-		std::array<EntityFrameTimeRewind, 194U> m_allEntitysMetaDataInThisFrame{};
-		std::vector<DelayedSetStateCallback> m_delayedCallbacks{};
+		static constexpr uint32_t m_maxNumEntities{ 194U };
+
+		//Bit i is set if entity i was active in this frame.
+		std::bitset<m_maxNumEntities> m_activeEntities{};
+		uint32_t m_totalNumActiveEntities{};
+
+		//Frame numbers of consecutive frames in the history are always consecutive.
+		uint32_t m_frameNumber{};
+
+		uint32_t m_snapshotSizeInBytes{};
+		uint32_t m_compressedDeltaSizeInBytes{};
+
+		//Keyframes store their snapshot compressed against an empty one instead of against 
+		//the next frame, so they can be decoded without anything newer.
+		bool m_isKeyframe{};
+
+		uint32_t m_totalNumDelayedCallbacks{};
+		uint32_t m_oldestDelayedCallbackID{};
+
 		glm::vec2 m_mousePos{};
 		float m_time{};
 		uint32_t m_totalNumBulletsHitAsteroid{};
 		bool m_isMouseHidden{};
+	};
+
 
+	/*
+	* Only the newest frame is kept in this form by TimeRewind. Every older frame is stored as 
+	* a record of [FrameHeader][DelayedCallbackState * m_totalNumDelayedCallbacks][compressed delta]
+	* where the delta is the zero run length encoded XOR that turns the snapshot of the frame 
+	* recorded right after it back into its own snapshot (or an empty snapshot for keyframes).
+	*/
+	struct Frame final
+	{
+		FrameHeader m_header{};
+		std::vector<DelayedCallbackState> m_delayedCallbacks{};
 	};
 
 }
\ No newline at end of file
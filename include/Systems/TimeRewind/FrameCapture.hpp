@@ -0,0 +1,24 @@
+#pragma once
+
+
+
+
+
+#include "Systems/TimeRewind/Frame.hpp"
+#include <vector>
+
+
+namespace Asteroid
+{
+
+	//Raw state captured by the main thread before it is handed to the rewind worker thread.
+	struct FrameCapture final
+	{
+		Frame m_frame{};
+
+		//Only the entities that were active in this frame are recorded. Each one is written
+		//back to back as its EntityMetaData followed by the state blocks of its components.
+		std::vector<uint8_t> m_activeEntitiesSnapshot{};
+	};
+
+}
\ No newline at end of file
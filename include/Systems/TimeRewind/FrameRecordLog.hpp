@@ -0,0 +1,76 @@
+#pragma once
+
+
+
+
+
+#include <cinttypes>
+#include <cstddef>
+
+
+namespace Asteroid
+{
+
+	/*
+	* Stores variable sized frame records back to back in a fixed block of memory that is 
+	* used as a ring. When a new record does not fit, the oldest records are evicted. If a 
+	* spill log is given, evicted records are appended to it instead of being dropped, which 
+	* is how the in memory history overflows into the memory mapped one.
+	* 
+	* The memory is owned by the caller. The front of it holds a fixed ring of record locations,
+	* sized for as many records of the minimum size as fit, so the log never allocates.
+	*/
+	class FrameRecordLog final
+	{
+	public:
+
+		FrameRecordLog();
+
+		//l_storage has to be aligned for size_t. l_minRecordSizeInBytes bounds how many records can be stored at once.
+		void Init(uint8_t* l_storage, const size_t l_capacityInBytes, const size_t l_minRecordSizeInBytes);
+
+		void Append(const uint8_t* l_record, const size_t l_sizeInBytes, FrameRecordLog* l_spillLog);
+
+		const uint8_t* GetNewestRecord(size_t& l_sizeInBytes) const;
+		const uint8_t* GetOldestRecord(size_t& l_sizeInBytes) const;
+
+		//Index 0 is the oldest record.
+		const uint8_t* GetRecord(const uint32_t l_index, size_t& l_sizeInBytes) const;
+
+		void PopNewestRecord();
+
+		bool IsEmpty() const;
+
+		uint32_t GetTotalNumRecords() const;
+
+		size_t GetCapacityInBytes() const;
+
+		void Clear();
+
+	private:
+
+		struct RecordLocation final
+		{
+			size_t m_offset{};
+			size_t m_sizeInBytes{};
+		};
+
+		void EvictOldestRecord(FrameRecordLog* l_spillLog);
+
+		//Index 0 is the oldest record.
+		RecordLocation& GetRecordLocation(const uint32_t l_index) const;
+
+	private:
+
+		//Where the records themselves go, after the ring of locations.
+		uint8_t* m_storage{};
+		size_t m_capacityInBytes{};
+		size_t m_writeOffset{};
+
+		RecordLocation* m_records{};
+		uint32_t m_maxNumRecords{};
+		uint32_t m_oldestRecord{};
+		uint32_t m_totalNumRecords{};
+	};
+
+}
\ No newline at end of file
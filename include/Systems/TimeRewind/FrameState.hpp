@@ -0,0 +1,41 @@
+#pragma once
+
+
+
+
+
+#include "Systems/TimeRewind/Frame.hpp"
+#include "Systems/TimeRewind/FrameCapture.hpp"
+#include <vector>
+#include <bitset>
+#include <cinttypes>
+
+
+namespace Asteroid
+{
+
+	class Entity;
+	class ArchetypeTables;
+	class InputSystem;
+	class CallbacksTimer;
+
+	namespace FrameState
+	{
+		//Turns off an entity that is active now but was not in the state being restored.
+		void DeactivateEntity(Entity& l_entity);
+
+		//Records everything needed to bring the game back to the current frame into l_capture.
+		void Capture(const std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, const InputSystem& l_inputSystem, const float l_time, const uint32_t l_totalNumBulletsHitAsteroid, const CallbacksTimer& l_callbackTimer, FrameCapture& l_capture);
+
+
+		//Walks an entities snapshot without restoring anything. Every saved entity has to be one of
+		//l_entities, be set in l_activeEntities exactly once and have the type of that entity. Used 
+		//for snapshots read from a file before they are applied.
+		bool ValidateSnapshot(const std::bitset<FrameHeader::m_maxNumEntities>& l_activeEntities, const uint32_t l_totalNumActiveEntities
+			, const uint8_t* l_snapshot, const size_t l_sizeInBytes, const std::vector<Entity>& l_entities);
+
+
+		//Puts the game back into the state l_frame and l_snapshot were captured from.
+		void Apply(const Frame& l_frame, const std::vector<uint8_t>& l_snapshot, std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, InputSystem& l_inputSystem, float& l_time, uint32_t& l_totalNumBulletsHitAsteroid, CallbacksTimer& l_callbackTimer);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+
+
+
+
+
+#include "Systems/InputFrame.hpp"
+#include "Systems/TimeRewind/ReplayKeyframe.hpp"
+#include <vector>
+#include <string>
+#include <cinttypes>
+
+
+namespace Asteroid
+{
+
+	class Entity;
+	class ArchetypeTables;
+	class InputSystem;
+	class CallbacksTimer;
+	class EntitySpawnerFromPools;
+
+	/*
+	* Low memory alternative to TimeRewind. Only the input of every frame is kept, along with a 
+	* keyframe of the full game state every m_framesBetweenKeyframes frames. Since the simulation 
+	* is deterministic given its input and the random engine of the spawner, any past frame can be 
+	* rebuilt by restoring the keyframe before it and re-simulating forward.
+	* 
+	* The first keyframe and the input frames are all a replay file needs.
+	*/
+	class InputReplayLog final
+	{
+	public:
+
+		InputReplayLog();
+
+		void Init(const uint32_t l_framesBetweenKeyframes);
+
+
+		//Appends the input of the frame that is about to be simulated. The game state is captured
+		//as well if the frame falls on a keyframe.
+		void RecordFrame(const InputFrame& l_inputFrame, const std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, const InputSystem& l_inputSystem, const uint32_t l_totalNumBulletsHitAsteroid, const CallbacksTimer& l_callbackTimer, const EntitySpawnerFromPools& l_spawner);
+
+		//Captures the keyframe of l_frameIndex if it is due and missing. Used while playing back
+		//a loaded replay, which only comes with the first keyframe.
+		void CaptureKeyframeIfMissing(const uint32_t l_frameIndex, const std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, const InputSystem& l_inputSystem, const uint32_t l_totalNumBulletsHitAsteroid, const CallbacksTimer& l_callbackTimer, const EntitySpawnerFromPools& l_spawner);
+
+
+		//Puts the game into the state of the latest keyframe at or before l_frameIndex
+		//and returns the frame index of that keyframe.
+		uint32_t RestoreKeyframe(const uint32_t l_frameIndex, std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, InputSystem& l_inputSystem, float& l_time, uint32_t& l_totalNumBulletsHitAsteroid, CallbacksTimer& l_callbackTimer, EntitySpawnerFromPools& l_spawner) const;
+
+
+		const InputFrame& GetInputFrame(const uint32_t l_frameIndex) const;
+
+		uint32_t GetTotalNumFrames() const;
+
+		//Index of the last frame that began at or before l_time.
+		uint32_t FindFrameAtTime(const float l_time) const;
+
+		void GetTimelineRange(float& l_oldestTime, float& l_newestTime) const;
+
+		//Keeps only the first l_totalNumFrames frames.
+		void Truncate(const uint32_t l_totalNumFrames);
+
+		//Callbacks older than this are not referenced by any keyframe.
+		uint32_t GetOldestReferencedCallbackID() const;
+
+		void Clear();
+
+		//Level the recorded frames belong to.
+		void SetLevel(const uint32_t l_level);
+		uint32_t GetLevel() const;
+
+
+		//Fails if the first keyframe still has pending delayed callbacks since those cannot 
+		//be written to a file.
+		bool SaveToFile(const std::string& l_filePath) const;
+
+		//Every section is checked against the length of the file, and the keyframe against l_entities
+		//and the pools of l_spawner, before the log is replaced. Nothing changes if it fails.
+		bool LoadFromFile(const std::string& l_filePath, const std::vector<Entity>& l_entities, const EntitySpawnerFromPools& l_spawner);
+
+	private:
+
+		void CaptureKeyframe(const uint32_t l_frameIndex, const float l_time, const std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, const InputSystem& l_inputSystem, const uint32_t l_totalNumBulletsHitAsteroid, const CallbacksTimer& l_callbackTimer, const EntitySpawnerFromPools& l_spawner);
+
+	private:
+
+		std::vector<InputFrame> m_inputFrames{};
+
+		//Keyframe i belongs to frame i * m_framesBetweenKeyframes. Slots past m_totalNumKeyframes
+		//are kept around so their buffers get reused.
+		std::vector<ReplayKeyframe> m_keyframes{};
+		uint32_t m_totalNumKeyframes{};
+
+		uint32_t m_framesBetweenKeyframes{ 300U };
+
+		uint32_t m_level{ 1U };
+	};
+
+}
\ No newline at end of file
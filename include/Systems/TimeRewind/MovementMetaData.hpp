@@ -13,7 +13,7 @@ namespace Asteroid
 
 	struct MovementMetaData final
 	{
-		glm::vec2 m_speed;
+		float m_speed;
 		glm::vec2 m_initialPos{};
 		glm::vec2 m_rayDirection{};
 		float m_initialT{};
@@ -0,0 +1,25 @@
+#pragma once
+
+
+
+
+
+#include "Systems/TimeRewind/FrameCapture.hpp"
+#include <vector>
+#include <random>
+
+
+namespace Asteroid
+{
+
+	//Full game state at the start of frame m_frameIndex of an InputReplayLog.
+	struct ReplayKeyframe final
+	{
+		uint32_t m_frameIndex{};
+
+		FrameCapture m_state{};
+		std::vector<uint8_t> m_poolsSnapshot{};
+		std::mt19937 m_randomEngine{};
+	};
+
+}
\ No newline at end of file
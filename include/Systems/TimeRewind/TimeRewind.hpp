@@ -6,7 +6,16 @@
 
 
 #include <vector>
+#include <array>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include "Systems/TimeRewind/Frame.hpp"
+#include "Systems/TimeRewind/FrameCapture.hpp"
+#include "Systems/TimeRewind/FrameRecordLog.hpp"
+#include "Systems/TimeRewind/TimeRewindInitData.hpp"
+#include "Systems/MappedFile.hpp"
 
 
 
@@ -15,8 +24,8 @@ namespace Asteroid
 {
 
 	class Entity;
+	class ArchetypeTables;
 	class InputSystem;
-	struct DelayedSetStateCallback;
 	class CallbacksTimer;
 
 	class TimeRewind final
@@ -25,22 +34,110 @@ namespace Asteroid
 
 		TimeRewind();
 
+		TimeRewind(const TimeRewind&) = delete;
+		TimeRewind& operator=(const TimeRewind&) = delete;
 
-		void Update(const std::vector<Entity>& l_entities, const InputSystem& l_inputSystem ,const float l_time, const uint32_t l_totalNumBulletsHitAsteroid, const std::vector<DelayedSetStateCallback>& l_delayedCallbacks);
+		~TimeRewind();
 
 
-		void RewindTimeByOneFrame(std::vector<Entity>& l_entities, InputSystem& l_inputSystem,float& l_time, uint32_t& l_totalNumBulletsHitAsteroid, CallbacksTimer& l_callbackTimer);
+		//Returns false if the spill file could not be mapped. Rewinding still works 
+		//in that case but the history is limited to the memory budget.
+		bool Init(const TimeRewindInitData& l_initData);
+
+
+		//Captures the raw state of the current frame and hands it to the worker thread
+		//which compresses it and inserts it into the history. Never waits on the worker,
+		//the frame is skipped if the worker is too far behind.
+		void Update(const std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, const InputSystem& l_inputSystem ,const float l_time, const uint32_t l_totalNumBulletsHitAsteroid, CallbacksTimer& l_callbackTimer);
+
+
+		//Restores the frame that is l_totalNumFrames behind the current one and drops everything
+		//newer than it from the history. Holding the rewind key calls this once per rendered frame,
+		//so l_totalNumFrames acts as the rewind speed.
+		void RewindTimeByFrames(const uint32_t l_totalNumFrames, std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, InputSystem& l_inputSystem,float& l_time, uint32_t& l_totalNumBulletsHitAsteroid, CallbacksTimer& l_callbackTimer);
+
+
+		//Restores the latest frame recorded at or before l_targetTime. If l_truncateHistory is false
+		//the history is left untouched so this can be called repeatedly to preview a point in time.
+		void SeekToTime(const float l_targetTime, const bool l_truncateHistory, std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, InputSystem& l_inputSystem, float& l_time, uint32_t& l_totalNumBulletsHitAsteroid, CallbacksTimer& l_callbackTimer);
+
+
+		//Time of the oldest and newest frames in the history. Does not wait on the worker thread.
+		void GetTimelineRange(float& l_oldestTime, float& l_newestTime);
 
 
 		void Flush();
 
 
 	private:
-		constexpr static uint32_t m_totalNumPastFramesToRecord{1800U};
-		std::vector<Frame> m_pastFrame{};
-		uint32_t m_startIndex{};
-		uint32_t m_endIndex{};
-		bool m_firstTimeStartAndEndIndexAreSame{ true };
+
+		void WorkerLoop();
+
+		void InsertCaptureIntoHistory(FrameCapture& l_capture);
+
+		//Turns the newest record of the history back into the newest frame.
+		void PopNewestRecordIntoNewestFrame();
+
+		void PublishHistoryBounds();
+
+		//Position 0 is the oldest frame and GetTotalNumFrames() - 1 is the newest one.
+		uint32_t GetTotalNumFrames() const;
+
+		const uint8_t* GetRecord(const uint32_t l_position, size_t& l_sizeInBytes) const;
+
+		void ReadRecordHeader(const uint32_t l_position, FrameHeader& l_header) const;
+
+		//Starts from the first keyframe at or after l_position and walks the deltas back to it.
+		void DecodeFrame(const uint32_t l_position, Frame& l_frame, std::vector<uint8_t>& l_snapshot) const;
+
+		uint32_t FindFrameAtTime(const float l_time) const;
+
+		void RestoreFrame(const uint32_t l_position, const bool l_truncateHistory, std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, InputSystem& l_inputSystem, float& l_time, uint32_t& l_totalNumBulletsHitAsteroid, CallbacksTimer& l_callbackTimer);
+
+		//Blocks until the worker thread is done with the last handed over capture.
+		//After it returns the history can be safely accessed from the main thread.
+		void WaitForWorkerToBeIdle();
+
+	private:
+		//Newest frame in the history along with its uncompressed snapshot.
+		Frame m_newestFrame{};
+		std::vector<uint8_t> m_newestSnapshot{};
+		bool m_hasNewestFrame{};
+
+		//Recent records live in memory and overflow into the mapped file.
+		std::vector<uint8_t> m_inMemoryStorage{};
+		FrameRecordLog m_inMemoryRecords{};
+		MappedFile m_spillFile{};
+		FrameRecordLog m_spilledRecords{};
+
+		uint32_t m_framesBetweenKeyframes{ 60U };
+
+		//Scratch buffers used by the worker thread when building a record.
+		std::vector<uint8_t> m_compressedDelta{};
+		std::vector<uint8_t> m_record{};
+
+		//Scratch for frames decoded out of the history on the main thread.
+		Frame m_decodedFrame{};
+		std::vector<uint8_t> m_decodedSnapshot{};
+
+		//Callbacks older than this are not referenced by any frame in the history.
+		std::atomic<uint32_t> m_oldestReferencedCallbackID{};
+
+		//Guarded by m_captureMutex.
+		float m_oldestFrameTime{};
+		float m_newestFrameTime{};
+
+		//Ring of captures the main thread fills and the worker thread compresses in order.
+		//When every capture is still waiting on the worker the frame is dropped instead.
+		std::array<FrameCapture, 4> m_captures{};
+		uint32_t m_oldestPendingCapture{};
+		uint32_t m_totalNumPendingCaptures{};
+		uint32_t m_totalNumDroppedCaptures{};
+		bool m_stopWorker{};
+
+		std::mutex m_captureMutex;
+		std::condition_variable m_captureCondition;
+		std::thread m_worker;
 	};
 
 }
\ No newline at end of file
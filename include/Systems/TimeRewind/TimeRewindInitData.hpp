@@ -0,0 +1,43 @@
+#pragma once
+
+
+
+
+
+#include "Systems/TimeRewind/TimeRewindMode.hpp"
+#include <cstddef>
+#include <cinttypes>
+#include <string>
+
+
+namespace Asteroid
+{
+
+	struct TimeRewindInitData final
+	{
+		TimeRewindMode m_mode{ TimeRewindMode::STATE_SNAPSHOTS };
+
+		//Recent frames are kept in memory up to this budget. Older ones spill into the mapped file.
+		size_t m_memoryBudgetInBytes{ 32U * 1024U * 1024U };
+
+		//Once the mapped file is full the oldest frames are dropped. Zero disables spilling, which
+		//is the default since the file takes its whole size on disks without sparse files.
+		size_t m_spillFileSizeInBytes{ 0U };
+
+		//Empty puts the spill file in the temp directory. It never outlives the game either way.
+		std::string m_spillFilePath{};
+
+		//Any frame can be restored by decoding at most this many deltas.
+		uint32_t m_framesBetweenKeyframes{ 60U };
+
+		//Only used in INPUT_REPLAY mode. Rewinding re-simulates at most this many frames.
+		uint32_t m_framesBetweenReplayKeyframes{ 300U };
+
+		//In INPUT_REPLAY mode the input log of a level is saved here whenever the level ends.
+		std::string m_replayFilePath{ "LastLevelReplay.bin" };
+
+		//If not empty, this replay is played back when the game starts.
+		std::string m_replayToPlayPath{};
+	};
+
+}
\ No newline at end of file
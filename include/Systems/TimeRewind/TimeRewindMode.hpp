@@ -0,0 +1,19 @@
+#pragma once
+
+
+
+#include <cinttypes>
+
+
+namespace Asteroid
+{
+	enum class TimeRewindMode : uint32_t
+	{
+		//Every frame keeps a delta compressed snapshot of the whole game state.
+		STATE_SNAPSHOTS = 0,
+
+		//Every frame keeps only its input. Past frames are rebuilt by re-simulating
+		//forward from the closest keyframe.
+		INPUT_REPLAY
+	};
+}
\ No newline at end of file
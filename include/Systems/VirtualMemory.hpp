@@ -0,0 +1,53 @@
+#pragma once
+
+
+
+
+
+#include <cinttypes>
+#include <cstddef>
+
+
+namespace Asteroid
+{
+
+	//Memory taken straight from the OS in whole pages, for storage that is big and long lived.
+	namespace VirtualMemory
+	{
+
+		size_t GetPageSize();
+
+		//Zero if the OS offers no huge pages to this process.
+		size_t GetHugePageSize();
+
+		size_t RoundUpToPageSize(const size_t l_sizeInBytes);
+
+		//Maps zeroed read write pages, page aligned. With l_preferHugePages the OS is asked to back
+		//the mapping with huge pages where it can, which only helps for ranges of whole huge pages.
+		//Returns nullptr on failure.
+		void* Allocate(const size_t l_sizeInBytes, const bool l_preferHugePages);
+
+		//l_sizeInBytes has to be the size the memory was allocated with.
+		void Free(void* l_memory, const size_t l_sizeInBytes);
+
+		//Makes the OS back every page now, so first writes do not fault in the middle of the game.
+		void Prefault(void* l_memory, const size_t l_sizeInBytes);
+
+		//Keeps the pages resident. Fails if the process is not allowed to lock that much memory.
+		bool Lock(void* l_memory, const size_t l_sizeInBytes);
+
+
+		/*
+		* Address space only. Reserve() takes a range no other allocation will be placed in, 
+		* aligned to l_alignment (a power of two), without backing any of it. Parts of it become 
+		* usable with Commit() and are given back to the OS with Decommit(), while the range itself 
+		* stays reserved until Release(). Returns nullptr on failure.
+		*/
+		void* Reserve(const size_t l_sizeInBytes, const size_t l_alignment, const bool l_preferHugePages);
+		bool Commit(void* l_memory, const size_t l_sizeInBytes);
+		void Decommit(void* l_memory, const size_t l_sizeInBytes);
+		void Release(void* l_memory, const size_t l_sizeInBytes);
+
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+
+
+
+
+#include "Systems/LogSystem.hpp"
+#include <cassert>
+
+
+
+/*
+* Use instead of assert() when the expression has side effects. The expression is evaluated
+* in every configuration and only the check of its result is gone in release builds, other
+* than a log of the failure.
+*/
+#define ASTEROID_CHECK(l_expression) \
+	do { \
+		const bool lv_checkResult = static_cast<bool>(l_expression); \
+		if (false == lv_checkResult) { \
+			LOG(Asteroid::LogSystem::Severity::FAILURE, Asteroid::LogSystem::Channel::PROGRAM_LOGIC, "Check failed: %s", #l_expression); \
+		} \
+		assert(true == lv_checkResult && #l_expression); \
+	} while (false)
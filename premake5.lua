@@ -51,7 +51,8 @@ project "AsteroidSDL3"
 
     filter "configurations:Release"
         defines { "NDEBUG" }
-        optimize "On"
+        optimize "Speed"
+        linktimeoptimization "On"
 
 	filter "toolset:gcc or toolset:clang"
 		buildoptions { "-Wall", "-Wextra", "-Werror" }
@@ -4,6 +4,9 @@
 
 
 #include "Components/AttributeComponent.hpp"
+#include "Systems/SnapshotWriter.hpp"
+#include "Systems/SnapshotReader.hpp"
+#include "Systems/TimeRewind/AttributeMetaData.hpp"
 
 
 
@@ -34,4 +37,19 @@ namespace Asteroid
 	{
 		m_hp = l_hp;
 	}
+
+
+	void AttributeComponent::Snapshot(SnapshotWriter& l_writer) const
+	{
+		l_writer.Write(AttributeMetaData{ .m_hp = m_hp });
+	}
+
+	void AttributeComponent::Restore(SnapshotReader& l_reader)
+	{
+		AttributeMetaData lv_attribMetaData{};
+		l_reader.Read(lv_attribMetaData);
+
+		m_hp = lv_attribMetaData.m_hp;
+	}
+
 }
\ No newline at end of file
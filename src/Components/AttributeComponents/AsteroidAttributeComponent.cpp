@@ -5,6 +5,9 @@
 
 
 #include "Components/AttributeComponents/AsteroidAttributeComponent.hpp"
+#include "Systems/SnapshotWriter.hpp"
+#include "Systems/SnapshotReader.hpp"
+#include "Systems/TimeRewind/AttributeMetaData.hpp"
 #include "Components/RayMovementComponent.hpp"
 #include "Components/UpdateComponents.hpp"
 #include "Engine.hpp"
@@ -60,4 +63,19 @@ namespace Asteroid
 		return m_state;
 	}
 
-}
+
+	void AsteroidAttributeComponent::Snapshot(SnapshotWriter& l_writer) const
+	{
+		l_writer.Write(AttributeMetaData{ .m_hp = m_hp, .m_asteroidStates = m_state });
+	}
+
+	void AsteroidAttributeComponent::Restore(SnapshotReader& l_reader)
+	{
+		AttributeMetaData lv_attribMetaData{};
+		l_reader.Read(lv_attribMetaData);
+
+		m_hp = lv_attribMetaData.m_hp;
+		m_state = lv_attribMetaData.m_asteroidStates;
+	}
+
+}
\ No newline at end of file
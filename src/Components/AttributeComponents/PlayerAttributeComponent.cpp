@@ -22,14 +22,6 @@ namespace Asteroid
 		AttributeComponent::Init(l_ownerEntityHandle, l_hp);
 	}
 
-	bool PlayerAttributeComponent::Update(UpdateComponents& l_updateContext)
-	{
-
-
-
-		return true;
-	}
-
 
 	void PlayerAttributeComponent::DecrementHPByOne()
 	{
@@ -4,6 +4,9 @@
 
 
 #include "Components/CollisionComponent.hpp"
+#include "Systems/SnapshotWriter.hpp"
+#include "Systems/SnapshotReader.hpp"
+#include "Systems/TimeRewind/CollisionMetaData.hpp"
 
 
 
@@ -83,4 +86,25 @@ namespace Asteroid
 		return m_frameCountToDeactivateCollision;
 	}
 
+
+	void CollisionComponent::Snapshot(SnapshotWriter& l_writer) const
+	{
+		l_writer.Write(CollisionMetaData
+			{
+				.m_isCollisionActive = m_isCollisionActive,
+				.m_resetCollision = m_resetCollision,
+				.m_firstCollision = m_firstCollision
+			});
+	}
+
+	void CollisionComponent::Restore(SnapshotReader& l_reader)
+	{
+		CollisionMetaData lv_collisionMetaData{};
+		l_reader.Read(lv_collisionMetaData);
+
+		m_isCollisionActive = lv_collisionMetaData.m_isCollisionActive;
+		m_resetCollision = lv_collisionMetaData.m_resetCollision;
+		m_firstCollision = lv_collisionMetaData.m_firstCollision;
+	}
+
 }
\ No newline at end of file
@@ -5,10 +5,14 @@
 
 
 #include "Components/CollisionComponents/AsteroidCollisionComponent.hpp"
+#include "Systems/SnapshotWriter.hpp"
+#include "Systems/SnapshotReader.hpp"
+#include "Systems/TimeRewind/CollisionMetaData.hpp"
 #include "Components/OnceRepeatableAnimationComponent.hpp"
 #include "Entities/Entity.hpp"
 #include "Components/StateComponents/ActiveBasedStateComponent.hpp"
 #include "Systems/CallbacksTimer.hpp"
+#include "Systems/DelayedCallbacks.hpp"
 #include "Systems/LogSystem.hpp"
 #include "Components/UpdateComponents.hpp"
 #include "Systems/EventSystem/EventCollision.hpp"
@@ -95,25 +99,26 @@ namespace Asteroid
 			}
 		
 			m_fireExplosionAnimation->StartAnimation();
-			bool lv_stateValue{ false };
 
-			DelayedSetStateCallback lv_delayedDeactive
-			{ .m_callback{[lv_ownerEntity, lv_stateValue] {lv_ownerEntity->SetActiveState(lv_stateValue); }},
-			  .m_currentFrame = 0U,
-			  .m_maxNumFrames = m_activeComponent->GetframeCountToDeactivate(),
+			DelayedCallbackDescriptor lv_deactivateDescriptor
+			{
+				.m_type = DelayedCallbackType::DEACTIVATE_ENTITY,
+				.m_entityID = lv_ownerEntity->GetID(),
+				.m_entityGeneration = lv_ownerEntity->GetGeneration()
 			};
 
-			lv_collisionEvent->m_callbackTimer->AddSetStateCallback(std::move(lv_delayedDeactive));
+			lv_collisionEvent->m_callbackTimer->AddSetStateCallback(DelayedCallbacks::Create(lv_collisionEvent->GetEntities(), lv_deactivateDescriptor, m_activeComponent->GetframeCountToDeactivate()));
 
 			m_activeComponent->SetDelayedActivationCallbackFlag(true);
 
-			DelayedSetStateCallback lv_delayedCollisionDeactivate
+			DelayedCallbackDescriptor lv_collisionDeactivateDescriptor
 			{
-				.m_callback{[this, lv_stateValue] {this->SetCollisionState(lv_stateValue); }},
-				.m_currentFrame = 0U,
-				.m_maxNumFrames = m_frameCountToDeactivateCollision
+				.m_type = DelayedCallbackType::DEACTIVATE_COLLISION,
+				.m_entityID = lv_ownerEntity->GetID(),
+				.m_entityGeneration = lv_ownerEntity->GetGeneration()
 			};
-			lv_collisionEvent->m_callbackTimer->AddSetStateCallback(std::move(lv_delayedCollisionDeactivate));
+
+			lv_collisionEvent->m_callbackTimer->AddSetStateCallback(DelayedCallbacks::Create(lv_collisionEvent->GetEntities(), lv_collisionDeactivateDescriptor, m_frameCountToDeactivateCollision));
 
 			m_repeatableAnimationComponent->SetVisibleState(false);
 			LOG(Severity::INFO, Channel::PROGRAM_LOGIC, "2 callbacks have been recorded for an asteroid entity.");
@@ -123,4 +128,27 @@ namespace Asteroid
 
 	}
 
+
+	void AsteroidCollisionComponent::Snapshot(SnapshotWriter& l_writer) const
+	{
+		l_writer.Write(CollisionMetaData
+			{
+				.m_hitBullet = m_hitBullet,
+				.m_isCollisionActive = m_isCollisionActive,
+				.m_resetCollision = m_resetCollision,
+				.m_firstCollision = m_firstCollision
+			});
+	}
+
+	void AsteroidCollisionComponent::Restore(SnapshotReader& l_reader)
+	{
+		CollisionMetaData lv_collisionMetaData{};
+		l_reader.Read(lv_collisionMetaData);
+
+		m_hitBullet = lv_collisionMetaData.m_hitBullet;
+		m_isCollisionActive = lv_collisionMetaData.m_isCollisionActive;
+		m_resetCollision = lv_collisionMetaData.m_resetCollision;
+		m_firstCollision = lv_collisionMetaData.m_firstCollision;
+	}
+
 }
\ No newline at end of file
@@ -20,11 +20,6 @@ namespace Asteroid
 
 	}
 
-	bool BulletCollisionComponent::Update(UpdateComponents& l_updateContext)
-	{
-		return true;
-	}
-
 
 
 	void BulletCollisionComponent::Init(EntityHandle l_ownerEntityHandle
@@ -7,8 +7,12 @@
 #include "Components/AttributeComponents/PlayerAttributeComponent.hpp"
 #include "Components/CollisionComponents/AsteroidCollisionComponent.hpp"
 #include "Systems/CallbacksTimer.hpp"
+#include "Systems/DelayedCallbacks.hpp"
 #include "Systems/LogSystem.hpp"
 #include "Systems/EventSystem/EventCollision.hpp"
+#include "Systems/SnapshotWriter.hpp"
+#include "Systems/SnapshotReader.hpp"
+#include <cassert>
 
 
 namespace Asteroid
@@ -17,7 +21,7 @@ namespace Asteroid
 
 	PlayerCollisionComponent::PlayerCollisionComponent()
 	{
-		m_alreadyRegisteredCollisionEntityIDs.reserve(128U);
+
 	}
 
 
@@ -38,16 +42,13 @@ namespace Asteroid
 
 	}
 
-	bool PlayerCollisionComponent::Update(UpdateComponents& l_updateContext)
-	{
-		return true;
-	}
 
 
-
-	void PlayerCollisionComponent::SetAlreadyRegisteredCollisionIDs(const std::vector<std::pair<uint32_t, bool>>& l_registeredCollisions)
+	void PlayerCollisionComponent::AllowCollisionAgain(const uint32_t l_collidedEntityID)
 	{
-		m_alreadyRegisteredCollisionEntityIDs = l_registeredCollisions;
+		assert(l_collidedEntityID < m_maxNumEntities);
+
+		m_collisionBlockedEntityIDs.reset(l_collidedEntityID);
 	}
 
 
@@ -75,55 +76,43 @@ namespace Asteroid
 
 		if (EntityType::ASTEROID == lv_entityItCollidedWith->GetType()) {
 
+			assert(lv_collidedEntityID < m_maxNumEntities);
 
-			for (uint32_t i = 0; i < m_alreadyRegisteredCollisionEntityIDs.size(); ++i) {
-
-				if (lv_collidedEntityID == m_alreadyRegisteredCollisionEntityIDs[i].first) {
-					if (true == m_alreadyRegisteredCollisionEntityIDs[i].second) {
-
-						m_attribComponent->DecrementHPByOne();
-						
-						m_alreadyRegisteredCollisionEntityIDs[i].second = false;
-
-						DelayedSetStateCallback lv_delayedCallback
-						{
-							.m_callback{[&, i]() {m_alreadyRegisteredCollisionEntityIDs[i].second = true; }},
-							.m_maxNumFrames = m_frameTimeToFlushRegisteredCollisionIDs
-						};
-
-						lv_collisionEvent->m_callbackTimer->AddSetStateCallback(std::move(lv_delayedCallback));
-
-						return;
-					}
-					else {
-						return;
-					}
-				}
-
+			//An asteroid only hurts the player once until enough frames have passed.
+			if (true == m_collisionBlockedEntityIDs.test(lv_collidedEntityID)) {
+				return;
 			}
 
 			m_attribComponent->DecrementHPByOne();
+			m_collisionBlockedEntityIDs.set(lv_collidedEntityID);
 
-			m_alreadyRegisteredCollisionEntityIDs.push_back(std::pair<uint32_t, bool>(lv_collidedEntityID, false));
-
-			auto lv_size = m_alreadyRegisteredCollisionEntityIDs.size();
-
-			DelayedSetStateCallback lv_delayedCallback
+			DelayedCallbackDescriptor lv_descriptor
 			{
-				.m_callback{[&, lv_size]() {m_alreadyRegisteredCollisionEntityIDs[lv_size - 1].second = true; }},
-				.m_maxNumFrames = m_frameTimeToFlushRegisteredCollisionIDs
+				.m_type = DelayedCallbackType::ALLOW_PLAYER_COLLISION_AGAIN,
+				.m_entityID = lv_ownerEntity->GetID(),
+				.m_entityGeneration = lv_ownerEntity->GetGeneration(),
+				.m_argument = lv_collidedEntityID
 			};
 
-			lv_collisionEvent->m_callbackTimer->AddSetStateCallback(std::move(lv_delayedCallback));
+			lv_collisionEvent->m_callbackTimer->AddSetStateCallback(DelayedCallbacks::Create(lv_collisionEvent->GetEntities(), lv_descriptor, m_frameTimeToFlushRegisteredCollisionIDs));
 
 		}
 
 	}
 
 
-	std::vector<std::pair<uint32_t, bool>> PlayerCollisionComponent::GetAlreadyRegisteredCollisionIDs() const
+	void PlayerCollisionComponent::Snapshot(SnapshotWriter& l_writer) const
 	{
-		return m_alreadyRegisteredCollisionEntityIDs;
+		CollisionComponent::Snapshot(l_writer);
+
+		l_writer.Write(m_collisionBlockedEntityIDs);
+	}
+
+	void PlayerCollisionComponent::Restore(SnapshotReader& l_reader)
+	{
+		CollisionComponent::Restore(l_reader);
+
+		l_reader.Read(m_collisionBlockedEntityIDs);
 	}
 
 }
\ No newline at end of file
@@ -3,12 +3,17 @@
 
 
 #include "Components/IndefiniteRepeatableAnimationComponent.hpp"
+#include "Systems/SnapshotWriter.hpp"
+#include "Systems/SnapshotReader.hpp"
+#include "Systems/TimeRewind/IndefiniteRepeatAnimationMetaData.hpp"
 #include "Components/UpdateComponents.hpp"
 #include "Components/MovementComponent.hpp"
 #include "Components/StateComponents/ActiveBasedStateComponent.hpp"
 #include "Components/AnimationMetaData.hpp"
 #include "Systems/RenderingData.hpp"
 #include "Engine.hpp"
+#include "Entities/ArchetypeTable.hpp"
+#include "Systems/SystemAccess.hpp"
 
 namespace Asteroid
 {
@@ -18,6 +23,8 @@ namespace Asteroid
 
 
 	void IndefiniteRepeatableAnimationComponent::Init(const EntityHandle l_entityHandle
+		, ArchetypeTable& l_archetype
+		, const uint32_t l_archetypeRow
 		, const AnimationMetaData* l_animationMetaData
 		, const MovementComponent* l_movementComponent
 		, ActiveBasedStateComponent* l_activeStateComponent
@@ -27,6 +34,8 @@ namespace Asteroid
 	{
 		Component::Init(l_entityHandle);
 
+		m_archetype = &l_archetype;
+		m_archetypeRow = l_archetypeRow;
 		m_animationMetaData = l_animationMetaData;
 		m_movementComponent = l_movementComponent;
 		m_activeStateComponent = l_activeStateComponent;
@@ -57,7 +66,8 @@ namespace Asteroid
 
 	uint32_t IndefiniteRepeatableAnimationComponent::GetCurrentOffset() const
 	{
-		return m_currentOffset;
+		SystemAccessCheck::OnRead(m_archetype->m_type, EntityData::ANIMATION_OFFSETS);
+		return m_archetype->m_animationOffsets[m_archetypeRow];
 	}
 
 
@@ -66,8 +76,7 @@ namespace Asteroid
 
 		const auto& lv_entity = l_updateContext.m_engine->GetEntityFromHandle(m_ownerEntityHandle);
 
-		glm::ivec2 lv_currentWindowSize{};
-		l_updateContext.m_engine->GetCurrentWindowSize(lv_currentWindowSize);
+		const glm::ivec2& lv_currentWindowSize = l_updateContext.m_windowSize;
 
 		glm::ivec2 lv_entityDimensions{
 		m_animationMetaData->m_widthToRenderTextures
@@ -100,7 +109,6 @@ namespace Asteroid
 			}
 
 
-			auto* lv_renderer = l_updateContext.m_engine->GetRenderer();
 			const float lv_rotationAngleDegrees = m_movementComponent->GetCurrentAngleOfRotation();
 
 			RenderSystem::RenderingData lv_renderData{};
@@ -108,18 +116,21 @@ namespace Asteroid
 			lv_renderData.m_heightToRender = m_animationMetaData->m_heightToRenderTextures;
 			lv_renderData.m_centerOfRotation = glm::vec2{ (float)lv_renderData.m_widthToRender / 2.f, (float)lv_renderData.m_heightToRender / 2.f };
 			lv_renderData.m_entityPos = lv_currentPos - lv_renderData.m_centerOfRotation;
-			lv_renderData.m_entityTextureHandle = m_animationMetaData->m_firstTextureIndex + m_currentOffset;
+			SystemAccessCheck::OnWrite(m_archetype->m_type, EntityData::ANIMATION_OFFSETS);
+			uint32_t& lv_currentOffset = m_archetype->m_animationOffsets[m_archetypeRow];
+
+			lv_renderData.m_entityTextureHandle = m_animationMetaData->m_firstTextureIndex + lv_currentOffset;
 			lv_renderData.m_angleOfRotation = lv_rotationAngleDegrees;
 			lv_renderData.m_centerOfRotation = glm::vec2{ (float)lv_renderData.m_widthToRender / 2.f, (float)lv_renderData.m_heightToRender / 2.f };
 
-			if (false == lv_renderer->RenderEntity(lv_renderData)) {
-				return false;
+			if (false == l_updateContext.m_skipRendering) {
+				l_updateContext.m_engine->GetRenderQueue().Submit(m_ownerEntityHandle.m_entityHandle, m_componentType, lv_renderData);
 			}
 
 
 
-			m_currentOffset += 1U;
-			m_currentOffset = m_currentOffset % m_animationMetaData->m_totalNumFrames;
+			lv_currentOffset += 1U;
+			lv_currentOffset = lv_currentOffset % m_animationMetaData->m_totalNumFrames;
 
 		}
 		
@@ -136,7 +147,8 @@ namespace Asteroid
 
 	void IndefiniteRepeatableAnimationComponent::SetCurrentOffset(const uint32_t l_newOffset)
 	{
-		m_currentOffset = l_newOffset;
+		SystemAccessCheck::OnWrite(m_archetype->m_type, EntityData::ANIMATION_OFFSETS);
+		m_archetype->m_animationOffsets[m_archetypeRow] = l_newOffset;
 	}
 	void IndefiniteRepeatableAnimationComponent::SetWindowsBound(const bool l_windowsBound)
 	{
@@ -153,4 +165,25 @@ namespace Asteroid
 		return m_frameCountToDeactivateVisibility;
 	}
 
+
+	void IndefiniteRepeatableAnimationComponent::Snapshot(SnapshotWriter& l_writer) const
+	{
+		l_writer.Write(IndefiniteRepeatAnimationMetaData
+			{
+				.m_currentOffset = GetCurrentOffset(),
+				.m_isVisible = m_isVisible,
+				.m_isInWindowBounds = m_isInWindowBound
+			});
+	}
+
+	void IndefiniteRepeatableAnimationComponent::Restore(SnapshotReader& l_reader)
+	{
+		IndefiniteRepeatAnimationMetaData lv_animMetaData{};
+		l_reader.Read(lv_animMetaData);
+
+		SetCurrentOffset(lv_animMetaData.m_currentOffset);
+		m_isVisible = lv_animMetaData.m_isVisible;
+		m_isInWindowBound = lv_animMetaData.m_isInWindowBounds;
+	}
+
 }
\ No newline at end of file
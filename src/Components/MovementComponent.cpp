@@ -3,6 +3,11 @@
 
 
 #include "Components/MovementComponent.hpp"
+#include "Systems/SnapshotWriter.hpp"
+#include "Systems/SnapshotReader.hpp"
+#include "Systems/TimeRewind/MovementMetaData.hpp"
+#include "Entities/ArchetypeTable.hpp"
+#include "Systems/SystemAccess.hpp"
 #include <gtc/matrix_transform.hpp>
 
 
@@ -15,22 +20,27 @@ namespace Asteroid
 	}
 
 
-	const glm::vec2& MovementComponent::GetSpeed() const
+	float MovementComponent::GetSpeed() const
 	{
-		return m_speed;
+		SystemAccessCheck::OnRead(m_archetype->m_type, EntityData::SPEEDS);
+		return m_archetype->m_speeds[m_archetypeRow];
 	}
 
 
 
-	void MovementComponent::Init(EntityHandle l_ownerEntityHandle)
+	void MovementComponent::Init(EntityHandle l_ownerEntityHandle, ArchetypeTable& l_archetype, const uint32_t l_archetypeRow)
 	{
 		Component::Init(l_ownerEntityHandle);
+
+		m_archetype = &l_archetype;
+		m_archetypeRow = l_archetypeRow;
 	}
 
 
-	void MovementComponent::SetSpeed(const glm::vec2& l_newSpeed)
+	void MovementComponent::SetSpeed(const float l_newSpeed)
 	{
-		m_speed = l_newSpeed;
+		SystemAccessCheck::OnWrite(m_archetype->m_type, EntityData::SPEEDS);
+		m_archetype->m_speeds[m_archetypeRow] = l_newSpeed;
 	}
 
 	float MovementComponent::GetCurrentAngleOfRotation() const
@@ -46,11 +56,33 @@ namespace Asteroid
 
 	bool MovementComponent::GetPauseState() const
 	{
-		return m_pauseMovement;
+		return m_archetype->HasFlag(m_archetypeRow, ArchetypeFlags::MOVEMENT_PAUSED);
 	}
 
 	void MovementComponent::SetPauseState(const bool l_pauseState)
 	{
-		m_pauseMovement = l_pauseState;
+		m_archetype->SetFlag(m_archetypeRow, ArchetypeFlags::MOVEMENT_PAUSED, l_pauseState);
+	}
+
+
+	void MovementComponent::Snapshot(SnapshotWriter& l_writer) const
+	{
+		l_writer.Write(MovementMetaData
+			{
+				.m_speed = GetSpeed(),
+				.m_thetaDegrees = m_thetaDegrees,
+				.m_pauseMovement = GetPauseState()
+			});
 	}
+
+	void MovementComponent::Restore(SnapshotReader& l_reader)
+	{
+		MovementMetaData lv_movementMetaData{};
+		l_reader.Read(lv_movementMetaData);
+
+		SetSpeed(lv_movementMetaData.m_speed);
+		m_thetaDegrees = lv_movementMetaData.m_thetaDegrees;
+		SetPauseState(lv_movementMetaData.m_pauseMovement);
+	}
+
 }
\ No newline at end of file
@@ -17,11 +17,6 @@ namespace Asteroid
 
 
 
-	void UserInputBasedMovementComponent::Init(EntityHandle l_ownerEntityHandle)
-	{
-		Component::Init(l_ownerEntityHandle);
-	}
-
 	bool UserInputBasedMovementComponent::Update(UpdateComponents& l_updateContext)
 	{
 		auto& lv_ownerEntity = l_updateContext.m_engine->GetEntityFromHandle(m_ownerEntityHandle);
@@ -5,6 +5,9 @@
 
 
 #include "Components/OnceRepeatableAnimationComponent.hpp"
+#include "Systems/SnapshotWriter.hpp"
+#include "Systems/SnapshotReader.hpp"
+#include "Systems/TimeRewind/OnceRepeatAnimationMetaData.hpp"
 #include "Components/UpdateComponents.hpp"
 #include "Components/MovementComponent.hpp"
 #include "Components/AnimationMetaData.hpp"
@@ -26,12 +29,14 @@ namespace Asteroid
 
 
 	void OnceRepeatableAnimationComponent::Init(const EntityHandle l_entityHandle
+		, const ComponentTypes l_componentSlot
 		, const AnimationMetaData* l_animationMetaData
 		, const MovementComponent* l_movementComponent
 		, const bool l_followEntity)
 	{
 		Component::Init(l_entityHandle);
 
+		m_componentSlot = l_componentSlot;
 		m_animationMetaData = l_animationMetaData;
 		m_movementComponent = l_movementComponent;
 		m_followEntity = l_followEntity;
@@ -71,7 +76,6 @@ namespace Asteroid
 				m_initialEntityPos = lv_ownerEntity.GetCurrentPos();
 			}
 
-			auto* lv_renderer = l_updateContext.m_engine->GetRenderer();
 			const float lv_rotationAngleDegrees = m_movementComponent->GetCurrentAngleOfRotation();
 			const auto& lv_currentPos = lv_ownerEntity.GetCurrentPos();
 
@@ -86,9 +90,8 @@ namespace Asteroid
 
 			LOG(Severity::INFO, Channel::PROGRAM_LOGIC, "animation frame %u.", m_currentOffset);
 
-			if (false == lv_renderer->RenderEntity(lv_renderData)) {
-
-				return false;
+			if (false == l_updateContext.m_skipRendering) {
+				l_updateContext.m_engine->GetRenderQueue().Submit(m_ownerEntityHandle.m_entityHandle, m_componentSlot, lv_renderData);
 			}
 
 
@@ -140,4 +143,25 @@ namespace Asteroid
 		return m_animationMetaData;
 	}
 
+
+	void OnceRepeatableAnimationComponent::Snapshot(SnapshotWriter& l_writer) const
+	{
+		l_writer.Write(OnceRepeatAnimationMetaData
+			{
+				.m_initialPos = m_initialEntityPos,
+				.m_currentOffset = m_currentOffset,
+				.m_startAnimation = m_startAnimation
+			});
+	}
+
+	void OnceRepeatableAnimationComponent::Restore(SnapshotReader& l_reader)
+	{
+		OnceRepeatAnimationMetaData lv_animMetaData{};
+		l_reader.Read(lv_animMetaData);
+
+		m_initialEntityPos = lv_animMetaData.m_initialPos;
+		m_currentOffset = lv_animMetaData.m_currentOffset;
+		m_startAnimation = lv_animMetaData.m_startAnimation;
+	}
+
 }
\ No newline at end of file
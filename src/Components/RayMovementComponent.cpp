@@ -3,8 +3,11 @@
 
 
 #include "Components/RayMovementComponent.hpp"
-#include "Engine.hpp"
-#include "Components/UpdateComponents.hpp"
+#include "Systems/SnapshotWriter.hpp"
+#include "Systems/SnapshotReader.hpp"
+#include "Systems/TimeRewind/MovementMetaData.hpp"
+#include "Entities/ArchetypeTable.hpp"
+#include "Systems/SystemAccess.hpp"
 
 
 namespace Asteroid
@@ -15,52 +18,59 @@ namespace Asteroid
 
 	}
 
-	void RayMovementComponent::Init(EntityHandle l_ownerEntityHandle)
-	{
-		m_ownerEntityHandle = l_ownerEntityHandle;
-	}
-
 	void RayMovementComponent::SetInitialPos(const glm::vec2& l_initialPos)
 	{
 		m_initialPos = l_initialPos;
 	}
 	void RayMovementComponent::SetRayDirection(const glm::vec2& l_direction)
 	{
-		m_rayDirection = l_direction;
+		SystemAccessCheck::OnWrite(m_archetype->m_type, EntityData::RAY_DIRECTIONS);
+		m_archetype->m_rayDirections[m_archetypeRow] = l_direction;
 	}
 	void RayMovementComponent::SetInitialT(const float l_initialT)
 	{
 		m_initialT = l_initialT;
 	}
 
-	bool RayMovementComponent::Update(UpdateComponents& l_updateContext)
-	{
-
-		if (false == m_pauseMovement) {
-			auto& lv_ownerEntity = l_updateContext.m_engine->GetEntityFromHandle(m_ownerEntityHandle);
-
-			const auto& lv_currentPos = lv_ownerEntity.GetCurrentPos();
-
-			const glm::vec2 lv_newPos = lv_currentPos + (m_speed.x * l_updateContext.m_deltaTime)*m_rayDirection;
-
-			lv_ownerEntity.SetCurrentPos(lv_newPos);
-
-		}
-
-		return true;
-	}
-
 	const glm::vec2& RayMovementComponent::GetInitialPos() const
 	{
 		return m_initialPos;
 	}
 	const glm::vec2& RayMovementComponent::GetRayDirection() const
 	{
-		return m_rayDirection;
+		SystemAccessCheck::OnRead(m_archetype->m_type, EntityData::RAY_DIRECTIONS);
+		return m_archetype->m_rayDirections[m_archetypeRow];
 	}
 	float RayMovementComponent::GetInitalT() const
 	{
 		return m_initialT;
 	}
 
+
+	void RayMovementComponent::Snapshot(SnapshotWriter& l_writer) const
+	{
+		l_writer.Write(MovementMetaData
+			{
+				.m_speed = GetSpeed(),
+				.m_initialPos = m_initialPos,
+				.m_rayDirection = GetRayDirection(),
+				.m_initialT = m_initialT,
+				.m_thetaDegrees = m_thetaDegrees,
+				.m_pauseMovement = GetPauseState()
+			});
+	}
+
+	void RayMovementComponent::Restore(SnapshotReader& l_reader)
+	{
+		MovementMetaData lv_movementMetaData{};
+		l_reader.Read(lv_movementMetaData);
+
+		SetSpeed(lv_movementMetaData.m_speed);
+		m_initialPos = lv_movementMetaData.m_initialPos;
+		SetRayDirection(lv_movementMetaData.m_rayDirection);
+		m_initialT = lv_movementMetaData.m_initialT;
+		m_thetaDegrees = lv_movementMetaData.m_thetaDegrees;
+		SetPauseState(lv_movementMetaData.m_pauseMovement);
+	}
+
 }
\ No newline at end of file
@@ -5,6 +5,9 @@
 
 
 #include "Components/StateComponents/ActiveBasedStateComponent.hpp"
+#include "Systems/SnapshotWriter.hpp"
+#include "Systems/SnapshotReader.hpp"
+#include "Systems/TimeRewind/ActiveBasedStateMetaData.hpp"
 #include "Components/IndefiniteRepeatableAnimationComponent.hpp"
 #include "Components/CollisionComponent.hpp"
 #include "Components/UpdateComponents.hpp"
@@ -78,4 +81,18 @@ namespace Asteroid
 		m_delayedActivateCallbackAlreadySet = false;
 	}
 
+
+	void ActiveBasedStateComponent::Snapshot(SnapshotWriter& l_writer) const
+	{
+		l_writer.Write(ActiveBasedStateMetaData{ .m_delayedActivateCallbackAlreadySet = m_delayedActivateCallbackAlreadySet });
+	}
+
+	void ActiveBasedStateComponent::Restore(SnapshotReader& l_reader)
+	{
+		ActiveBasedStateMetaData lv_activeMetaData{};
+		l_reader.Read(lv_activeMetaData);
+
+		m_delayedActivateCallbackAlreadySet = lv_activeMetaData.m_delayedActivateCallbackAlreadySet;
+	}
+
 }
\ No newline at end of file
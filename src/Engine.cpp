@@ -15,7 +15,12 @@
 #include "Systems/Colors.hpp"
 #include "Systems/RenderingData.hpp"
 #include "Components/UpdateComponents.hpp"
+#include "Systems/SnapshotWriter.hpp"
+#include "Systems/SnapshotReader.hpp"
 #include "Systems/LogSystem.hpp"
+#include "Utilities/Check.hpp"
+#include "Systems/AllocationTracker.hpp"
+#include "Systems/MovementSystem.hpp"
 #include <imgui.h>
 #include <imgui_internal.h>
 #include <backends/imgui_impl_sdl3.h>
@@ -23,6 +28,9 @@
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_time.h>
 #include <memory>
+#include <array>
+#include <utility>
+#include <cstdio>
 
 namespace Asteroid
 {
@@ -45,6 +53,11 @@ namespace Asteroid
 		using namespace LogSystem;
 		LOG(Severity::INFO, Channel::INITIALIZATION, "****Engine initialization has begun****\n");
 
+		if (0U != m_initialData.m_totalNumAllocationCheckFrames) {
+			AllocationTracker::InstallLibraryHooks();
+			AllocationTracker::Enable(m_initialData.m_totalNumAllocationWarmUpFrames);
+		}
+
 		if (false == SDL_SetAppMetadata(m_initialData.m_appName.c_str()
 			, m_initialData.m_appVersion.c_str(), nullptr)) {
 
@@ -104,12 +117,55 @@ namespace Asteroid
 
 		Set_Verbosity(Severity::WARNING);
 
+		m_jobSystem.Init(m_initialData.m_totalNumJobWorkers, m_initialData.m_pinJobWorkersToCores);
+		m_jobSystemStatsPanel.Init(m_jobSystem);
+
 		InitEntitiesAndPools();
+		InitSystems();
 
 		glm::ivec2 lv_fullWindowSize{};
 		GetCurrentWindowSize(lv_fullWindowSize);
 		m_grid.Init(lv_fullWindowSize);
 
+		//Only quicksaves are taken for now, so a small budget for the undo records is enough.
+		m_componentSnapshots.Init(m_allocator, 4U * 1024U * 1024U);
+
+		m_frameArena.Init(64U * 1024U);
+
+		//Pool slabs are already faulted in when they are set up, so locking them costs nothing at runtime.
+		if (true == m_initialData.m_lockAllocatorMemory) {
+			m_allocator.LockPoolMemory();
+			m_containerAllocator.LockPoolMemory();
+		}
+
+		m_allocatorStatsPanel.Init(m_initialData.m_allocatorStatsFilePath, m_initialData.m_allocatorStatsDumpIntervalInSeconds);
+		m_allocatorStatsPanel.AddAllocator("Components", m_allocator);
+		m_allocatorStatsPanel.AddAllocator("Containers", m_containerAllocator);
+
+		//Every level starts from this state, which makes restarting a level a single load.
+		if (false == GameSave::Capture(m_entities, m_callbacksTimer, m_entitySpawnerFromPools, GameSaveLevelState{ .m_level = 1U }, m_levelStartSave)) {
+			LOG(Severity::FAILURE, Channel::INITIALIZATION, "Failed to save the state levels start from.");
+			throw std::runtime_error("Failed to save the state levels start from.");
+		}
+
+		const auto& lv_timeRewindInitData = m_initialData.m_timeRewindInitData;
+
+		//Replays are input logs, so playing one back needs the input replay mode.
+		m_timeRewindMode = (true == lv_timeRewindInitData.m_replayToPlayPath.empty()) ? lv_timeRewindInitData.m_mode : TimeRewindMode::INPUT_REPLAY;
+
+		if (TimeRewindMode::INPUT_REPLAY == m_timeRewindMode) {
+
+			m_inputReplayLog.Init(lv_timeRewindInitData.m_framesBetweenReplayKeyframes);
+
+			if (false == lv_timeRewindInitData.m_replayToPlayPath.empty()) {
+				m_isPlayingReplay = m_inputReplayLog.LoadFromFile(lv_timeRewindInitData.m_replayToPlayPath, m_entities, m_entitySpawnerFromPools);
+				m_replayFrameIndex = 0U;
+			}
+		}
+		else if (false == m_timeRewind.Init(lv_timeRewindInitData)) {
+			LOG(Severity::WARNING, Channel::INITIALIZATION, "Time rewind history is limited to the memory budget.");
+		}
+
 		LOG(Severity::INFO, Channel::INITIALIZATION, "Initializing entities was successful.");
 
 
@@ -158,10 +214,23 @@ namespace Asteroid
 		bool lv_isPlayerAlive = true;
 		bool lv_timeRewinded{ false };
 
+		constexpr uint32_t lv_rewindSpeeds[] = { 1U, 2U, 4U, 8U };
+		int lv_rewindSpeedIndex{};
+		float lv_scrubTime{};
+		bool lv_isScrubbing{ false };
+		bool lv_commitScrub{ false };
+
+		//Set by the callback that moves on to the next level once the level cleared message has been shown.
+		uint32_t lv_levelToStart{};
+
 		while (false == lv_quit) {
 
 			m_trackLastFrameElapsedTime.m_currentTime = SDL_GetTicks();
 
+			AllocationTracker::BeginFrame();
+
+			m_frameArena.SwapAndReset();
+
 			m_inputSystem.FlushNotAllowedRepetitionKeys();
 
 			SDL_Event lv_event;
@@ -191,7 +260,9 @@ namespace Asteroid
 			}
 
 
-			assert(true == m_renderer.ClearWindow());
+			AllocationTracker::SetPhase(AllocationTracker::LoopPhase::RENDERING);
+
+			ASTEROID_CHECK(true == m_renderer.ClearWindow());
 			GetCurrentWindowSize(lv_currentWindowSize);
 
 			lv_backgroundStarsRenderData.m_heightToRender = lv_currentWindowSize.y;
@@ -219,42 +290,75 @@ namespace Asteroid
 			bool lv_loopOverInThisLevel = ((m_timeSinceStartInSeconds <= lv_totalSecondsFirstLevel && 1U == m_currentLevel)
 				|| (m_timeSinceStartInSeconds <= lv_totalSecondsSecondLevel && 2U == m_currentLevel)) && true == lv_isPlayerAlive;
 
-			if (true == lv_loopOverInThisLevel) {
-				if (true == m_inputSystem.IsRepetitionAllowedKeyPressed(InputSystem::Keys::KEY_T) && false == m_inputSystem.IsKeyUp(InputSystem::Keys::KEY_T)) {
-					m_timeRewind.RewindTimeByOneFrame(m_entities, m_inputSystem,m_timeSinceStartInSeconds, lv_updateComponent.m_totalNumAsteroidsHitByBullets, m_callbacksTimer);
+			AllocationTracker::SetPhase(AllocationTracker::LoopPhase::SIMULATION);
+
+			if (true == lv_loopOverInThisLevel && true == m_inputSystem.IsNoRepetitionAllowedKeyPressed(InputSystem::Keys::KEY_F5)) {
+				TakeQuickSave(lv_updateComponent);
+				SaveGameToFile(lv_updateComponent);
+			}
+			else if (true == lv_loopOverInThisLevel && true == m_inputSystem.IsNoRepetitionAllowedKeyPressed(InputSystem::Keys::KEY_F9)) {
+				//The file is only needed once the quicksave in memory is gone, e.g. after the game was restarted.
+				if (false == LoadQuickSave(lv_updateComponent)) {
+					LoadGameFromFile(lv_updateComponent);
+				}
+			}
+
+			InputFrame lv_inputFrame{};
+
+			if (true == lv_loopOverInThisLevel && TimeRewindMode::INPUT_REPLAY == m_timeRewindMode) {
+				lv_timeRewinded = UpdateInputReplay(lv_updateComponent, lv_inputFrame, lv_currentWindowSize
+					, lv_scrubTime, lv_isScrubbing, lv_commitScrub, lv_rewindSpeeds[lv_rewindSpeedIndex]);
+				lv_commitScrub = false;
+			}
+			else if (true == lv_loopOverInThisLevel) {
+				//While the timeline slider is dragged the game only previews the frame. Releasing it
+				//makes the previewed frame the present and drops everything after it.
+				if (true == lv_isScrubbing || true == lv_commitScrub) {
+					m_timeRewind.SeekToTime(lv_scrubTime, lv_commitScrub, m_entities, m_archetypes, m_inputSystem, m_timeSinceStartInSeconds, lv_updateComponent.m_totalNumAsteroidsHitByBullets, m_callbacksTimer);
+					lv_commitScrub = false;
+					lv_timeRewinded = true;
+				}
+				else if (true == m_inputSystem.IsRepetitionAllowedKeyPressed(InputSystem::Keys::KEY_T) && false == m_inputSystem.IsKeyUp(InputSystem::Keys::KEY_T)) {
+					m_timeRewind.RewindTimeByFrames(lv_rewindSpeeds[lv_rewindSpeedIndex], m_entities, m_archetypes, m_inputSystem,m_timeSinceStartInSeconds, lv_updateComponent.m_totalNumAsteroidsHitByBullets, m_callbacksTimer);
 					lv_timeRewinded = true;
 				}
 				else {
-					m_timeRewind.Update(m_entities, m_inputSystem,m_timeSinceStartInSeconds, lv_updateComponent.m_totalNumAsteroidsHitByBullets, m_callbacksTimer.GetDelayedCallbacks());
+					m_timeRewind.Update(m_entities, m_archetypes, m_inputSystem,m_timeSinceStartInSeconds, lv_updateComponent.m_totalNumAsteroidsHitByBullets, m_callbacksTimer);
 					lv_timeRewinded = false;
 				}
 			}
 			else {
 				lv_timeRewinded = false;
 			}
+
+			//Rewinding writes components of entities that may be inactive now.
+			if (true == lv_timeRewinded) {
+				m_allocator.MarkAllDirty();
+			}
+
+			if (TimeRewindMode::INPUT_REPLAY != m_timeRewindMode || false == lv_loopOverInThisLevel) {
+				FillInputFrame(lv_inputFrame, lv_currentWindowSize, lv_timeRewinded);
+			}
 			
 			
 			m_callbacksTimer.Update();
-			auto* lv_playerAttribComp = (PlayerAttributeComponent*)m_entities[m_playerEntityHandle].GetComponent(ComponentTypes::ATTRIBUTE);
+
+			if (0U != lv_levelToStart) {
+				RestartLevel(lv_updateComponent, lv_levelToStart);
+				lv_levelToStart = 0U;
+			}
+
+			auto* lv_playerAttribComp = m_entities[m_playerEntityHandle].Get<PlayerAttributeComponent>();
 			lv_isPlayerAlive = (0U == lv_playerAttribComp->GetHp()) ? false : true;
 			LOG(Severity::INFO, Channel::PROGRAM_LOGIC, "HP: %u", lv_playerAttribComp->GetHp());
 			if (true == lv_loopOverInThisLevel) {
 
-				m_grid.Update(lv_currentWindowSize, m_circleBoundsEntities, m_entities);
-				m_grid.DoCollisionDetection(m_circleBoundsEntities, m_entities, m_callbacksTimer, m_eventManager, m_allocator);
-				m_entitySpawnerFromPools.SpawnNewEntitiesIfConditionsMet(m_currentLevel, lv_timeRewinded);
-				lv_updateComponent.m_deltaTime = (float)m_trackLastFrameElapsedTime.m_lastFrameElapsedTime;
-				for (auto& l_entity : m_entities) {
-					if (true == l_entity.GetActiveState()) {
-						assert(l_entity.Update(lv_updateComponent));
-					}
-				}
-				m_eventManager.Update(m_allocator);
-				m_entitySpawnerFromPools.UpdatePools();
-				UpdateCircleBounds();
+				SimulateFrame(lv_updateComponent, lv_inputFrame);
+
 
 
 
+				AllocationTracker::SetPhase(AllocationTracker::LoopPhase::UI);
 
 				ImGui_ImplSDLRenderer3_NewFrame();
 				ImGui_ImplSDL3_NewFrame();
@@ -272,11 +376,40 @@ namespace Asteroid
 
 					ImGui::End();
 				}
+
+				{
+					ImGui::Begin("Time Rewind");
+
+					const char* lv_speedNames[] = { "1x", "2x", "4x", "8x" };
+					ImGui::Combo("Speed", &lv_rewindSpeedIndex, lv_speedNames, IM_ARRAYSIZE(lv_speedNames));
+
+					float lv_oldestTime{};
+					float lv_newestTime{};
+
+					if (TimeRewindMode::INPUT_REPLAY == m_timeRewindMode) {
+						m_inputReplayLog.GetTimelineRange(lv_oldestTime, lv_newestTime);
+					}
+					else {
+						m_timeRewind.GetTimelineRange(lv_oldestTime, lv_newestTime);
+					}
+
+					if (false == lv_isScrubbing) {
+						lv_scrubTime = m_timeSinceStartInSeconds;
+					}
+
+					ImGui::SliderFloat("Timeline", &lv_scrubTime, lv_oldestTime, lv_newestTime, "%.2f s");
+					lv_isScrubbing = ImGui::IsItemActive();
+					lv_commitScrub = ImGui::IsItemDeactivated();
+
+					ImGui::End();
+				}
 			}
 			else {
 				
 				m_eventManager.FlushAllEventQueues(m_allocator);
 
+				AllocationTracker::SetPhase(AllocationTracker::LoopPhase::UI);
+
 				ImGui_ImplSDLRenderer3_NewFrame();
 				ImGui_ImplSDL3_NewFrame();
 				ImGui::NewFrame();
@@ -297,32 +430,13 @@ namespace Asteroid
 						if (false == lv_enteredThisLoop) {
 
 							m_callbacksTimer.FlushAllCallbacks();
-							for (uint32_t i = m_playerEntityHandle + 1; i < (uint32_t)m_entities.size(); ++i) {
-
-								if (EntityType::CURSOR != m_entities[i].GetType()) {
-									m_entities[i].SetActiveState(false);
-								}
-
-								if (EntityType::ASTEROID == m_entities[i].GetType()) {
-									auto* lv_asteroidExp = (OnceRepeatableAnimationComponent*)m_entities[i].GetComponent(ComponentTypes::EXPLOSION_FIRE_ASTEROID_ANIMATION);
-									auto* lv_asteroidWarp = (OnceRepeatableAnimationComponent*)m_entities[i].GetComponent(ComponentTypes::WARP_ASTEROID_ANIMATION);
-
-									lv_asteroidWarp->Reset();
-									lv_asteroidExp->Reset();
-								}
-
-							}
-							m_entitySpawnerFromPools.ResetPools();
-							m_timeRewind.Flush();
-							lv_playerAttribComp->ResetHealth();
+							FlushTimeRewind();
 
 							DelayedSetStateCallback lv_exitCallback
 							{
 								.m_callback{[&]() 
 								{
-									m_currentLevel += 1U; 
-									m_timeSinceStartInSeconds = 0U;
-									lv_updateComponent.m_totalNumAsteroidsHitByBullets = 0U;
+									lv_levelToStart = m_currentLevel + 1U;
 									lv_enteredThisLoop = false;
 								}},
 								.m_maxNumFrames = 512U
@@ -355,32 +469,8 @@ namespace Asteroid
 
 						if (true == lv_repeat) {
 
-
-							m_callbacksTimer.FlushAllCallbacks();
-							for (uint32_t i = m_playerEntityHandle + 1; i < (uint32_t)m_entities.size(); ++i) {
-
-
-								if (EntityType::CURSOR != m_entities[i].GetType()) {
-									m_entities[i].SetActiveState(false);
-								}
-
-								if (EntityType::ASTEROID == m_entities[i].GetType()) {
-									auto* lv_asteroidExp = (OnceRepeatableAnimationComponent*)m_entities[i].GetComponent(ComponentTypes::EXPLOSION_FIRE_ASTEROID_ANIMATION);
-									auto* lv_asteroidWarp = (OnceRepeatableAnimationComponent*)m_entities[i].GetComponent(ComponentTypes::WARP_ASTEROID_ANIMATION);
-
-									lv_asteroidWarp->Reset();
-									lv_asteroidExp->Reset();
-								}
-
-							}
-							m_timeRewind.Flush();
-
-							m_entitySpawnerFromPools.ResetPools();
-							m_timeSinceStartInSeconds = 0.f;
-							lv_updateComponent.m_totalNumAsteroidsHitByBullets = 0U;
+							RestartLevel(lv_updateComponent, 1U);
 							lv_isPlayerAlive = true;
-							lv_playerAttribComp->ResetHealth();
-
 
 							lv_repeat = false;
 							lv_exit = false;
@@ -423,31 +513,8 @@ namespace Asteroid
 
 						if (true == lv_repeat3) {
 
-							m_callbacksTimer.FlushAllCallbacks();
-							for (uint32_t i = m_playerEntityHandle + 1; i < (uint32_t)m_entities.size(); ++i) {
-
-								if (EntityType::CURSOR != m_entities[i].GetType()) {
-									m_entities[i].SetActiveState(false);
-								}
-
-								if (EntityType::ASTEROID == m_entities[i].GetType()) {
-									auto* lv_asteroidExp = (OnceRepeatableAnimationComponent*)m_entities[i].GetComponent(ComponentTypes::EXPLOSION_FIRE_ASTEROID_ANIMATION);
-									auto* lv_asteroidWarp = (OnceRepeatableAnimationComponent*)m_entities[i].GetComponent(ComponentTypes::WARP_ASTEROID_ANIMATION);
-
-									lv_asteroidWarp->Reset();
-									lv_asteroidExp->Reset();
-								}
-
-							}
-							m_timeRewind.Flush();
-
-							m_entitySpawnerFromPools.ResetPools();
-							m_timeSinceStartInSeconds = 0.f;
-							lv_updateComponent.m_totalNumAsteroidsHitByBullets = 0U;
+							RestartLevel(lv_updateComponent, 1U);
 							lv_isPlayerAlive = true;
-							lv_playerAttribComp->ResetHealth();
-
-							m_currentLevel = 1U;
 
 							lv_repeat3 = false;
 
@@ -475,30 +542,8 @@ namespace Asteroid
 
 						if (true == lv_repeat2) {
 
-							m_callbacksTimer.FlushAllCallbacks();
-							for (uint32_t i = m_playerEntityHandle + 1; i < (uint32_t)m_entities.size(); ++i) {
-
-								if (EntityType::CURSOR != m_entities[i].GetType()) {
-									m_entities[i].SetActiveState(false);
-								}
-								
-								if (EntityType::ASTEROID == m_entities[i].GetType()) {
-									auto* lv_asteroidExp = (OnceRepeatableAnimationComponent*)m_entities[i].GetComponent(ComponentTypes::EXPLOSION_FIRE_ASTEROID_ANIMATION);
-									auto* lv_asteroidWarp = (OnceRepeatableAnimationComponent*)m_entities[i].GetComponent(ComponentTypes::WARP_ASTEROID_ANIMATION);
-
-									lv_asteroidWarp->Reset();
-									lv_asteroidExp->Reset();
-								}
-
-							}
-							m_timeRewind.Flush();
-
-							m_entitySpawnerFromPools.ResetPools();
-							m_timeSinceStartInSeconds = 0.f;
-							lv_updateComponent.m_totalNumAsteroidsHitByBullets = 0U;
+							RestartLevel(lv_updateComponent, 2U);
 							lv_isPlayerAlive = true;
-							lv_playerAttribComp->ResetHealth();
-
 
 							lv_repeat2 = false;
 							lv_exit2 = false;
@@ -518,9 +563,23 @@ namespace Asteroid
 			}
 
 
+			m_allocatorStatsPanel.Update((float)SDL_GetTicks() / 1000.f);
+			m_allocatorStatsPanel.Render();
+
+			m_jobSystemStatsPanel.Update((float)SDL_GetTicks() / 1000.f);
+			m_jobSystemStatsPanel.Render();
+
+			AllocationTracker::SetPhase(AllocationTracker::LoopPhase::RENDERING);
+
 			ImGui::Render();
 			ImGui_ImplSDLRenderer3_RenderDrawData(ImGui::GetDrawData(), m_renderer.GetSDLRenderer());
-			assert(true == m_renderer.PresentToWindow());
+			ASTEROID_CHECK(true == m_renderer.PresentToWindow());
+
+			AllocationTracker::EndFrame();
+
+			if (0U != m_initialData.m_totalNumAllocationCheckFrames && AllocationTracker::GetTotalNumFramesChecked() >= m_initialData.m_totalNumAllocationCheckFrames) {
+				lv_quit = true;
+			}
 
 			m_trackLastFrameElapsedTime.m_lastFrameElapsedTime = SDL_GetTicks() - m_trackLastFrameElapsedTime.m_currentTime;
 
@@ -535,11 +594,307 @@ namespace Asteroid
 			m_timeSinceStartInSeconds += ((float)m_trackLastFrameElapsedTime.m_lastFrameElapsedTime/1000.f);
 		}
 
+		FlushTimeRewind();
+
+		if (true == AllocationTracker::IsEnabled()) {
+
+			std::fprintf(stderr, "Allocation check: %llu of %llu frames allocated.\n"
+				, (unsigned long long)AllocationTracker::GetTotalNumFramesThatAllocated(), (unsigned long long)AllocationTracker::GetTotalNumFramesChecked());
+
+			return 0U == AllocationTracker::GetTotalNumFramesThatAllocated();
+		}
+
 		return true;
 
 	}
 
 
+	void Engine::SimulateFrame(UpdateComponents& l_updateComponent, const InputFrame& l_inputFrame)
+	{
+		//Entities deactivated during the frame are covered by this one and the ones
+		//activated during it by the call at the end.
+		MarkActiveEntitiesDirty();
+
+		m_grid.Update(l_inputFrame.m_windowSize, m_circleBoundsEntities, m_entities, m_archetypes, m_jobSystem);
+		m_grid.DoCollisionDetection(m_circleBoundsEntities, m_entities, m_callbacksTimer, m_eventManager, m_frameArena.GetCurrent());
+		m_entitySpawnerFromPools.SpawnNewEntitiesIfConditionsMet(m_currentLevel, l_inputFrame.m_timeRewinded);
+		l_updateComponent.m_deltaTime = l_inputFrame.m_deltaTime;
+		l_updateComponent.m_windowSize = l_inputFrame.m_windowSize;
+		ASTEROID_CHECK(true == m_systemScheduler.Run(l_updateComponent));
+		ASTEROID_CHECK(true == m_renderQueue.Flush(m_renderer));
+		m_eventManager.Update(m_allocator);
+		m_entitySpawnerFromPools.UpdatePools();
+		UpdateCircleBounds();
+
+		MarkActiveEntitiesDirty();
+	}
+
+
+	void Engine::FillInputFrame(InputFrame& l_inputFrame, const glm::ivec2& l_windowSize, const bool l_timeRewinded) const
+	{
+		m_inputSystem.GetInputFrame(l_inputFrame);
+		l_inputFrame.m_windowSize = l_windowSize;
+		l_inputFrame.m_time = m_timeSinceStartInSeconds;
+		l_inputFrame.m_deltaTime = (float)m_trackLastFrameElapsedTime.m_lastFrameElapsedTime;
+		l_inputFrame.m_timeRewinded = l_timeRewinded;
+	}
+
+
+	bool Engine::UpdateInputReplay(UpdateComponents& l_updateComponent, InputFrame& l_inputFrame, const glm::ivec2& l_windowSize
+		, const float l_scrubTime, const bool l_isScrubbing, const bool l_commitScrub, const uint32_t l_rewindSpeed)
+	{
+		if (true == m_isPlayingReplay) {
+
+			if (m_replayFrameIndex < m_inputReplayLog.GetTotalNumFrames()) {
+
+				if (0U == m_replayFrameIndex) {
+					m_currentLevel = m_inputReplayLog.GetLevel();
+					m_inputReplayLog.RestoreKeyframe(0U, m_entities, m_archetypes, m_inputSystem, m_timeSinceStartInSeconds
+						, l_updateComponent.m_totalNumAsteroidsHitByBullets, m_callbacksTimer, m_entitySpawnerFromPools);
+				}
+
+				//The recorded input replaces whatever the player is doing.
+				l_inputFrame = m_inputReplayLog.GetInputFrame(m_replayFrameIndex);
+				m_inputSystem.SetInputFrame(l_inputFrame);
+				m_timeSinceStartInSeconds = l_inputFrame.m_time;
+
+				m_inputReplayLog.CaptureKeyframeIfMissing(m_replayFrameIndex, m_entities, m_archetypes, m_inputSystem
+					, l_updateComponent.m_totalNumAsteroidsHitByBullets, m_callbacksTimer, m_entitySpawnerFromPools);
+				++m_replayFrameIndex;
+
+				return l_inputFrame.m_timeRewinded;
+			}
+
+			//The replay is over and the player carries on from where it ended.
+			m_isPlayingReplay = false;
+		}
+
+		const uint32_t lv_totalNumFrames = m_inputReplayLog.GetTotalNumFrames();
+		bool lv_timeRewinded{ false };
+
+		if (0U != lv_totalNumFrames && (true == l_isScrubbing || true == l_commitScrub)) {
+
+			const uint32_t lv_frameIndex = m_inputReplayLog.FindFrameAtTime(l_scrubTime);
+			ResimulateToFrame(lv_frameIndex, l_updateComponent);
+
+			//Nothing is recorded while previewing. The log is only cut once the slider is released.
+			if (false == l_commitScrub) {
+				FillInputFrame(l_inputFrame, l_windowSize, true);
+				return true;
+			}
+
+			m_inputReplayLog.Truncate(lv_frameIndex);
+			lv_timeRewinded = true;
+		}
+		else if (0U != lv_totalNumFrames && true == m_inputSystem.IsRepetitionAllowedKeyPressed(InputSystem::Keys::KEY_T) && false == m_inputSystem.IsKeyUp(InputSystem::Keys::KEY_T)) {
+
+			const uint32_t lv_frameIndex = (l_rewindSpeed >= lv_totalNumFrames) ? 0U : lv_totalNumFrames - l_rewindSpeed;
+			ResimulateToFrame(lv_frameIndex, l_updateComponent);
+
+			m_inputReplayLog.Truncate(lv_frameIndex);
+			lv_timeRewinded = true;
+		}
+
+		if (0U == m_inputReplayLog.GetTotalNumFrames()) {
+			m_inputReplayLog.SetLevel(m_currentLevel);
+		}
+
+		FillInputFrame(l_inputFrame, l_windowSize, lv_timeRewinded);
+		m_inputReplayLog.RecordFrame(l_inputFrame, m_entities, m_archetypes, m_inputSystem, l_updateComponent.m_totalNumAsteroidsHitByBullets, m_callbacksTimer, m_entitySpawnerFromPools);
+
+		m_callbacksTimer.ReleaseRegisteredCallbacksOlderThan(m_inputReplayLog.GetOldestReferencedCallbackID());
+
+		return lv_timeRewinded;
+	}
+
+
+	void Engine::ResimulateToFrame(const uint32_t l_frameIndex, UpdateComponents& l_updateComponent)
+	{
+		const uint32_t lv_keyframeIndex = m_inputReplayLog.RestoreKeyframe(l_frameIndex, m_entities, m_archetypes, m_inputSystem, m_timeSinceStartInSeconds
+			, l_updateComponent.m_totalNumAsteroidsHitByBullets, m_callbacksTimer, m_entitySpawnerFromPools);
+
+		l_updateComponent.m_skipRendering = true;
+
+		for (uint32_t i = lv_keyframeIndex; i < l_frameIndex; ++i) {
+
+			const auto& lv_inputFrame = m_inputReplayLog.GetInputFrame(i);
+
+			m_inputSystem.SetInputFrame(lv_inputFrame);
+			m_timeSinceStartInSeconds = lv_inputFrame.m_time;
+
+			m_callbacksTimer.Update();
+			SimulateFrame(l_updateComponent, lv_inputFrame);
+		}
+
+		l_updateComponent.m_skipRendering = false;
+
+		m_timeSinceStartInSeconds = m_inputReplayLog.GetInputFrame(l_frameIndex).m_time;
+	}
+
+
+	void Engine::FlushTimeRewind()
+	{
+		//Level resets touch inactive entities too and a quicksave never outlives its level.
+		m_quickSave.m_isValid = false;
+
+		//The thread caches are flushed without the threads owning them knowing.
+		assert(true == m_jobSystem.IsIdle());
+		m_allocator.ReleaseEmptySlabs();
+		m_componentSnapshots.Clear();
+
+		if (TimeRewindMode::STATE_SNAPSHOTS == m_timeRewindMode) {
+			m_timeRewind.Flush();
+			return;
+		}
+
+		//A replay that is being played back is already saved somewhere.
+		if (false == m_isPlayingReplay && 0U != m_inputReplayLog.GetTotalNumFrames()) {
+			m_inputReplayLog.SaveToFile(m_initialData.m_timeRewindInitData.m_replayFilePath);
+		}
+
+		m_inputReplayLog.Clear();
+		m_isPlayingReplay = false;
+	}
+
+
+	void Engine::MarkActiveEntitiesDirty()
+	{
+		m_archetypes.ForEachActiveEntity([this](const uint32_t l_entityIndex) -> void
+			{
+				m_entities[l_entityIndex].MarkComponentsDirty(m_allocator);
+			});
+	}
+
+
+	void Engine::TakeQuickSave(const UpdateComponents& l_updateComponent)
+	{
+		assert(true == m_jobSystem.IsIdle());
+		m_componentSnapshots.TakeSnapshot();
+
+		m_quickSave.m_archetypes = m_archetypes;
+
+		m_quickSave.m_entityGenerations.resize(m_entities.size());
+		for (size_t i = 0; i < m_entities.size(); ++i) {
+			m_quickSave.m_entityGenerations[i] = m_entities[i].GetGeneration();
+		}
+
+		m_callbacksTimer.CopyPendingCallbacks(m_quickSave.m_pendingCallbacks);
+
+		m_quickSave.m_spawnerPools.clear();
+		SnapshotWriter lv_writer{ m_quickSave.m_spawnerPools };
+		m_entitySpawnerFromPools.SnapshotPools(lv_writer);
+		m_quickSave.m_randomEngine = m_entitySpawnerFromPools.GetRandomEngine();
+
+		m_quickSave.m_mousePos = m_inputSystem.GetMousePosRelativeToWindow();
+		m_quickSave.m_isMouseHidden = m_inputSystem.IsMouseHidden();
+		m_quickSave.m_time = m_timeSinceStartInSeconds;
+		m_quickSave.m_totalNumAsteroidsHitByBullets = l_updateComponent.m_totalNumAsteroidsHitByBullets;
+		m_quickSave.m_level = m_currentLevel;
+		m_quickSave.m_isValid = true;
+	}
+
+
+	bool Engine::LoadQuickSave(UpdateComponents& l_updateComponent)
+	{
+		assert(true == m_jobSystem.IsIdle());
+
+		if (false == m_quickSave.m_isValid || false == m_componentSnapshots.RestoreSnapshot(0U)) {
+			return false;
+		}
+
+		m_archetypes = m_quickSave.m_archetypes;
+
+		for (size_t i = 0; i < m_entities.size(); ++i) {
+			m_entities[i].SetGeneration(m_quickSave.m_entityGenerations[i]);
+		}
+
+		m_callbacksTimer.ReplacePendingCallbacks(m_quickSave.m_pendingCallbacks);
+
+		SnapshotReader lv_reader{ m_quickSave.m_spawnerPools.data(), m_quickSave.m_spawnerPools.size() };
+		m_entitySpawnerFromPools.RestorePools(lv_reader);
+		m_entitySpawnerFromPools.SetRandomEngine(m_quickSave.m_randomEngine);
+
+		m_inputSystem.SetMousePos(m_quickSave.m_mousePos);
+		m_inputSystem.SetHiddenStateOfMouse(m_quickSave.m_isMouseHidden);
+		m_timeSinceStartInSeconds = m_quickSave.m_time;
+		l_updateComponent.m_totalNumAsteroidsHitByBullets = m_quickSave.m_totalNumAsteroidsHitByBullets;
+		m_currentLevel = m_quickSave.m_level;
+
+		DiscardRewindHistory();
+
+		return true;
+	}
+
+
+	bool Engine::SaveGameToFile(const UpdateComponents& l_updateComponent)
+	{
+		const GameSaveLevelState lv_levelState
+		{
+			.m_level = m_currentLevel,
+			.m_time = m_timeSinceStartInSeconds,
+			.m_totalNumAsteroidsHitByBullets = l_updateComponent.m_totalNumAsteroidsHitByBullets
+		};
+
+		if (false == GameSave::Capture(m_entities, m_callbacksTimer, m_entitySpawnerFromPools, lv_levelState, m_gameSave)) {
+			return false;
+		}
+
+		return GameSave::WriteToFile(m_initialData.m_quickSaveFilePath, m_gameSave);
+	}
+
+
+	bool Engine::LoadGameFromFile(UpdateComponents& l_updateComponent)
+	{
+		GameSaveLevelState lv_levelState{};
+
+		if (false == GameSave::LoadFromFile(m_initialData.m_quickSaveFilePath, m_entities, m_callbacksTimer, m_entitySpawnerFromPools, lv_levelState)) {
+			return false;
+		}
+
+		m_currentLevel = lv_levelState.m_level;
+		m_timeSinceStartInSeconds = lv_levelState.m_time;
+		l_updateComponent.m_totalNumAsteroidsHitByBullets = lv_levelState.m_totalNumAsteroidsHitByBullets;
+
+		m_allocator.MarkAllDirty();
+		DiscardRewindHistory();
+
+		return true;
+	}
+
+
+	void Engine::RestartLevel(UpdateComponents& l_updateComponent, const uint32_t l_level)
+	{
+		m_callbacksTimer.FlushAllCallbacks();
+		FlushTimeRewind();
+
+		//The random engine keeps going so a restarted level does not get the same asteroid waves as the last attempt.
+		const auto lv_randomEngine = m_entitySpawnerFromPools.GetRandomEngine();
+
+		GameSaveLevelState lv_levelState{};
+		const bool lv_restored = GameSave::Apply(m_levelStartSave.data(), m_levelStartSave.size(), m_entities, m_callbacksTimer, m_entitySpawnerFromPools, lv_levelState);
+		assert(true == lv_restored);
+		(void)lv_restored;
+
+		m_entitySpawnerFromPools.SetRandomEngine(lv_randomEngine);
+
+		m_currentLevel = l_level;
+		m_timeSinceStartInSeconds = lv_levelState.m_time;
+		l_updateComponent.m_totalNumAsteroidsHitByBullets = lv_levelState.m_totalNumAsteroidsHitByBullets;
+	}
+
+
+	void Engine::DiscardRewindHistory()
+	{
+		//The rewind history describes a timeline that no longer leads to the current state.
+		if (TimeRewindMode::STATE_SNAPSHOTS == m_timeRewindMode) {
+			m_timeRewind.Flush();
+		}
+		else {
+			m_inputReplayLog.Clear();
+		}
+	}
+
+
 	Entity& Engine::GetEntityFromHandle(const EntityHandle l_entityHandle)
 	{
 		using namespace LogSystem;
@@ -600,17 +955,33 @@ namespace Asteroid
 	}
 
 
+	RenderSystem::RenderQueue& Engine::GetRenderQueue()
+	{
+		return m_renderQueue;
+	}
+
+
 	const InputSystem& Engine::GetInputSystem() const
 	{
 		return m_inputSystem;
 	}
 
 
+	std::vector<Entity>& Engine::GetEntities()
+	{
+		return m_entities;
+	}
+
 	const std::vector<Entity>& Engine::GetEntities() const
 	{
 		return m_entities;
 	}
 
+	const ArchetypeTables& Engine::GetArchetypes() const
+	{
+		return m_archetypes;
+	}
+
 	void Engine::InitEntitiesAndPools()
 	{
 		glm::ivec2 lv_windowRes{};
@@ -628,35 +999,29 @@ namespace Asteroid
 			assert(nullptr != lv_spaceshipAnimMeta);
 
 
-			UserInputBasedMovementComponent* lv_movementComponent = static_cast<UserInputBasedMovementComponent*>(m_allocator.Allocate(sizeof(UserInputBasedMovementComponent)));
-			PlayerCollisionComponent* lv_collisionComponent = static_cast<PlayerCollisionComponent*>(m_allocator.Allocate(sizeof(PlayerCollisionComponent)));
-			IndefiniteRepeatableAnimationComponent* lv_entityAnimationComp = static_cast<IndefiniteRepeatableAnimationComponent*>(m_allocator.Allocate(sizeof(IndefiniteRepeatableAnimationComponent)));
-			ActiveBasedStateComponent* lv_activeComponent = static_cast<ActiveBasedStateComponent*>(m_allocator.Allocate(sizeof(ActiveBasedStateComponent)));
-			PlayerAttributeComponent* lv_playerAttribComponent = static_cast<PlayerAttributeComponent*>(m_allocator.Allocate(sizeof(PlayerAttributeComponent)));
-
-			
-			lv_movementComponent = new(lv_movementComponent) UserInputBasedMovementComponent();
-			lv_collisionComponent = new(lv_collisionComponent) PlayerCollisionComponent();
-			lv_entityAnimationComp = new(lv_entityAnimationComp) IndefiniteRepeatableAnimationComponent();
-			lv_activeComponent = new(lv_activeComponent) ActiveBasedStateComponent();
-			lv_playerAttribComponent = new(lv_playerAttribComponent) PlayerAttributeComponent();
-
+			UserInputBasedMovementComponent* lv_movementComponent = m_allocator.Create<UserInputBasedMovementComponent>();
+			PlayerCollisionComponent* lv_collisionComponent = m_allocator.Create<PlayerCollisionComponent>();
+			IndefiniteRepeatableAnimationComponent* lv_entityAnimationComp = m_allocator.Create<IndefiniteRepeatableAnimationComponent>();
+			ActiveBasedStateComponent* lv_activeComponent = m_allocator.Create<ActiveBasedStateComponent>();
+			PlayerAttributeComponent* lv_playerAttribComponent = m_allocator.Create<PlayerAttributeComponent>();
 
+			auto& lv_playerArchetype = m_archetypes.Get(EntityType::PLAYER);
+			const uint32_t lv_playerRow = lv_playerArchetype.AddRow(0U, glm::vec2{ (float)lv_windowRes.x / 2.f, (float)lv_windowRes.y / 2.f }, true);
 
-			lv_movementComponent->Init(0);
+			lv_movementComponent->Init(0, lv_playerArchetype, lv_playerRow);
 			lv_collisionComponent->Init(0, 0, 0, true, lv_entityAnimationComp, lv_playerAttribComponent, lv_warpAsteroidAnimMeta->m_totalNumFrames + 20U);
-			lv_entityAnimationComp->Init(0, lv_spaceshipAnimMeta, lv_movementComponent
+			lv_entityAnimationComp->Init(0, lv_playerArchetype, lv_playerRow, lv_spaceshipAnimMeta, lv_movementComponent
 										,lv_activeComponent, 0, 0, true);
 			lv_activeComponent->Init(0, lv_collisionComponent, lv_entityAnimationComp,
 				1, 1);
 			lv_playerAttribComponent->Init(0, 10U);
-			auto& lv_player = m_entities.emplace_back(std::move(Entity(glm::vec2{ (float)lv_windowRes.x/2.f, (float)lv_windowRes.y/2.f }, 0, EntityType::PLAYER, true)));
+			auto& lv_player = m_entities.emplace_back(std::move(Entity(lv_playerArchetype, lv_playerRow, 0, EntityType::PLAYER)));
 
-			lv_player.AddComponent(ComponentTypes::MOVEMENT, lv_movementComponent);
-			lv_player.AddComponent(ComponentTypes::ACTIVE_BASED_STATE, lv_activeComponent);
-			lv_player.AddComponent(ComponentTypes::INDEFINITE_ENTITY_ANIMATION, lv_entityAnimationComp);
-			lv_player.AddComponent(ComponentTypes::COLLISION, lv_collisionComponent);
-			lv_player.AddComponent(ComponentTypes::ATTRIBUTE, lv_playerAttribComponent);
+			AddComponent(lv_player, ComponentTypes::MOVEMENT, lv_movementComponent);
+			AddComponent(lv_player, ComponentTypes::ACTIVE_BASED_STATE, lv_activeComponent);
+			AddComponent(lv_player, ComponentTypes::INDEFINITE_ENTITY_ANIMATION, lv_entityAnimationComp);
+			AddComponent(lv_player, ComponentTypes::COLLISION, lv_collisionComponent);
+			AddComponent(lv_player, ComponentTypes::ATTRIBUTE, lv_playerAttribComponent);
 			
 			m_playerEntityHandle = 0U;
 			
@@ -669,36 +1034,32 @@ namespace Asteroid
 			const auto* lv_bulletAnimMetaData = GetAnimationMeta(AnimationType::LASER_BEAM);
 			assert(nullptr != lv_bulletAnimMetaData);
 			m_entitySpawnerFromPools.InitPool(Asteroid::EntityType::BULLET, (uint32_t)m_entities.size() ,lv_totalNumBullets);
+			auto& lv_bulletArchetype = m_archetypes.Get(EntityType::BULLET);
 			
 			for (uint32_t i = 0U; i < lv_totalNumBullets; ++i) {
 
 				const uint32_t lv_bulletIdx = 1U + i;
+				const uint32_t lv_bulletRow = lv_bulletArchetype.AddRow(lv_bulletIdx, glm::vec2{ 0.f, 0.f }, false);
 
 
-				BulletCollisionComponent* lv_collisionComponent = static_cast<BulletCollisionComponent*>(m_allocator.Allocate(sizeof(BulletCollisionComponent)));
-				RayMovementComponent* lv_movementComponent = static_cast<RayMovementComponent*>(m_allocator.Allocate(sizeof(RayMovementComponent)));
-				ActiveBasedStateComponent* lv_activeComponent = static_cast<ActiveBasedStateComponent*>(m_allocator.Allocate(sizeof(ActiveBasedStateComponent)));
-				IndefiniteRepeatableAnimationComponent* lv_entityMainAnimation = static_cast<IndefiniteRepeatableAnimationComponent*>(m_allocator.Allocate(sizeof(IndefiniteRepeatableAnimationComponent)));
-
-				lv_collisionComponent = new(lv_collisionComponent) BulletCollisionComponent();
-				lv_movementComponent = new(lv_movementComponent) RayMovementComponent();
-				lv_activeComponent = new(lv_activeComponent) ActiveBasedStateComponent();
-				lv_entityMainAnimation = new(lv_entityMainAnimation) IndefiniteRepeatableAnimationComponent();
-
+				BulletCollisionComponent* lv_collisionComponent = m_allocator.Create<BulletCollisionComponent>();
+				RayMovementComponent* lv_movementComponent = m_allocator.Create<RayMovementComponent>();
+				ActiveBasedStateComponent* lv_activeComponent = m_allocator.Create<ActiveBasedStateComponent>();
+				IndefiniteRepeatableAnimationComponent* lv_entityMainAnimation = m_allocator.Create<IndefiniteRepeatableAnimationComponent>();
 
 				lv_collisionComponent->Init(lv_bulletIdx,0, 0, true
 											, lv_entityMainAnimation, lv_activeComponent);
-				lv_movementComponent->Init(lv_bulletIdx);
+				lv_movementComponent->Init(lv_bulletIdx, lv_bulletArchetype, lv_bulletRow);
 				lv_activeComponent->Init(lv_bulletIdx, lv_collisionComponent, lv_entityMainAnimation, 0, 0);
-				lv_entityMainAnimation->Init(lv_bulletIdx, lv_bulletAnimMetaData, lv_movementComponent, lv_activeComponent, 0, 0, true);
+				lv_entityMainAnimation->Init(lv_bulletIdx, lv_bulletArchetype, lv_bulletRow, lv_bulletAnimMetaData, lv_movementComponent, lv_activeComponent, 0, 0, true);
 
-				auto& lv_bullet = m_entities.emplace_back(std::move(Entity(glm::vec2{ 0.f, 0.f }, lv_bulletIdx, EntityType::BULLET, false)));
+				auto& lv_bullet = m_entities.emplace_back(std::move(Entity(lv_bulletArchetype, lv_bulletRow, lv_bulletIdx, EntityType::BULLET)));
 			
 
-				lv_bullet.AddComponent(ComponentTypes::COLLISION, lv_collisionComponent);
-				lv_bullet.AddComponent(ComponentTypes::ACTIVE_BASED_STATE, lv_activeComponent);
-				lv_bullet.AddComponent(ComponentTypes::MOVEMENT, lv_movementComponent);
-				lv_bullet.AddComponent(ComponentTypes::INDEFINITE_ENTITY_ANIMATION, lv_entityMainAnimation);
+				AddComponent(lv_bullet, ComponentTypes::COLLISION, lv_collisionComponent);
+				AddComponent(lv_bullet, ComponentTypes::ACTIVE_BASED_STATE, lv_activeComponent);
+				AddComponent(lv_bullet, ComponentTypes::MOVEMENT, lv_movementComponent);
+				AddComponent(lv_bullet, ComponentTypes::INDEFINITE_ENTITY_ANIMATION, lv_entityMainAnimation);
 				
 
 				
@@ -718,50 +1079,44 @@ namespace Asteroid
 			assert(nullptr != lv_warpAsteroidAnimMeta);
 			const uint32_t lv_entitiesLastIndex = (uint32_t)m_entities.size();
 			m_entitySpawnerFromPools.InitPool(Asteroid::EntityType::ASTEROID, lv_entitiesLastIndex, lv_totalNumAsteroids);
+			auto& lv_asteroidArchetype = m_archetypes.Get(EntityType::ASTEROID);
 
 			for (uint32_t i = 0U; i < lv_totalNumAsteroids; ++i) {
 
 				const uint32_t lv_asteroidIdx = lv_entitiesLastIndex + i;
+				const uint32_t lv_asteroidRow = lv_asteroidArchetype.AddRow(lv_asteroidIdx, glm::vec2{ 0.f, 0.f }, false);
 
 
-				AsteroidCollisionComponent* lv_collisionComponent = static_cast<AsteroidCollisionComponent*>(m_allocator.Allocate(sizeof(AsteroidCollisionComponent)));
-				ActiveBasedStateComponent* lv_activeComponent = static_cast<ActiveBasedStateComponent*>(m_allocator.Allocate(sizeof(ActiveBasedStateComponent)));
-				RayMovementComponent* lv_movementComponent = static_cast<RayMovementComponent*>(m_allocator.Allocate(sizeof(RayMovementComponent)));
-				IndefiniteRepeatableAnimationComponent* lv_entityMainAnimation = static_cast<IndefiniteRepeatableAnimationComponent*>(m_allocator.Allocate(sizeof(IndefiniteRepeatableAnimationComponent)));
-				OnceRepeatableAnimationComponent* lv_fireExplosionAnimationComponent = static_cast<OnceRepeatableAnimationComponent*>(m_allocator.Allocate(sizeof(OnceRepeatableAnimationComponent)));
-				OnceRepeatableAnimationComponent* lv_warpAsteroidAnimComponent = static_cast<OnceRepeatableAnimationComponent*>(m_allocator.Allocate(sizeof(OnceRepeatableAnimationComponent)));
-				AsteroidAttributeComponent* lv_asteroidAttribComponent = static_cast<AsteroidAttributeComponent*>(m_allocator.Allocate(sizeof(AsteroidAttributeComponent)));
-
-				lv_collisionComponent = new(lv_collisionComponent) AsteroidCollisionComponent();
-				lv_activeComponent = new(lv_activeComponent) ActiveBasedStateComponent();
-				lv_movementComponent = new(lv_movementComponent) RayMovementComponent();
-				lv_entityMainAnimation = new(lv_entityMainAnimation) IndefiniteRepeatableAnimationComponent();
-				lv_fireExplosionAnimationComponent = new(lv_fireExplosionAnimationComponent) OnceRepeatableAnimationComponent();
-				lv_warpAsteroidAnimComponent = new(lv_warpAsteroidAnimComponent) OnceRepeatableAnimationComponent();
-				lv_asteroidAttribComponent = new(lv_asteroidAttribComponent) AsteroidAttributeComponent();
+				AsteroidCollisionComponent* lv_collisionComponent = m_allocator.Create<AsteroidCollisionComponent>();
+				ActiveBasedStateComponent* lv_activeComponent = m_allocator.Create<ActiveBasedStateComponent>();
+				RayMovementComponent* lv_movementComponent = m_allocator.Create<RayMovementComponent>();
+				IndefiniteRepeatableAnimationComponent* lv_entityMainAnimation = m_allocator.Create<IndefiniteRepeatableAnimationComponent>();
+				OnceRepeatableAnimationComponent* lv_fireExplosionAnimationComponent = m_allocator.Create<OnceRepeatableAnimationComponent>();
+				OnceRepeatableAnimationComponent* lv_warpAsteroidAnimComponent = m_allocator.Create<OnceRepeatableAnimationComponent>();
+				AsteroidAttributeComponent* lv_asteroidAttribComponent = m_allocator.Create<AsteroidAttributeComponent>();
 
 				lv_collisionComponent->Init(lv_asteroidIdx, lv_warpAsteroidAnimMeta->m_totalNumFrames + 20U, lv_explosionAsteroidAnimMeta->m_totalNumFrames / 3
 					, true, lv_entityMainAnimation, lv_fireExplosionAnimationComponent
 					, lv_activeComponent);
 				lv_activeComponent->Init(lv_asteroidIdx, lv_collisionComponent, lv_entityMainAnimation
 										, 1, lv_explosionAsteroidAnimMeta->m_totalNumFrames);
-				lv_movementComponent->Init(lv_asteroidIdx);
-				lv_entityMainAnimation->Init(lv_asteroidIdx, lv_asteroidAnimMeta, lv_movementComponent
+				lv_movementComponent->Init(lv_asteroidIdx, lv_asteroidArchetype, lv_asteroidRow);
+				lv_entityMainAnimation->Init(lv_asteroidIdx, lv_asteroidArchetype, lv_asteroidRow, lv_asteroidAnimMeta, lv_movementComponent
 											, lv_activeComponent, lv_warpAsteroidAnimMeta->m_totalNumFrames - 20U, 0, true);
-				lv_fireExplosionAnimationComponent->Init(lv_asteroidIdx, lv_explosionAsteroidAnimMeta , lv_movementComponent);
-				lv_warpAsteroidAnimComponent->Init(lv_asteroidIdx, lv_warpAsteroidAnimMeta, lv_movementComponent, false);
+				lv_fireExplosionAnimationComponent->Init(lv_asteroidIdx, ComponentTypes::EXPLOSION_FIRE_ASTEROID_ANIMATION, lv_explosionAsteroidAnimMeta , lv_movementComponent);
+				lv_warpAsteroidAnimComponent->Init(lv_asteroidIdx, ComponentTypes::WARP_ASTEROID_ANIMATION, lv_warpAsteroidAnimMeta, lv_movementComponent, false);
 
 				lv_asteroidAttribComponent->Init(lv_asteroidIdx, 3, AsteroidStates::PASSIVE, lv_movementComponent);
 
-				auto& lv_asteroid = m_entities.emplace_back(std::move(Entity(glm::vec2{ 0.f, 0.f }, lv_asteroidIdx,  EntityType::ASTEROID, false)));
+				auto& lv_asteroid = m_entities.emplace_back(std::move(Entity(lv_asteroidArchetype, lv_asteroidRow, lv_asteroidIdx, EntityType::ASTEROID)));
 
-				lv_asteroid.AddComponent(ComponentTypes::COLLISION, lv_collisionComponent);
-				lv_asteroid.AddComponent(ComponentTypes::ACTIVE_BASED_STATE, lv_activeComponent);
-				lv_asteroid.AddComponent(ComponentTypes::MOVEMENT, lv_movementComponent);
-				lv_asteroid.AddComponent(ComponentTypes::INDEFINITE_ENTITY_ANIMATION, lv_entityMainAnimation);
-				lv_asteroid.AddComponent(ComponentTypes::EXPLOSION_FIRE_ASTEROID_ANIMATION, lv_fireExplosionAnimationComponent);
-				lv_asteroid.AddComponent(ComponentTypes::WARP_ASTEROID_ANIMATION, lv_warpAsteroidAnimComponent);
-				lv_asteroid.AddComponent(ComponentTypes::ATTRIBUTE, lv_asteroidAttribComponent);
+				AddComponent(lv_asteroid, ComponentTypes::COLLISION, lv_collisionComponent);
+				AddComponent(lv_asteroid, ComponentTypes::ACTIVE_BASED_STATE, lv_activeComponent);
+				AddComponent(lv_asteroid, ComponentTypes::MOVEMENT, lv_movementComponent);
+				AddComponent(lv_asteroid, ComponentTypes::INDEFINITE_ENTITY_ANIMATION, lv_entityMainAnimation);
+				AddComponent(lv_asteroid, ComponentTypes::EXPLOSION_FIRE_ASTEROID_ANIMATION, lv_fireExplosionAnimationComponent);
+				AddComponent(lv_asteroid, ComponentTypes::WARP_ASTEROID_ANIMATION, lv_warpAsteroidAnimComponent);
+				AddComponent(lv_asteroid, ComponentTypes::ATTRIBUTE, lv_asteroidAttribComponent);
 
 
 				m_circleBoundsEntities.push_back(Circle{ .m_center{lv_asteroid.GetCurrentPos()}, .m_radius{lv_asteroidAnimMeta->m_widthToRenderTextures/2.f} });
@@ -775,39 +1130,154 @@ namespace Asteroid
 
 			const auto* lv_cursorAnim = GetAnimationMeta(AnimationType::CURSOR);
 			auto lv_index = m_entities.size();
+			auto& lv_cursorArchetype = m_archetypes.Get(EntityType::CURSOR);
+			const uint32_t lv_cursorRow = lv_cursorArchetype.AddRow((uint32_t)lv_index, glm::vec2{ 0.f, 0.f }, true);
 
-			RayMovementComponent* lv_movementComp = static_cast<RayMovementComponent*>(m_allocator.Allocate(sizeof(RayMovementComponent)));
-			IndefiniteRepeatableAnimationComponent* lv_mainAnimComp = static_cast<IndefiniteRepeatableAnimationComponent*>(m_allocator.Allocate(sizeof(IndefiniteRepeatableAnimationComponent)));
-			CursorAttributeComponent* lv_cursorAttribComp = static_cast<CursorAttributeComponent*>(m_allocator.Allocate(sizeof(CursorAttributeComponent)));
+			RayMovementComponent* lv_movementComp = m_allocator.Create<RayMovementComponent>();
+			IndefiniteRepeatableAnimationComponent* lv_mainAnimComp = m_allocator.Create<IndefiniteRepeatableAnimationComponent>();
+			CursorAttributeComponent* lv_cursorAttribComp = m_allocator.Create<CursorAttributeComponent>();
 
-			lv_movementComp = new(lv_movementComp) RayMovementComponent();
-			lv_mainAnimComp = new(lv_mainAnimComp) IndefiniteRepeatableAnimationComponent();
-			lv_cursorAttribComp = new(lv_cursorAttribComp) CursorAttributeComponent();
-
-			lv_movementComp->Init(static_cast<EntityHandle>(lv_index));
-			lv_mainAnimComp->Init(static_cast<EntityHandle>(lv_index), lv_cursorAnim, lv_movementComp, nullptr, 0, 0);
+			lv_movementComp->Init(static_cast<EntityHandle>(lv_index), lv_cursorArchetype, lv_cursorRow);
+			lv_mainAnimComp->Init(static_cast<EntityHandle>(lv_index), lv_cursorArchetype, lv_cursorRow, lv_cursorAnim, lv_movementComp, nullptr, 0, 0);
 			lv_cursorAttribComp->Init(static_cast<EntityHandle>(lv_index), 0, lv_movementComp, lv_mainAnimComp);
 
-			auto& lv_cursor = m_entities.emplace_back(std::move(Entity(glm::vec2{ 0.f, 0.f }, lv_index, EntityType::CURSOR, true)));
+			auto& lv_cursor = m_entities.emplace_back(std::move(Entity(lv_cursorArchetype, lv_cursorRow, (uint32_t)lv_index, EntityType::CURSOR)));
 
-			lv_cursor.AddComponent(ComponentTypes::ATTRIBUTE, lv_cursorAttribComp);
-			lv_cursor.AddComponent(ComponentTypes::MOVEMENT, lv_movementComp);
-			lv_cursor.AddComponent(ComponentTypes::INDEFINITE_ENTITY_ANIMATION, lv_mainAnimComp);
+			AddComponent(lv_cursor, ComponentTypes::ATTRIBUTE, lv_cursorAttribComp);
+			AddComponent(lv_cursor, ComponentTypes::MOVEMENT, lv_movementComp);
+			AddComponent(lv_cursor, ComponentTypes::INDEFINITE_ENTITY_ANIMATION, lv_mainAnimComp);
 
 			m_circleBoundsEntities.push_back(Circle{ .m_center{lv_cursor.GetCurrentPos()}, .m_radius{32.f}});
 
 
 		}
 
+		m_renderQueue.Reserve((uint32_t)m_entities.size());
 	}
 
-	void Engine::UpdateCircleBounds()
+	template<typename T>
+	void Engine::AddComponent(Entity& l_entity, const ComponentTypes l_componentType, T* l_component)
 	{
-		for (size_t i = 0; i < m_entities.size(); ++i) {
-			if (true == m_entities[i].GetActiveState()) {
-				m_circleBoundsEntities[i].m_center = m_entities[i].GetCurrentPos();
-			}
+		if (false == l_entity.AddComponent(l_componentType, l_component)) {
+			return;
+		}
+
+		if constexpr (true == ComponentUpdatePipeline::m_contains<T>) {
+			m_componentSystems.Register<T>(l_entity.GetType(), l_componentType);
+		}
+	}
+
+
+	void Engine::InitSystems()
+	{
+		//Systems that conflict run in the order they are added here. Component groups like 
+		//ANIMATION_COMPONENTS stand for state kept inside the components, which is only declared 
+		//to order the systems and is not verified.
+
+		constexpr std::array<std::pair<const char*, EntityType>, 3U> lv_rayMovementSystems
+		{ { {"RayMovement.Bullets", EntityType::BULLET}, {"RayMovement.Asteroids", EntityType::ASTEROID}, {"RayMovement.Cursor", EntityType::CURSOR} } };
+
+		for (const auto& [l_name, l_type] : lv_rayMovementSystems) {
+			m_systemScheduler.AddSystem(l_name
+				, SystemAccess{}
+				.Reads(l_type, EntityData::RAY_DIRECTIONS).Reads(l_type, EntityData::SPEEDS).Reads(l_type, EntityData::FLAGS)
+				.Writes(l_type, EntityData::POSITIONS)
+				, [this, l_type](UpdateComponents& l_updateContext) -> bool
+				{
+					MovementSystem::UpdateRayMovement(m_archetypes.Get(l_type), l_updateContext.m_deltaTime);
+					return true;
+				});
+		}
+
+		m_systemScheduler.AddSystem("Movement.Player"
+			, SystemAccess{}
+			.Reads(SharedData::INPUT).Reads(EntityType::PLAYER, EntityData::FLAGS)
+			.Writes(EntityType::PLAYER, EntityData::POSITIONS).Writes(EntityType::PLAYER, EntityData::MOVEMENT_COMPONENTS)
+			, [this](UpdateComponents& l_updateContext) -> bool
+			{
+				return m_componentSystems.UpdateType<UserInputBasedMovementComponent>(l_updateContext, m_entities, m_archetypes);
+			});
+
+		m_systemScheduler.AddSystem("Steering.Cursor"
+			, SystemAccess{}
+			.Reads(SharedData::INPUT).Reads(EntityType::CURSOR, EntityData::FLAGS)
+			.Writes(EntityType::CURSOR, EntityData::POSITIONS).Writes(EntityType::CURSOR, EntityData::RAY_DIRECTIONS)
+			.Writes(EntityType::CURSOR, EntityData::MOVEMENT_COMPONENTS).Writes(EntityType::CURSOR, EntityData::ANIMATION_COMPONENTS)
+			, [this](UpdateComponents& l_updateContext) -> bool
+			{
+				return m_componentSystems.UpdateType<CursorAttributeComponent>(l_updateContext, m_entities, m_archetypes);
+			});
+
+		//The asteroids head for where the player is after it moved this frame.
+		m_systemScheduler.AddSystem("Steering.Asteroids"
+			, SystemAccess{}
+			.Reads(EntityType::ASTEROID, EntityData::FLAGS).Reads(EntityType::ASTEROID, EntityData::POSITIONS)
+			.Reads(EntityType::ASTEROID, EntityData::ATTRIBUTE_COMPONENTS).Reads(EntityType::PLAYER, EntityData::POSITIONS)
+			.Writes(EntityType::ASTEROID, EntityData::RAY_DIRECTIONS)
+			, [this](UpdateComponents& l_updateContext) -> bool
+			{
+				return m_componentSystems.UpdateType<AsteroidAttributeComponent>(l_updateContext, m_entities, m_archetypes);
+			});
+
+		m_systemScheduler.AddSystem("CollisionBookkeeping"
+			, SystemAccess{}
+			.Reads(EntityType::ASTEROID, EntityData::FLAGS)
+			.Writes(EntityType::ASTEROID, EntityData::COLLISION_COMPONENTS).Writes(SharedData::HIT_COUNTER)
+			, [this](UpdateComponents& l_updateContext) -> bool
+			{
+				return m_componentSystems.UpdateType<AsteroidCollisionComponent>(l_updateContext, m_entities, m_archetypes);
+			});
+
+		//Deactivates what left the window during the previous frame, so it runs before the animations update the window bounds.
+		constexpr std::array<std::pair<const char*, EntityType>, 3U> lv_stateSystems
+		{ { {"State.Player", EntityType::PLAYER}, {"State.Bullets", EntityType::BULLET}, {"State.Asteroids", EntityType::ASTEROID} } };
+
+		for (const auto& [l_name, l_type] : lv_stateSystems) {
+			m_systemScheduler.AddSystem(l_name
+				, SystemAccess{}
+				.Reads(l_type, EntityData::POSITIONS).Reads(l_type, EntityData::ANIMATION_COMPONENTS).Reads(l_type, EntityData::STATE_COMPONENTS)
+				.Writes(l_type, EntityData::FLAGS)
+				, [this, l_type](UpdateComponents& l_updateContext) -> bool
+				{
+					return m_componentSystems.UpdateType<ActiveBasedStateComponent>(l_updateContext, m_entities, m_archetypes, l_type);
+				});
+		}
+
+		SystemAccess lv_mainAnimationAccess{};
+		lv_mainAnimationAccess.Writes(SharedData::RENDER_QUEUE);
+
+		for (uint32_t i = 0; i < (uint32_t)EntityType::TOTAL_NUM_ENTITY_TYPES; ++i) {
+			lv_mainAnimationAccess
+				.Reads((EntityType)i, EntityData::POSITIONS).Reads((EntityType)i, EntityData::FLAGS).Reads((EntityType)i, EntityData::MOVEMENT_COMPONENTS)
+				.Writes((EntityType)i, EntityData::ANIMATION_OFFSETS).Writes((EntityType)i, EntityData::ANIMATION_COMPONENTS);
 		}
+
+		m_systemScheduler.AddSystem("Animation.Main", lv_mainAnimationAccess
+			, [this](UpdateComponents& l_updateContext) -> bool
+			{
+				return m_componentSystems.UpdateType<IndefiniteRepeatableAnimationComponent>(l_updateContext, m_entities, m_archetypes);
+			});
+
+		m_systemScheduler.AddSystem("Animation.Effects"
+			, SystemAccess{}
+			.Reads(EntityType::ASTEROID, EntityData::POSITIONS).Reads(EntityType::ASTEROID, EntityData::FLAGS)
+			.Reads(EntityType::ASTEROID, EntityData::MOVEMENT_COMPONENTS)
+			.Writes(EntityType::ASTEROID, EntityData::ANIMATION_COMPONENTS).Writes(SharedData::RENDER_QUEUE)
+			, [this](UpdateComponents& l_updateContext) -> bool
+			{
+				return m_componentSystems.UpdateType<OnceRepeatableAnimationComponent>(l_updateContext, m_entities, m_archetypes);
+			});
+
+		m_systemScheduler.Start(m_jobSystem, m_initialData.m_verifySystemAccess);
+	}
+
+
+	void Engine::UpdateCircleBounds()
+	{
+		m_archetypes.ForEachActiveEntity([this](const uint32_t l_entityIndex) -> void
+			{
+				m_circleBoundsEntities[l_entityIndex].m_center = m_entities[l_entityIndex].GetCurrentPos();
+			});
 	}
 
 	void Engine::GetCurrentWindowSize(glm::ivec2& l_windowRes) const
@@ -0,0 +1,105 @@
+
+
+#include "Entities/ArchetypeTable.hpp"
+#include "Systems/SystemAccess.hpp"
+#include <cassert>
+
+
+namespace Asteroid
+{
+
+	uint32_t ArchetypeTable::AddRow(const uint32_t l_entityIndex, const glm::vec2& l_initialPos, const bool l_isActive)
+	{
+		const uint32_t lv_row = GetTotalNumRows();
+
+		m_entityIndices.push_back(l_entityIndex);
+		m_positions.push_back(l_initialPos);
+		m_rayDirections.push_back(glm::vec2{ 0.f });
+		m_speeds.push_back(0.f);
+		m_animationOffsets.push_back(0U);
+		m_flags.push_back(0U);
+		m_activeRowSlots.push_back(m_inactiveRowSlot);
+
+		//Rows are only added during initialization, so this is the last time the active rows can grow.
+		if (m_activeRows.capacity() < m_activeRowSlots.size()) {
+			m_activeRows.reserve(2U * m_activeRowSlots.size());
+		}
+
+		SetFlag(lv_row, ArchetypeFlags::ACTIVE, l_isActive);
+
+		return lv_row;
+	}
+
+
+	uint32_t ArchetypeTable::GetTotalNumRows() const
+	{
+		return (uint32_t)m_entityIndices.size();
+	}
+
+
+	bool ArchetypeTable::HasFlag(const uint32_t l_row, const ArchetypeFlags l_flag) const
+	{
+		SystemAccessCheck::OnRead(m_type, EntityData::FLAGS);
+		return 0U != (m_flags[l_row] & (uint8_t)l_flag);
+	}
+
+
+	void ArchetypeTable::SetFlag(const uint32_t l_row, const ArchetypeFlags l_flag, const bool l_state)
+	{
+		SystemAccessCheck::OnWrite(m_type, EntityData::FLAGS);
+		if (true == l_state) {
+			m_flags[l_row] |= (uint8_t)l_flag;
+		}
+		else {
+			m_flags[l_row] &= (uint8_t)~(uint8_t)l_flag;
+		}
+
+		if (ArchetypeFlags::ACTIVE != l_flag) {
+			return;
+		}
+
+		const uint32_t lv_slot = m_activeRowSlots[l_row];
+
+		if (true == l_state && m_inactiveRowSlot == lv_slot) {
+			m_activeRowSlots[l_row] = (uint32_t)m_activeRows.size();
+			m_activeRows.push_back(l_row);
+		}
+		else if (false == l_state && m_inactiveRowSlot != lv_slot) {
+			const uint32_t lv_lastRow = m_activeRows.back();
+
+			m_activeRows[lv_slot] = lv_lastRow;
+			m_activeRowSlots[lv_lastRow] = lv_slot;
+			m_activeRows.pop_back();
+			m_activeRowSlots[l_row] = m_inactiveRowSlot;
+		}
+	}
+
+
+	const std::vector<uint32_t>& ArchetypeTable::GetActiveRows() const
+	{
+		SystemAccessCheck::OnRead(m_type, EntityData::FLAGS);
+		return m_activeRows;
+	}
+
+
+	ArchetypeTables::ArchetypeTables()
+	{
+		for (uint32_t i = 0; i < (uint32_t)m_tables.size(); ++i) {
+			m_tables[i].m_type = (EntityType)i;
+		}
+	}
+
+
+	ArchetypeTable& ArchetypeTables::Get(const EntityType l_type)
+	{
+		assert(l_type < EntityType::TOTAL_NUM_ENTITY_TYPES);
+		return m_tables[(uint32_t)l_type];
+	}
+
+
+	const ArchetypeTable& ArchetypeTables::Get(const EntityType l_type) const
+	{
+		assert(l_type < EntityType::TOTAL_NUM_ENTITY_TYPES);
+		return m_tables[(uint32_t)l_type];
+	}
+}
\ No newline at end of file
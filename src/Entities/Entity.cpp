@@ -4,30 +4,44 @@
 #include "Entities/Entity.hpp"
 #include "Systems/LogSystem.hpp"
 #include "Components/ComponentTypes.hpp"
+#include "Systems/SnapshotWriter.hpp"
+#include "Systems/SnapshotReader.hpp"
+#include "Systems/TimeRewind/EntityMetaData.hpp"
+#include "Systems/MemoryAlloc.hpp"
+#include "Entities/ArchetypeTable.hpp"
+#include "Systems/SystemAccess.hpp"
+#include <cassert>
 
 namespace Asteroid
 {
-	Entity::Entity(const glm::vec2& l_initialPos, uint32_t l_id, const EntityType l_type, const bool l_isActive)
-		:m_currentPos(l_initialPos), m_id(l_id)
+	Entity::Entity(ArchetypeTable& l_archetype, const uint32_t l_archetypeRow, uint32_t l_id, const EntityType l_type)
+		:m_archetype(&l_archetype), m_archetypeRow(l_archetypeRow)
+		,m_id(l_id)
 		,m_type(l_type)
-		,m_isActive(l_isActive)
 	{
+		assert(l_archetypeRow < l_archetype.GetTotalNumRows() && l_id == l_archetype.m_entityIndices[l_archetypeRow]);
 
 	}
 
 
-	void Entity::AddComponent(const ComponentTypes l_componentType ,Component* l_component)
+	bool Entity::AddComponent(const ComponentTypes l_componentType ,Component* l_component)
 	{
 		using namespace LogSystem;
-		for (auto& l_component : m_components) {
-			if (l_componentType == l_component.first) {
-				LOG(Severity::INFO, Channel::INITIALIZATION
-					, "Attempting to add duplicate component types to an entity: Add component request rejected.\n", nullptr);
-				return;
-			}
+
+		assert(l_componentType < ComponentTypes::TOTAL_NUM_COMPONENT_TYPES);
+
+		if (true == HasComponent(l_componentType)) {
+			LOG(Severity::INFO, Channel::INITIALIZATION
+				, "Attempting to add duplicate component types to an entity: Add component request rejected.\n", nullptr);
+			return false;
 		}
 
-		m_components.emplace_back(std::pair<ComponentTypes, Component*>(l_componentType, l_component));
+		m_components[(uint32_t)l_componentType] = l_component;
+		m_componentsMask |= (1U << (uint32_t)l_componentType);
+		m_componentsOrder[m_totalNumComponents] = l_componentType;
+		++m_totalNumComponents;
+
+		return true;
 	}
 
 
@@ -39,59 +53,127 @@ namespace Asteroid
 
 	const glm::vec2& Entity::GetCurrentPos() const
 	{
-		return m_currentPos;
+		SystemAccessCheck::OnRead(m_type, EntityData::POSITIONS);
+		return m_archetype->m_positions[m_archetypeRow];
 	}
 
 
-	bool Entity::Update(UpdateComponents& l_updateComponents)
+	void Entity::SetCurrentPos(const glm::vec2& l_newPos)
 	{
-		for (auto& l_component : m_components) {
-			if (false == l_component.second->Update(l_updateComponents)) {
-				return false;
-			}
-		}
+		SystemAccessCheck::OnWrite(m_type, EntityData::POSITIONS);
+		m_archetype->m_positions[m_archetypeRow] = l_newPos;
+	}
 
-		return true;
+
+	Component* Entity::GetComponent(const ComponentTypes l_componentType) const
+	{
+		return m_components[(uint32_t)l_componentType];
 	}
 
 
+	bool Entity::HasComponent(const ComponentTypes l_componentType) const
+	{
+		return 0 != (m_componentsMask & (1U << (uint32_t)l_componentType));
+	}
 
 
+	void Entity::SetActiveState(const bool l_activeState)
+	{
+		using namespace LogSystem;
 
-	void Entity::SetCurrentPos(const glm::vec2& l_newPos)
+		LOG(Severity::INFO, Channel::PROGRAM_LOGIC, "Active state is changed");
+		m_archetype->SetFlag(m_archetypeRow, ArchetypeFlags::ACTIVE, l_activeState);
+	}
+
+	bool Entity::GetActiveState() const
 	{
-		m_currentPos = l_newPos;
+		return m_archetype->HasFlag(m_archetypeRow, ArchetypeFlags::ACTIVE);
 	}
 
 
-	Component* Entity::GetComponent(const ComponentTypes l_componentType) const
+	ArchetypeTable& Entity::GetArchetype() const
+	{
+		return *m_archetype;
+	}
+
+
+	uint32_t Entity::GetArchetypeRow() const
+	{
+		return m_archetypeRow;
+	}
+
+	uint32_t Entity::GetID() const
 	{
+		return m_id;
+	}
+
 
-		for (auto& l_component : m_components) {
-			if (l_componentType == l_component.first) {
-				return l_component.second;
-			}
+	void Entity::Recycle()
+	{
+		++m_generation;
+	}
+
+
+	uint32_t Entity::GetGeneration() const
+	{
+		return m_generation;
+	}
+
+
+	void Entity::SetGeneration(const uint32_t l_generation)
+	{
+		m_generation = l_generation;
+	}
+
+
+	Handle<Entity> Entity::GetHandle() const
+	{
+		return Handle<Entity>{ m_id, m_generation };
+	}
+
+
+	Entity* Entity::Resolve(std::vector<Entity>& l_entities, const Handle<Entity> l_handle)
+	{
+		if (l_handle.GetIndex() >= (uint32_t)l_entities.size()) {
+			return nullptr;
 		}
 
-		return nullptr;
+		Entity& lv_entity = l_entities[l_handle.GetIndex()];
+
+		return (true == l_handle.IsOfGeneration(lv_entity.m_generation)) ? &lv_entity : nullptr;
 	}
 
 
-	void Entity::SetActiveState(const bool l_activeState)
+	void Entity::Snapshot(SnapshotWriter& l_writer) const
 	{
-		using namespace LogSystem;
+		l_writer.Write(EntityMetaData{ .m_pos = GetCurrentPos(), .m_id = m_id, .m_generation = m_generation, .m_type = m_type });
 
-		LOG(Severity::INFO, Channel::PROGRAM_LOGIC, "Active state is changed");
-		m_isActive = l_activeState;
+		for (uint32_t i = 0; i < m_totalNumComponents; ++i) {
+			m_components[(uint32_t)m_componentsOrder[i]]->Snapshot(l_writer);
+		}
 	}
 
-	bool Entity::GetActiveState() const
+
+	void Entity::Restore(SnapshotReader& l_reader)
 	{
-		return m_isActive;
+		EntityMetaData lv_entityMetaData{};
+		l_reader.Read(lv_entityMetaData);
+
+		assert(m_id == lv_entityMetaData.m_id && m_type == lv_entityMetaData.m_type);
+
+		SetCurrentPos(lv_entityMetaData.m_pos);
+		m_generation = lv_entityMetaData.m_generation;
+
+		for (uint32_t i = 0; i < m_totalNumComponents; ++i) {
+			m_components[(uint32_t)m_componentsOrder[i]]->Restore(l_reader);
+		}
 	}
 
-	uint32_t Entity::GetID() const
+
+	void Entity::MarkComponentsDirty(MemoryAlloc& l_allocator) const
 	{
-		return m_id;
+		for (uint32_t i = 0; i < m_totalNumComponents; ++i) {
+			l_allocator.MarkDirty(m_components[(uint32_t)m_componentsOrder[i]]);
+		}
 	}
 }
\ No newline at end of file
@@ -4,9 +4,13 @@
 
 #include "Entities/EntityPool.hpp"
 #include "Entities/Entity.hpp"
+#include "Entities/ArchetypeTable.hpp"
 #include "Components/StateComponents/ActiveBasedStateComponent.hpp"
+#include "Systems/SnapshotWriter.hpp"
+#include "Systems/SnapshotReader.hpp"
 #include <utility>
 #include <limits>
+#include <algorithm>
 
 
 
@@ -109,52 +113,108 @@ namespace Asteroid
 		return lv_totalNumActiveEntities;
 	}
 
-	void EntityPool::Update(const std::vector<Entity>& l_entities)
+	void EntityPool::Snapshot(SnapshotWriter& l_writer) const
 	{
-		if (true == m_inactiveEntityIndices.empty() || true == m_activeEntityIndicesFromOldestToNewest.empty()) {
-			return;
+		l_writer.Write(m_nextInactiveIndex);
+		l_writer.WriteArray(m_inactiveEntityIndices.data(), (uint32_t)m_inactiveEntityIndices.size());
+		l_writer.WriteArray(m_activeEntityIndicesFromOldestToNewest.data(), (uint32_t)m_activeEntityIndicesFromOldestToNewest.size());
+	}
+
+	void EntityPool::Restore(SnapshotReader& l_reader)
+	{
+		l_reader.Read(m_nextInactiveIndex);
+		l_reader.ReadArray(m_inactiveEntityIndices.data(), (uint32_t)m_inactiveEntityIndices.size());
+		l_reader.ReadArray(m_activeEntityIndicesFromOldestToNewest.data(), (uint32_t)m_activeEntityIndicesFromOldestToNewest.size());
+	}
+
+
+	bool EntityPool::ValidateSnapshot(SnapshotReader& l_reader) const
+	{
+		const uint32_t lv_totalNumIndices = 1U + (uint32_t)m_inactiveEntityIndices.size() + (uint32_t)m_activeEntityIndicesFromOldestToNewest.size();
+
+		if (l_reader.GetTotalNumRemainingBytes() < sizeof(uint32_t) * (size_t)lv_totalNumIndices) {
+			return false;
 		}
-		else {
 
-			for (uint32_t i = 0; i < (uint32_t)m_inactiveEntityIndices.size(); ++i) {
+		const uint32_t lv_endEntityIndex = m_firstEntityIndex + (uint32_t)m_inactiveEntityIndices.size();
 
-				if (true == l_entities[i + m_firstEntityIndex].GetActiveState()) {
-					m_inactiveEntityIndices[i] = std::numeric_limits<uint32_t>::max();
-				}
-				else {
-					m_inactiveEntityIndices[i] = i + m_firstEntityIndex;
-					m_activeEntityIndicesFromOldestToNewest[i] = std::numeric_limits<uint32_t>::max();
-				}
+		for (uint32_t i = 0; i < lv_totalNumIndices; ++i) {
+
+			uint32_t lv_entityIndex{};
+			l_reader.Read(lv_entityIndex);
+
+			if (std::numeric_limits<uint32_t>::max() != lv_entityIndex && (lv_entityIndex < m_firstEntityIndex || lv_entityIndex >= lv_endEntityIndex)) {
+				return false;
 			}
 		}
 
-		m_nextInactiveIndex = std::numeric_limits<uint32_t>::max();
-		for (size_t i = 0; i < m_inactiveEntityIndices.size(); ++i) {
-			
-			if (std::numeric_limits<uint32_t>::max() != m_inactiveEntityIndices[i]) {
-				m_nextInactiveIndex = m_inactiveEntityIndices[i];
+		return true;
+	}
+
+
+	void EntityPool::Update(const std::vector<Entity>& l_entities, const ArchetypeTable& l_table)
+	{
+		if (true == m_inactiveEntityIndices.empty() || true == m_activeEntityIndicesFromOldestToNewest.empty()) {
+			return;
+		}
+
+		constexpr uint32_t lv_invalidIndex = std::numeric_limits<uint32_t>::max();
+		const uint32_t lv_totalNumEntities = (uint32_t)m_activeEntityIndicesFromOldestToNewest.size();
+
+		//The meaningful entity indices are always adjacent at the front, so only those are walked.
+		//The ones that were deactivated since the last update are handed back as inactive and the
+		//rest are moved next to each other, keeping the order they were activated in.
+		uint32_t lv_totalNumTrackedEntities{};
+		uint32_t lv_totalNumStillActiveEntities{};
+
+		for (; lv_totalNumTrackedEntities < lv_totalNumEntities; ++lv_totalNumTrackedEntities) {
+
+			const uint32_t lv_entityIndex = m_activeEntityIndicesFromOldestToNewest[lv_totalNumTrackedEntities];
+
+			if (lv_invalidIndex == lv_entityIndex) {
 				break;
 			}
 
+			if (true == l_entities[lv_entityIndex].GetActiveState()) {
+				m_activeEntityIndicesFromOldestToNewest[lv_totalNumStillActiveEntities] = lv_entityIndex;
+				++lv_totalNumStillActiveEntities;
+			}
+			else {
+				m_inactiveEntityIndices[lv_entityIndex - m_firstEntityIndex] = lv_entityIndex;
+				m_nextInactiveIndex = std::min(m_nextInactiveIndex, lv_entityIndex);
+			}
 		}
 
+		std::fill(m_activeEntityIndicesFromOldestToNewest.begin() + lv_totalNumStillActiveEntities
+			, m_activeEntityIndicesFromOldestToNewest.begin() + lv_totalNumTrackedEntities, lv_invalidIndex);
 
-		//This vector could have the meaningful entity indices and max() interleaved after the updates above.
-		//Therefore in order to make sure all meaningful entity indices are adjacent to each other,
-		//we scan the whole vector and put them next to each other.
-		for (size_t i = 0; i < m_activeEntityIndicesFromOldestToNewest.size(); ++i) {
 
-			if (std::numeric_limits<uint32_t>::max() == m_activeEntityIndicesFromOldestToNewest[i]) {
-				for (size_t j = i + 1; j < m_activeEntityIndicesFromOldestToNewest.size(); ++j) {
-					if (std::numeric_limits<uint32_t>::max() != m_activeEntityIndicesFromOldestToNewest[j]) {
-						m_activeEntityIndicesFromOldestToNewest[i] = m_activeEntityIndicesFromOldestToNewest[j];
-						m_activeEntityIndicesFromOldestToNewest[j] = std::numeric_limits<uint32_t>::max();
-						break;
-					}
-				}
+		//Entities that became active without being fetched from the pool are appended as the newest ones.
+		bool lv_nextInactiveIndexTaken{ false };
+
+		for (const uint32_t l_row : l_table.GetActiveRows()) {
+
+			const uint32_t lv_entityIndex = l_table.m_entityIndices[l_row];
+
+			if (lv_invalidIndex != m_inactiveEntityIndices[lv_entityIndex - m_firstEntityIndex]) {
+				m_inactiveEntityIndices[lv_entityIndex - m_firstEntityIndex] = lv_invalidIndex;
+				m_activeEntityIndicesFromOldestToNewest[lv_totalNumStillActiveEntities] = lv_entityIndex;
+				++lv_totalNumStillActiveEntities;
+
+				lv_nextInactiveIndexTaken |= (lv_entityIndex == m_nextInactiveIndex);
 			}
 		}
 
+		if (true == lv_nextInactiveIndexTaken) {
+			m_nextInactiveIndex = lv_invalidIndex;
+			for (size_t i = 0; i < m_inactiveEntityIndices.size(); ++i) {
+
+				if (lv_invalidIndex != m_inactiveEntityIndices[i]) {
+					m_nextInactiveIndex = m_inactiveEntityIndices[i];
+					break;
+				}
 
+			}
+		}
 	}
 }
\ No newline at end of file
@@ -12,9 +12,11 @@
 #include "Components/OnceRepeatableAnimationComponent.hpp"
 #include "Entities/Entity.hpp"
 #include "Components/AttributeComponents/AsteroidAttributeComponent.hpp"
+#include "Systems/DelayedCallbacks.hpp"
 
 
 #include "Systems/LogSystem.hpp"
+#include "Systems/SnapshotReader.hpp"
 
 namespace Asteroid
 {
@@ -55,10 +57,11 @@ namespace Asteroid
 			LOG(Severity::INFO, Channel::GRAPHICS, "Bullet with index %u is being fetched", lv_nextInactiveBulletIdx);
 
 			auto& lv_bullet = m_engine->GetEntityFromHandle(lv_nextInactiveBulletIdx.m_entityHandle);
+			lv_bullet.Recycle();
 
-			auto* lv_collisionComponent = (CollisionComponent*)lv_bullet.GetComponent(ComponentTypes::COLLISION);
-			auto* lv_entityMainAnimationComponent = (IndefiniteRepeatableAnimationComponent*)lv_bullet.GetComponent(ComponentTypes::INDEFINITE_ENTITY_ANIMATION);
-			auto* lv_activeComponent = (ActiveBasedStateComponent*)lv_bullet.GetComponent(ComponentTypes::ACTIVE_BASED_STATE);
+			auto* lv_collisionComponent = lv_bullet.Get<CollisionComponent>();
+			auto* lv_entityMainAnimationComponent = lv_bullet.Get<IndefiniteRepeatableAnimationComponent>();
+			auto* lv_activeComponent = lv_bullet.Get<ActiveBasedStateComponent>();
 			lv_bullet.SetActiveState(true);
 			lv_collisionComponent->SetCollisionState(true);
 			lv_collisionComponent->Reset();
@@ -71,10 +74,10 @@ namespace Asteroid
 			const auto& lv_mousePos = m_engine->GetInputSystem().GetMousePosRelativeToWindow();
 			glm::vec2 lv_direction = lv_mousePos - lv_currentPlayerPos;
 
-			RayMovementComponent* lv_bulletMovComponent = (RayMovementComponent*)lv_bullet.GetComponent(ComponentTypes::MOVEMENT);
+			RayMovementComponent* lv_bulletMovComponent = lv_bullet.Get<RayMovementComponent>();
 			constexpr float lv_initialT{ 55.f };
 
-			lv_bulletMovComponent->SetSpeed(glm::vec2{0.78f});
+			lv_bulletMovComponent->SetSpeed(0.78f);
 
 			if(0 == lv_direction.x && 0 == lv_direction.y) {
 				lv_bulletMovComponent->SetRayDirection(lv_direction);
@@ -123,12 +126,15 @@ namespace Asteroid
 				glm::vec2 lv_asteroidPos = lv_centerPosCells[m_randomIndexCellNumbers[i]];
 
 				auto& lv_asteroid = m_engine->GetEntityFromHandle(lv_nextInactiveAsteroidIdx.m_entityHandle);
+
+				//The oldest asteroid is taken while still active if the pool is empty, which must cancel the callbacks of its previous life.
+				lv_asteroid.Recycle();
 				lv_asteroid.SetCurrentPos(lv_asteroidPos);
-				auto* lv_collisionComponent = (CollisionComponent*)lv_asteroid.GetComponent(ComponentTypes::COLLISION);
-				auto* lv_entityMainAnimationComponent = (IndefiniteRepeatableAnimationComponent*)lv_asteroid.GetComponent(ComponentTypes::INDEFINITE_ENTITY_ANIMATION);
-				auto* lv_activeComponent = (ActiveBasedStateComponent*)lv_asteroid.GetComponent(ComponentTypes::ACTIVE_BASED_STATE);
-				auto* lv_warpEffect = (OnceRepeatableAnimationComponent*)lv_asteroid.GetComponent(ComponentTypes::WARP_ASTEROID_ANIMATION);
-				auto* lv_asteroidAttribComponent = (AsteroidAttributeComponent*)lv_asteroid.GetComponent(ComponentTypes::ATTRIBUTE);
+				auto* lv_collisionComponent = lv_asteroid.Get<CollisionComponent>();
+				auto* lv_entityMainAnimationComponent = lv_asteroid.Get<IndefiniteRepeatableAnimationComponent>();
+				auto* lv_activeComponent = lv_asteroid.Get<ActiveBasedStateComponent>();
+				auto* lv_warpEffect = lv_asteroid.Get<OnceRepeatableAnimationComponent>(ComponentTypes::WARP_ASTEROID_ANIMATION);
+				auto* lv_asteroidAttribComponent = lv_asteroid.Get<AsteroidAttributeComponent>();
 
 
 				lv_asteroid.SetActiveState(true);
@@ -140,28 +146,25 @@ namespace Asteroid
 				lv_warpEffect->StartAnimation();
 				lv_asteroidAttribComponent->SetState(1 == l_level ? AsteroidStates::PASSIVE : AsteroidStates::AGGRESIVE);
 
-				DelayedSetStateCallback lv_delayedCollisionActivation
-				{
-					.m_callback{[lv_collisionComponent]() {lv_collisionComponent->SetCollisionState(true); }},
-					.m_maxNumFrames = lv_collisionComponent->GetFrameCountToActivateCollision()
-				};
+				const uint32_t lv_asteroidID = lv_asteroid.GetID();
+				const uint32_t lv_asteroidGeneration = lv_asteroid.GetGeneration();
+				auto& lv_entities = m_engine->GetEntities();
 
-				DelayedSetStateCallback lv_delayedVisibilityActivation
-				{
-					.m_callback{[lv_entityMainAnimationComponent]() {lv_entityMainAnimationComponent->SetVisibleState(true); }},
-					.m_maxNumFrames = lv_entityMainAnimationComponent->GetFrameCountToActivateVisbility()
-				};
+				lv_callBacksTimer.AddSetStateCallback(DelayedCallbacks::Create(lv_entities
+					, DelayedCallbackDescriptor{ .m_type = DelayedCallbackType::ACTIVATE_COLLISION, .m_entityID = lv_asteroidID, .m_entityGeneration = lv_asteroidGeneration }
+					, lv_collisionComponent->GetFrameCountToActivateCollision()));
 
-				lv_callBacksTimer.AddSetStateCallback(std::move(lv_delayedCollisionActivation));
-				lv_callBacksTimer.AddSetStateCallback(std::move(lv_delayedVisibilityActivation));
+				lv_callBacksTimer.AddSetStateCallback(DelayedCallbacks::Create(lv_entities
+					, DelayedCallbackDescriptor{ .m_type = DelayedCallbackType::SHOW_MAIN_ANIMATION, .m_entityID = lv_asteroidID, .m_entityGeneration = lv_asteroidGeneration }
+					, lv_entityMainAnimationComponent->GetFrameCountToActivateVisbility()));
 
 
 				glm::vec2 lv_direction{ std::cos(m_randomDirectionsForAsteroids[i] + lv_piOver180 * m_randomIndexCellNumbers[i]), std::sin(m_randomDirectionsForAsteroids[i] + lv_piOver180 * m_randomIndexCellNumbers[i]) };
 
-				RayMovementComponent* lv_asteroidMovComponent = (RayMovementComponent*)lv_asteroid.GetComponent(ComponentTypes::MOVEMENT);
+				RayMovementComponent* lv_asteroidMovComponent = lv_asteroid.Get<RayMovementComponent>();
 				constexpr float lv_initialT{ 20.f };
 
-				lv_asteroidMovComponent->SetSpeed(glm::vec2{ 0.1f });
+				lv_asteroidMovComponent->SetSpeed(0.1f);
 				lv_asteroidMovComponent->SetRayDirection(lv_direction);
 				lv_asteroidMovComponent->SetInitialT(lv_initialT);
 				lv_asteroidMovComponent->SetAngleOfRotation(0.f);
@@ -169,12 +172,9 @@ namespace Asteroid
 
 				lv_asteroidMovComponent->SetPauseState(true);
 
-				DelayedSetStateCallback lv_delayedMovementActivation
-				{
-					.m_callback{[lv_asteroidMovComponent]() {lv_asteroidMovComponent->SetPauseState(false); }},
-					.m_maxNumFrames = lv_warpEffect->GetAnimationMetaData()->m_totalNumFrames
-				};
-				lv_callBacksTimer.AddSetStateCallback(std::move(lv_delayedMovementActivation));
+				lv_callBacksTimer.AddSetStateCallback(DelayedCallbacks::Create(lv_entities
+					, DelayedCallbackDescriptor{ .m_type = DelayedCallbackType::RESUME_MOVEMENT, .m_entityID = lv_asteroidID, .m_entityGeneration = lv_asteroidGeneration }
+					, lv_warpEffect->GetAnimationMetaData()->m_totalNumFrames));
 
 			}
 
@@ -184,8 +184,10 @@ namespace Asteroid
 
 	void EntitySpawnerFromPools::UpdatePools()
 	{
-		m_bulletsPool.Update(m_engine->GetEntities());
-		m_asteroidPool.Update(m_engine->GetEntities());
+		const auto& lv_archetypes = m_engine->GetArchetypes();
+
+		m_bulletsPool.Update(m_engine->GetEntities(), lv_archetypes.Get(EntityType::BULLET));
+		m_asteroidPool.Update(m_engine->GetEntities(), lv_archetypes.Get(EntityType::ASTEROID));
 	}
 
 
@@ -219,6 +221,35 @@ namespace Asteroid
 	}
 
 
+	const std::mt19937& EntitySpawnerFromPools::GetRandomEngine() const
+	{
+		return m_mt;
+	}
+
+	void EntitySpawnerFromPools::SetRandomEngine(const std::mt19937& l_randomEngine)
+	{
+		m_mt = l_randomEngine;
+	}
+
+
+	void EntitySpawnerFromPools::SnapshotPools(SnapshotWriter& l_writer) const
+	{
+		m_bulletsPool.Snapshot(l_writer);
+		m_asteroidPool.Snapshot(l_writer);
+	}
+
+	void EntitySpawnerFromPools::RestorePools(SnapshotReader& l_reader)
+	{
+		m_bulletsPool.Restore(l_reader);
+		m_asteroidPool.Restore(l_reader);
+	}
+
+	bool EntitySpawnerFromPools::ValidatePoolsSnapshot(SnapshotReader& l_reader) const
+	{
+		return true == m_bulletsPool.ValidateSnapshot(l_reader) && true == m_asteroidPool.ValidateSnapshot(l_reader) && true == l_reader.IsAtEnd();
+	}
+
+
 	bool EntitySpawnerFromPools::AsteroidSpawnConditionMet(const bool l_timeRewinded)
 	{
 		if (true == l_timeRewinded) { return false; }
@@ -0,0 +1,200 @@
+
+
+
+
+#include "Systems/AllocationTracker.hpp"
+#include <new>
+#include <cstdlib>
+
+
+
+//Replacements of the global allocation functions so the allocation tracker sees every
+//allocation made through new. They only forward to malloc and free otherwise.
+
+static void* AllocateOrThrow(std::size_t l_sizeInBytes)
+{
+	Asteroid::AllocationTracker::RecordAllocation(l_sizeInBytes);
+
+	if (0U == l_sizeInBytes) {
+		l_sizeInBytes = 1U;
+	}
+
+	while (true) {
+
+		if (void* lv_memory = std::malloc(l_sizeInBytes); nullptr != lv_memory) {
+			return lv_memory;
+		}
+
+		std::new_handler lv_newHandler = std::get_new_handler();
+
+		if (nullptr == lv_newHandler) {
+			throw std::bad_alloc{};
+		}
+
+		lv_newHandler();
+	}
+}
+
+
+static void* AllocateAlignedOrThrow(std::size_t l_sizeInBytes, const std::align_val_t l_alignment)
+{
+	Asteroid::AllocationTracker::RecordAllocation(l_sizeInBytes);
+
+	const std::size_t lv_alignment = static_cast<std::size_t>(l_alignment);
+
+	//aligned_alloc() wants a size that is a multiple of the alignment.
+	const std::size_t lv_sizeInBytes = (0U == l_sizeInBytes) ? lv_alignment : (l_sizeInBytes + lv_alignment - 1U) & ~(lv_alignment - 1U);
+
+	while (true) {
+
+#ifdef _WIN32
+		void* lv_memory = _aligned_malloc(lv_sizeInBytes, lv_alignment);
+#else
+		void* lv_memory = std::aligned_alloc(lv_alignment, lv_sizeInBytes);
+#endif
+		if (nullptr != lv_memory) {
+			return lv_memory;
+		}
+
+		std::new_handler lv_newHandler = std::get_new_handler();
+
+		if (nullptr == lv_newHandler) {
+			throw std::bad_alloc{};
+		}
+
+		lv_newHandler();
+	}
+}
+
+
+static void FreeAligned(void* l_memory)
+{
+#ifdef _WIN32
+	_aligned_free(l_memory);
+#else
+	std::free(l_memory);
+#endif
+}
+
+
+
+void* operator new(std::size_t l_sizeInBytes)
+{
+	return AllocateOrThrow(l_sizeInBytes);
+}
+
+void* operator new[](std::size_t l_sizeInBytes)
+{
+	return AllocateOrThrow(l_sizeInBytes);
+}
+
+void* operator new(std::size_t l_sizeInBytes, const std::nothrow_t&) noexcept
+{
+	try {
+		return AllocateOrThrow(l_sizeInBytes);
+	}
+	catch (const std::bad_alloc&) {
+		return nullptr;
+	}
+}
+
+void* operator new[](std::size_t l_sizeInBytes, const std::nothrow_t&) noexcept
+{
+	try {
+		return AllocateOrThrow(l_sizeInBytes);
+	}
+	catch (const std::bad_alloc&) {
+		return nullptr;
+	}
+}
+
+void* operator new(std::size_t l_sizeInBytes, std::align_val_t l_alignment)
+{
+	return AllocateAlignedOrThrow(l_sizeInBytes, l_alignment);
+}
+
+void* operator new[](std::size_t l_sizeInBytes, std::align_val_t l_alignment)
+{
+	return AllocateAlignedOrThrow(l_sizeInBytes, l_alignment);
+}
+
+void* operator new(std::size_t l_sizeInBytes, std::align_val_t l_alignment, const std::nothrow_t&) noexcept
+{
+	try {
+		return AllocateAlignedOrThrow(l_sizeInBytes, l_alignment);
+	}
+	catch (const std::bad_alloc&) {
+		return nullptr;
+	}
+}
+
+void* operator new[](std::size_t l_sizeInBytes, std::align_val_t l_alignment, const std::nothrow_t&) noexcept
+{
+	try {
+		return AllocateAlignedOrThrow(l_sizeInBytes, l_alignment);
+	}
+	catch (const std::bad_alloc&) {
+		return nullptr;
+	}
+}
+
+
+void operator delete(void* l_memory) noexcept
+{
+	std::free(l_memory);
+}
+
+void operator delete[](void* l_memory) noexcept
+{
+	std::free(l_memory);
+}
+
+void operator delete(void* l_memory, std::size_t) noexcept
+{
+	std::free(l_memory);
+}
+
+void operator delete[](void* l_memory, std::size_t) noexcept
+{
+	std::free(l_memory);
+}
+
+void operator delete(void* l_memory, const std::nothrow_t&) noexcept
+{
+	std::free(l_memory);
+}
+
+void operator delete[](void* l_memory, const std::nothrow_t&) noexcept
+{
+	std::free(l_memory);
+}
+
+void operator delete(void* l_memory, std::align_val_t) noexcept
+{
+	FreeAligned(l_memory);
+}
+
+void operator delete[](void* l_memory, std::align_val_t) noexcept
+{
+	FreeAligned(l_memory);
+}
+
+void operator delete(void* l_memory, std::size_t, std::align_val_t) noexcept
+{
+	FreeAligned(l_memory);
+}
+
+void operator delete[](void* l_memory, std::size_t, std::align_val_t) noexcept
+{
+	FreeAligned(l_memory);
+}
+
+void operator delete(void* l_memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	FreeAligned(l_memory);
+}
+
+void operator delete[](void* l_memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	FreeAligned(l_memory);
+}
\ No newline at end of file
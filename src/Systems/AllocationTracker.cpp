@@ -0,0 +1,252 @@
+
+
+
+
+#include "Systems/AllocationTracker.hpp"
+#include <SDL3/SDL_stdinc.h>
+#include <imgui.h>
+#include <atomic>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <execinfo.h>
+#include <unistd.h>
+#endif
+
+
+namespace Asteroid
+{
+	namespace AllocationTracker
+	{
+
+		static constexpr uint32_t lv_maxNumRecordedCallStacks{ 4U };
+		static constexpr uint32_t lv_maxNumCallStackFrames{ 8U };
+
+		struct RecordedAllocation
+		{
+			size_t m_sizeInBytes{};
+			LoopPhase m_phase{};
+			uint32_t m_totalNumFrames{};
+			std::array<void*, lv_maxNumCallStackFrames> m_callStack{};
+		};
+
+		static std::atomic<bool> lv_isEnabled{ false };
+		static std::atomic<bool> lv_isCounting{ false };
+		static std::atomic<LoopPhase> lv_currentPhase{ LoopPhase::INPUT };
+		static std::array<std::atomic<uint32_t>, (size_t)LoopPhase::TOTAL_NUM_PHASES> lv_totalNumAllocationsPerPhase{};
+		static std::array<RecordedAllocation, lv_maxNumRecordedCallStacks> lv_recordedAllocations{};
+		static std::atomic<uint32_t> lv_totalNumRecordedAllocations{};
+
+		static uint32_t lv_totalNumWarmUpFrames{};
+		static uint64_t lv_frameIndex{};
+		static uint64_t lv_totalNumFramesChecked{};
+		static uint64_t lv_totalNumFramesThatAllocated{};
+
+		//Capturing and printing a call stack may allocate on its own.
+		static thread_local bool lv_isInsideTracker{ false };
+
+		static SDL_malloc_func lv_sdlMalloc{};
+		static SDL_calloc_func lv_sdlCalloc{};
+		static SDL_realloc_func lv_sdlRealloc{};
+		static SDL_free_func lv_sdlFree{};
+
+		static const char* const lv_phaseNames[] = { "input", "simulation", "ui", "rendering" };
+
+
+		static uint32_t CaptureCallStack(std::array<void*, lv_maxNumCallStackFrames>& l_callStack)
+		{
+#ifdef _WIN32
+			return (uint32_t)CaptureStackBackTrace(2U, lv_maxNumCallStackFrames, l_callStack.data(), nullptr);
+#else
+			return (uint32_t)backtrace(l_callStack.data(), (int)lv_maxNumCallStackFrames);
+#endif
+		}
+
+
+		static void PrintCallStack(const RecordedAllocation& l_allocation)
+		{
+#ifdef _WIN32
+			for (uint32_t i = 0; i < l_allocation.m_totalNumFrames; ++i) {
+				std::fprintf(stderr, "        %p\n", l_allocation.m_callStack[i]);
+			}
+#else
+			//Skips the frames of the tracker itself, like CaptureStackBackTrace() does on Windows.
+			const uint32_t lv_firstFrame = std::min(2U, l_allocation.m_totalNumFrames);
+
+			std::fflush(stderr);
+			backtrace_symbols_fd(l_allocation.m_callStack.data() + lv_firstFrame, (int)(l_allocation.m_totalNumFrames - lv_firstFrame), STDERR_FILENO);
+#endif
+		}
+
+
+		static void* SDLCALL TrackedSDLMalloc(size_t l_sizeInBytes)
+		{
+			RecordAllocation(l_sizeInBytes);
+			return lv_sdlMalloc(l_sizeInBytes);
+		}
+
+		static void* SDLCALL TrackedSDLCalloc(size_t l_totalNumElements, size_t l_elementSizeInBytes)
+		{
+			RecordAllocation(l_totalNumElements * l_elementSizeInBytes);
+			return lv_sdlCalloc(l_totalNumElements, l_elementSizeInBytes);
+		}
+
+		static void* SDLCALL TrackedSDLRealloc(void* l_memory, size_t l_sizeInBytes)
+		{
+			RecordAllocation(l_sizeInBytes);
+			return lv_sdlRealloc(l_memory, l_sizeInBytes);
+		}
+
+		static void* TrackedImGuiAlloc(size_t l_sizeInBytes, void*)
+		{
+			RecordAllocation(l_sizeInBytes);
+			return std::malloc(l_sizeInBytes);
+		}
+
+		static void TrackedImGuiFree(void* l_memory, void*)
+		{
+			std::free(l_memory);
+		}
+
+
+
+		void Enable(const uint32_t l_totalNumWarmUpFrames)
+		{
+			lv_totalNumWarmUpFrames = l_totalNumWarmUpFrames;
+
+#ifndef _WIN32
+			//The first backtrace() loads the unwinder, which would otherwise be reported as an allocation.
+			std::array<void*, lv_maxNumCallStackFrames> lv_callStack{};
+			CaptureCallStack(lv_callStack);
+#endif
+
+			lv_isEnabled.store(true);
+		}
+
+
+		bool IsEnabled()
+		{
+			return lv_isEnabled.load(std::memory_order_relaxed);
+		}
+
+
+		void InstallLibraryHooks()
+		{
+			SDL_GetOriginalMemoryFunctions(&lv_sdlMalloc, &lv_sdlCalloc, &lv_sdlRealloc, &lv_sdlFree);
+			SDL_SetMemoryFunctions(&TrackedSDLMalloc, &TrackedSDLCalloc, &TrackedSDLRealloc, lv_sdlFree);
+
+			ImGui::SetAllocatorFunctions(&TrackedImGuiAlloc, &TrackedImGuiFree, nullptr);
+		}
+
+
+		void BeginFrame()
+		{
+			if (false == IsEnabled()) {
+				return;
+			}
+
+			for (auto& l_totalNumAllocations : lv_totalNumAllocationsPerPhase) {
+				l_totalNumAllocations.store(0U, std::memory_order_relaxed);
+			}
+			lv_totalNumRecordedAllocations.store(0U, std::memory_order_relaxed);
+			lv_currentPhase.store(LoopPhase::INPUT, std::memory_order_relaxed);
+
+			lv_isCounting.store(lv_frameIndex >= lv_totalNumWarmUpFrames, std::memory_order_release);
+		}
+
+
+		void SetPhase(const LoopPhase l_phase)
+		{
+			lv_currentPhase.store(l_phase, std::memory_order_relaxed);
+		}
+
+
+		bool EndFrame()
+		{
+			if (false == IsEnabled()) {
+				return true;
+			}
+
+			const bool lv_wasCounting = lv_isCounting.exchange(false, std::memory_order_acquire);
+			++lv_frameIndex;
+
+			if (false == lv_wasCounting) {
+				return true;
+			}
+
+			++lv_totalNumFramesChecked;
+
+			uint32_t lv_totalNumAllocations{};
+			for (const auto& l_totalNumAllocationsOfPhase : lv_totalNumAllocationsPerPhase) {
+				lv_totalNumAllocations += l_totalNumAllocationsOfPhase.load(std::memory_order_relaxed);
+			}
+
+			if (0U == lv_totalNumAllocations) {
+				return true;
+			}
+
+			++lv_totalNumFramesThatAllocated;
+
+			lv_isInsideTracker = true;
+
+			std::fprintf(stderr, "Frame %llu allocated %u times (input %u, simulation %u, ui %u, rendering %u).\n"
+				, (unsigned long long)lv_frameIndex - 1U, lv_totalNumAllocations
+				, lv_totalNumAllocationsPerPhase[0].load(), lv_totalNumAllocationsPerPhase[1].load()
+				, lv_totalNumAllocationsPerPhase[2].load(), lv_totalNumAllocationsPerPhase[3].load());
+
+			const uint32_t lv_totalNumRecorded = std::min(lv_totalNumRecordedAllocations.load(), lv_maxNumRecordedCallStacks);
+
+			for (uint32_t i = 0; i < lv_totalNumRecorded; ++i) {
+				const auto& lv_allocation = lv_recordedAllocations[i];
+				std::fprintf(stderr, "    %zu bytes during %s:\n", lv_allocation.m_sizeInBytes, lv_phaseNames[(uint32_t)lv_allocation.m_phase]);
+				PrintCallStack(lv_allocation);
+			}
+
+			lv_isInsideTracker = false;
+
+			return false;
+		}
+
+
+		uint64_t GetTotalNumFramesChecked()
+		{
+			return lv_totalNumFramesChecked;
+		}
+
+
+		uint64_t GetTotalNumFramesThatAllocated()
+		{
+			return lv_totalNumFramesThatAllocated;
+		}
+
+
+		void RecordAllocation(const size_t l_sizeInBytes)
+		{
+			if (false == lv_isCounting.load(std::memory_order_relaxed) || true == lv_isInsideTracker) {
+				return;
+			}
+
+			lv_isInsideTracker = true;
+
+			const LoopPhase lv_phase = lv_currentPhase.load(std::memory_order_relaxed);
+			lv_totalNumAllocationsPerPhase[(uint32_t)lv_phase].fetch_add(1U, std::memory_order_relaxed);
+
+			const uint32_t lv_recordIndex = lv_totalNumRecordedAllocations.fetch_add(1U, std::memory_order_relaxed);
+
+			if (lv_recordIndex < lv_maxNumRecordedCallStacks) {
+				auto& lv_allocation = lv_recordedAllocations[lv_recordIndex];
+				lv_allocation.m_sizeInBytes = l_sizeInBytes;
+				lv_allocation.m_phase = lv_phase;
+				lv_allocation.m_totalNumFrames = CaptureCallStack(lv_allocation.m_callStack);
+			}
+
+			lv_isInsideTracker = false;
+		}
+
+	}
+}
\ No newline at end of file
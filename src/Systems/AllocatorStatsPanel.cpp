@@ -0,0 +1,154 @@
+
+
+
+
+#include "Systems/AllocatorStatsPanel.hpp"
+#include "Systems/LogSystem.hpp"
+#include <imgui.h>
+#include <cassert>
+
+
+
+namespace Asteroid
+{
+
+	void AllocatorStatsPanel::Init(const std::string& l_csvFilePath, const float l_dumpIntervalInSeconds)
+	{
+		using namespace LogSystem;
+
+		m_dumpIntervalInSeconds = l_dumpIntervalInSeconds;
+
+		if (true == l_csvFilePath.empty() || 0.f >= l_dumpIntervalInSeconds) {
+			return;
+		}
+
+		m_csvFile.open(l_csvFilePath, std::ios::out | std::ios::trunc);
+
+		if (false == m_csvFile.is_open()) {
+			LOG(Severity::WARNING, Channel::MEMORY, "Failed to open %s, allocator stats will not be dumped.", l_csvFilePath.c_str());
+			return;
+		}
+
+		m_csvFile << "time_s,allocator,block_size,slabs,blocks,blocks_in_use,high_water_mark,exhausted_allocations"
+			",allocations,frees,live_objects,wasted_bytes,allocations_per_s,frees_per_s\n";
+	}
+
+
+	void AllocatorStatsPanel::AddAllocator(const char* l_name, MemoryAlloc& l_allocator)
+	{
+		assert(m_totalNumAllocators < m_maxNumAllocators);
+
+		auto& lv_trackedAllocator = m_allocators[m_totalNumAllocators++];
+		lv_trackedAllocator.m_name = l_name;
+		lv_trackedAllocator.m_allocator = &l_allocator;
+
+		for (uint32_t i = 0; i < MemoryAlloc::m_totalNumPools; ++i) {
+			lv_trackedAllocator.m_stats[i] = l_allocator.GetStats(i);
+		}
+	}
+
+
+	void AllocatorStatsPanel::Update(const float l_timeInSeconds)
+	{
+		const float lv_elapsedTime = l_timeInSeconds - m_lastSampleTime;
+
+		if (m_sampleIntervalInSeconds > lv_elapsedTime) {
+			return;
+		}
+
+		for (uint32_t i = 0; i < m_totalNumAllocators; ++i) {
+
+			auto& lv_trackedAllocator = m_allocators[i];
+
+			for (uint32_t j = 0; j < MemoryAlloc::m_totalNumPools; ++j) {
+
+				const SizeClassStats lv_stats = lv_trackedAllocator.m_allocator->GetStats(j);
+				const SizeClassStats& lv_previousStats = lv_trackedAllocator.m_stats[j];
+
+				lv_trackedAllocator.m_allocationsPerSecond[j] = (float)(lv_stats.m_totalNumAllocations - lv_previousStats.m_totalNumAllocations) / lv_elapsedTime;
+				lv_trackedAllocator.m_freesPerSecond[j] = (float)(lv_stats.m_totalNumFrees - lv_previousStats.m_totalNumFrees) / lv_elapsedTime;
+				lv_trackedAllocator.m_stats[j] = lv_stats;
+			}
+		}
+
+		m_lastSampleTime = l_timeInSeconds;
+
+		if (true == m_csvFile.is_open() && m_dumpIntervalInSeconds <= l_timeInSeconds - m_lastDumpTime) {
+			DumpToCsv(l_timeInSeconds);
+			m_lastDumpTime = l_timeInSeconds;
+		}
+	}
+
+
+	void AllocatorStatsPanel::DumpToCsv(const float l_timeInSeconds)
+	{
+		for (uint32_t i = 0; i < m_totalNumAllocators; ++i) {
+
+			const auto& lv_trackedAllocator = m_allocators[i];
+
+			for (uint32_t j = 0; j < MemoryAlloc::m_totalNumPools; ++j) {
+
+				const auto& lv_stats = lv_trackedAllocator.m_stats[j];
+
+				m_csvFile << l_timeInSeconds << ',' << lv_trackedAllocator.m_name << ',' << lv_stats.m_pool.m_blockSizeInBytes
+					<< ',' << lv_stats.m_pool.m_totalNumSlabs << ',' << lv_stats.m_pool.m_totalNumBlocks
+					<< ',' << lv_stats.m_pool.m_totalNumBlocksInUse << ',' << lv_stats.m_pool.m_highWaterMarkBlocksInUse
+					<< ',' << lv_stats.m_pool.m_totalNumExhaustedAllocations
+					<< ',' << lv_stats.m_totalNumAllocations << ',' << lv_stats.m_totalNumFrees
+					<< ',' << (lv_stats.m_totalNumAllocations - lv_stats.m_totalNumFrees) << ',' << lv_stats.m_totalNumWastedBytes
+					<< ',' << lv_trackedAllocator.m_allocationsPerSecond[j] << ',' << lv_trackedAllocator.m_freesPerSecond[j] << '\n';
+			}
+		}
+
+		m_csvFile.flush();
+	}
+
+
+	void AllocatorStatsPanel::Render() const
+	{
+		ImGui::Begin("Allocator Stats");
+
+		for (uint32_t i = 0; i < m_totalNumAllocators; ++i) {
+
+			const auto& lv_trackedAllocator = m_allocators[i];
+
+			ImGui::SeparatorText(lv_trackedAllocator.m_name);
+
+			if (false == ImGui::BeginTable(lv_trackedAllocator.m_name, 9, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+				continue;
+			}
+
+			ImGui::TableSetupColumn("Block");
+			ImGui::TableSetupColumn("Slabs");
+			ImGui::TableSetupColumn("In use");
+			ImGui::TableSetupColumn("Peak");
+			ImGui::TableSetupColumn("Exhausted");
+			ImGui::TableSetupColumn("Live");
+			ImGui::TableSetupColumn("Wasted");
+			ImGui::TableSetupColumn("Allocs/s");
+			ImGui::TableSetupColumn("Frees/s");
+			ImGui::TableHeadersRow();
+
+			for (uint32_t j = 0; j < MemoryAlloc::m_totalNumPools; ++j) {
+
+				const auto& lv_stats = lv_trackedAllocator.m_stats[j];
+
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn(); ImGui::Text("%zu B", lv_stats.m_pool.m_blockSizeInBytes);
+				ImGui::TableNextColumn(); ImGui::Text("%u", lv_stats.m_pool.m_totalNumSlabs);
+				ImGui::TableNextColumn(); ImGui::Text("%u / %u", lv_stats.m_pool.m_totalNumBlocksInUse, lv_stats.m_pool.m_totalNumBlocks);
+				ImGui::TableNextColumn(); ImGui::Text("%u", lv_stats.m_pool.m_highWaterMarkBlocksInUse);
+				ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)lv_stats.m_pool.m_totalNumExhaustedAllocations);
+				ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)(lv_stats.m_totalNumAllocations - lv_stats.m_totalNumFrees));
+				ImGui::TableNextColumn(); ImGui::Text("%llu B", (unsigned long long)lv_stats.m_totalNumWastedBytes);
+				ImGui::TableNextColumn(); ImGui::Text("%.1f", lv_trackedAllocator.m_allocationsPerSecond[j]);
+				ImGui::TableNextColumn(); ImGui::Text("%.1f", lv_trackedAllocator.m_freesPerSecond[j]);
+			}
+
+			ImGui::EndTable();
+		}
+
+		ImGui::End();
+	}
+
+}
\ No newline at end of file
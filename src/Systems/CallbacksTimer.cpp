@@ -6,6 +6,7 @@
 
 #include "Systems/CallbacksTimer.hpp"
 #include "Systems/LogSystem.hpp"
+#include <cassert>
 
 
 namespace Asteroid
@@ -18,6 +19,10 @@ namespace Asteroid
 
 	void CallbacksTimer::AddSetStateCallback(DelayedSetStateCallback&& l_delayedCallback)
 	{
+		l_delayedCallback.m_id = m_nextCallbackID;
+		++m_nextCallbackID;
+
+		m_registeredCallbacks.push_back(l_delayedCallback);
 		m_delayedSetStateCallbacks.emplace_back(std::move(l_delayedCallback));
 	}
 
@@ -47,18 +52,73 @@ namespace Asteroid
 	}
 
 
-	const std::vector<DelayedSetStateCallback>& CallbacksTimer::GetDelayedCallbacks() const
+	uint32_t CallbacksTimer::GetDelayedCallbackStates(std::vector<DelayedCallbackState>& l_states) const
 	{
-		return m_delayedSetStateCallbacks;
+		uint32_t lv_oldestID = m_nextCallbackID;
+
+		l_states.resize(m_delayedSetStateCallbacks.size());
+
+		for (size_t i = 0U; i < m_delayedSetStateCallbacks.size(); ++i) {
+			l_states[i].m_id = m_delayedSetStateCallbacks[i].m_id;
+			l_states[i].m_currentFrame = m_delayedSetStateCallbacks[i].m_currentFrame;
+
+			lv_oldestID = (lv_oldestID < l_states[i].m_id) ? lv_oldestID : l_states[i].m_id;
+		}
+
+		return lv_oldestID;
 	}
-	void CallbacksTimer::SetDelayedCallbacks(const std::vector<DelayedSetStateCallback>& l_delayedCallbacks)
+
+
+	void CallbacksTimer::RestoreDelayedCallbacks(const DelayedCallbackState* l_states, const uint32_t l_totalNumStates)
+	{
+		m_delayedSetStateCallbacks.resize(0);
+
+		for (uint32_t i = 0U; i < l_totalNumStates; ++i) {
+
+			assert(l_states[i].m_id >= m_firstRegisteredCallbackID && l_states[i].m_id < m_nextCallbackID);
+
+			auto& lv_delayedCallback = m_delayedSetStateCallbacks.emplace_back(m_registeredCallbacks[l_states[i].m_id - m_firstRegisteredCallbackID]);
+			lv_delayedCallback.m_currentFrame = l_states[i].m_currentFrame;
+		}
+	}
+
+
+	void CallbacksTimer::ReleaseRegisteredCallbacksOlderThan(const uint32_t l_id)
 	{
-		m_delayedSetStateCallbacks = l_delayedCallbacks;
+		while (m_firstRegisteredCallbackID < l_id && false == m_registeredCallbacks.empty()) {
+			m_registeredCallbacks.pop_front();
+			++m_firstRegisteredCallbackID;
+		}
 	}
 
+
+	void CallbacksTimer::CopyPendingCallbacks(std::vector<DelayedSetStateCallback>& l_callbacks) const
+	{
+		l_callbacks = m_delayedSetStateCallbacks;
+	}
+
+
+	void CallbacksTimer::ReplacePendingCallbacks(const std::vector<DelayedSetStateCallback>& l_callbacks)
+	{
+		m_delayedSetStateCallbacks.resize(0);
+
+		for (const auto& l_callback : l_callbacks) {
+
+			auto& lv_delayedCallback = m_delayedSetStateCallbacks.emplace_back(l_callback);
+			lv_delayedCallback.m_id = m_nextCallbackID;
+			++m_nextCallbackID;
+
+			m_registeredCallbacks.push_back(lv_delayedCallback);
+		}
+	}
+
+
 	void CallbacksTimer::FlushAllCallbacks()
 	{
 		m_delayedSetStateCallbacks.resize(0);
+
+		m_registeredCallbacks.clear();
+		m_firstRegisteredCallbackID = m_nextCallbackID;
 	}
 
 }
\ No newline at end of file
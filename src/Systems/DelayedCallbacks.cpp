@@ -0,0 +1,104 @@
+
+
+
+#include "Systems/DelayedCallbacks.hpp"
+#include "Entities/Entity.hpp"
+#include "Components/CollisionComponent.hpp"
+#include "Components/CollisionComponents/PlayerCollisionComponent.hpp"
+#include "Components/IndefiniteRepeatableAnimationComponent.hpp"
+#include "Components/MovementComponent.hpp"
+#include <cassert>
+
+
+namespace Asteroid
+{
+	namespace DelayedCallbacks
+	{
+
+		DelayedSetStateCallback Create(std::vector<Entity>& l_entities, const DelayedCallbackDescriptor& l_descriptor, const uint32_t l_maxNumFrames)
+		{
+			assert(l_descriptor.m_entityID < (uint32_t)l_entities.size());
+
+			DelayedSetStateCallback lv_delayedCallback
+			{
+				.m_maxNumFrames = l_maxNumFrames,
+				.m_descriptor = l_descriptor
+			};
+
+			//The entity is resolved when the callback fires, which does nothing if it was recycled in between.
+			//Only the handle is captured so the callable stays small enough to not allocate.
+			std::vector<Entity>* lv_entities = &l_entities;
+			const Handle<Entity> lv_entityHandle{ l_descriptor.m_entityID, l_descriptor.m_entityGeneration };
+
+			switch (l_descriptor.m_type) {
+
+			case DelayedCallbackType::ACTIVATE_COLLISION:
+			{
+				lv_delayedCallback.m_callback = [lv_entities, lv_entityHandle]() {
+					Entity* lv_entity = Entity::Resolve(*lv_entities, lv_entityHandle);
+					if (nullptr != lv_entity) {
+						lv_entity->Get<CollisionComponent>()->SetCollisionState(true);
+					}
+				};
+				break;
+			}
+			case DelayedCallbackType::DEACTIVATE_COLLISION:
+			{
+				lv_delayedCallback.m_callback = [lv_entities, lv_entityHandle]() {
+					Entity* lv_entity = Entity::Resolve(*lv_entities, lv_entityHandle);
+					if (nullptr != lv_entity) {
+						lv_entity->Get<CollisionComponent>()->SetCollisionState(false);
+					}
+				};
+				break;
+			}
+			case DelayedCallbackType::SHOW_MAIN_ANIMATION:
+			{
+				lv_delayedCallback.m_callback = [lv_entities, lv_entityHandle]() {
+					Entity* lv_entity = Entity::Resolve(*lv_entities, lv_entityHandle);
+					if (nullptr != lv_entity) {
+						lv_entity->Get<IndefiniteRepeatableAnimationComponent>()->SetVisibleState(true);
+					}
+				};
+				break;
+			}
+			case DelayedCallbackType::RESUME_MOVEMENT:
+			{
+				lv_delayedCallback.m_callback = [lv_entities, lv_entityHandle]() {
+					Entity* lv_entity = Entity::Resolve(*lv_entities, lv_entityHandle);
+					if (nullptr != lv_entity) {
+						lv_entity->Get<MovementComponent>()->SetPauseState(false);
+					}
+				};
+				break;
+			}
+			case DelayedCallbackType::DEACTIVATE_ENTITY:
+			{
+				lv_delayedCallback.m_callback = [lv_entities, lv_entityHandle]() {
+					Entity* lv_entity = Entity::Resolve(*lv_entities, lv_entityHandle);
+					if (nullptr != lv_entity) {
+						lv_entity->SetActiveState(false);
+					}
+				};
+				break;
+			}
+			case DelayedCallbackType::ALLOW_PLAYER_COLLISION_AGAIN:
+			{
+				const uint32_t lv_collidedEntityID = l_descriptor.m_argument;
+				lv_delayedCallback.m_callback = [lv_entities, lv_entityHandle, lv_collidedEntityID]() {
+					Entity* lv_entity = Entity::Resolve(*lv_entities, lv_entityHandle);
+					if (nullptr != lv_entity) {
+						lv_entity->Get<PlayerCollisionComponent>()->AllowCollisionAgain(lv_collidedEntityID);
+					}
+				};
+				break;
+			}
+			default:
+				assert(false && "Delayed callbacks without a descriptor cannot be created from one.");
+				break;
+			}
+
+			return lv_delayedCallback;
+		}
+	}
+}
\ No newline at end of file
@@ -44,14 +44,14 @@ namespace Asteroid
 	}
 
 
-	const glm::vec2& EntityConnector::RequestSpeedFromPlayer()
+	float EntityConnector::RequestSpeedFromPlayer()
 	{
 		const auto& lv_entities = m_engine->GetEntities();
 
 		if (m_frequentlyUsedEntityIndices.size() > (uint32_t)CachedEntityIndices::PLAYER_ID) {
 			const auto& lv_player = lv_entities[m_frequentlyUsedEntityIndices[(uint32_t)CachedEntityIndices::PLAYER_ID]];
 
-			MovementComponent* lv_playerMovementComponent = (MovementComponent*)lv_player.GetComponent(ComponentTypes::MOVEMENT);
+			MovementComponent* lv_playerMovementComponent = lv_player.Get<MovementComponent>();
 			return lv_playerMovementComponent->GetSpeed();
 		}
 
@@ -61,7 +61,7 @@ namespace Asteroid
 				if (EntityType::PLAYER == l_entity.GetType()) {
 					m_frequentlyUsedEntityIndices.push_back(l_entity.GetID());
 
-					MovementComponent* lv_playerMovementComponent = (MovementComponent*)l_entity.GetComponent(ComponentTypes::MOVEMENT);
+					MovementComponent* lv_playerMovementComponent = l_entity.Get<MovementComponent>();
 					return lv_playerMovementComponent->GetSpeed();
 				}
 			}
@@ -78,7 +78,7 @@ namespace Asteroid
 		if (m_frequentlyUsedEntityIndices.size() > (uint32_t)CachedEntityIndices::PLAYER_ID) {
 			const auto& lv_player = lv_entities[m_frequentlyUsedEntityIndices[(uint32_t)CachedEntityIndices::PLAYER_ID]];
 
-			MovementComponent* lv_playerMovementComponent = (MovementComponent*)lv_player.GetComponent(ComponentTypes::MOVEMENT);
+			MovementComponent* lv_playerMovementComponent = lv_player.Get<MovementComponent>();
 			return lv_playerMovementComponent->GetCurrentAngleOfRotation();
 		}
 
@@ -88,7 +88,7 @@ namespace Asteroid
 				if (EntityType::PLAYER == l_entity.GetType()) {
 					m_frequentlyUsedEntityIndices.push_back(l_entity.GetID());
 					
-					MovementComponent* lv_playerMovementComponent = (MovementComponent*)l_entity.GetComponent(ComponentTypes::MOVEMENT);
+					MovementComponent* lv_playerMovementComponent = l_entity.Get<MovementComponent>();
 					return lv_playerMovementComponent->GetCurrentAngleOfRotation();
 				}
 			}
@@ -4,6 +4,7 @@
 
 
 #include "Systems/EventSystem/EventCollision.hpp"
+#include "Entities/Entity.hpp"
 
 
 
@@ -11,12 +12,14 @@
 namespace Asteroid
 {
 
-	EventCollision::EventCollision(Entity* l_entity1
-		, Entity* l_entity2
+	EventCollision::EventCollision(const Handle<Entity> l_entity1
+		, const Handle<Entity> l_entity2
+		, std::vector<Entity>* l_entities
 		, CallbacksTimer* l_callbackTimer)
-		:m_entity1(l_entity1)
+		:m_callbackTimer(l_callbackTimer)
+		,m_entity1(l_entity1)
 		,m_entity2(l_entity2)
-		,m_callbackTimer(l_callbackTimer)
+		,m_entities(l_entities)
 	{
 
 	}
@@ -24,11 +27,16 @@ namespace Asteroid
 
 	Entity* EventCollision::GetEntity1()
 	{
-		return m_entity1;
+		return Entity::Resolve(*m_entities, m_entity1);
 	}
 	Entity* EventCollision::GetEntity2()
 	{
-		return m_entity2;
+		return Entity::Resolve(*m_entities, m_entity2);
+	}
+
+	std::vector<Entity>& EventCollision::GetEntities()
+	{
+		return *m_entities;
 	}
 
 	std::string EventCollision::GetName() const
@@ -13,6 +13,14 @@
 namespace Asteroid
 {
 
+	EventManager::EventManager(std::pmr::memory_resource* l_memoryResource)
+		:m_eventTypesMappedToTheirDelegates(l_memoryResource)
+		,m_eventQueues{ std::pmr::unordered_map<EventType,EventType>(l_memoryResource), std::pmr::unordered_map<EventType,EventType>(l_memoryResource) }
+	{
+
+	}
+
+
 	void EventManager::AssociateNewDelegateToEventType(const EventType l_eventType, std::function<void()>&& l_delegate)
 	{
 		auto lv_eventTypeDelegatesPair = m_eventTypesMappedToTheirDelegates.find(l_eventType);
@@ -22,7 +30,7 @@ namespace Asteroid
 		}
 		else {
 			
-			auto lv_newpair = m_eventTypesMappedToTheirDelegates.emplace(l_eventType, std::vector<std::function<void()>>{});
+			auto lv_newpair = m_eventTypesMappedToTheirDelegates.emplace(l_eventType, std::pmr::vector<std::function<void()>>{});
 			
 			if (false == lv_newpair.second) {
 				throw std::runtime_error("Failed to emplace new pair into mapping of event types to their delegates");
@@ -62,7 +70,8 @@ namespace Asteroid
 					lv_callbackToExec();
 				}
 
-				m_eventTypesMappedToTheirDelegates.erase(lv_eventTypeDelegatesPair);
+				//Keeps the capacity so registering delegates does not allocate every frame.
+				lv_eventTypeDelegatesPair->second.clear();
 
 			}
 
@@ -91,6 +100,11 @@ namespace Asteroid
 			lv_tempIter = lv_prevQueue.erase(lv_tempIter);
 		}
 
+		//Delegates of the flushed events point into the frame arena, which is reset along with the queues.
+		for (auto& l_eventTypeDelegatesPair : m_eventTypesMappedToTheirDelegates) {
+			l_eventTypeDelegatesPair.second.clear();
+		}
+
 	}
 
 }
\ No newline at end of file
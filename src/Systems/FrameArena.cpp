@@ -0,0 +1,107 @@
+
+
+
+
+#include "Systems/FrameArena.hpp"
+#include "Systems/LogSystem.hpp"
+#include <cstring>
+#include <cassert>
+#include <algorithm>
+
+
+
+namespace Asteroid
+{
+
+	void FrameArena::Init(const size_t l_sizeInBytes)
+	{
+		m_buffer = std::make_unique<unsigned char[]>(l_sizeInBytes);
+		m_capacityInBytes = l_sizeInBytes;
+		m_offset = 0U;
+		m_overflowChunks.clear();
+		m_numOverflowBytes = 0U;
+	}
+
+
+	void* FrameArena::Allocate(const size_t l_sizeInBytes, const size_t l_alignment)
+	{
+		assert(0U != l_alignment && 0U == (l_alignment & (l_alignment - 1U)));
+		assert(l_alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+		const size_t lv_alignedOffset = (m_offset + l_alignment - 1U) & ~(l_alignment - 1U);
+
+		if (lv_alignedOffset + l_sizeInBytes <= m_capacityInBytes) {
+			m_offset = lv_alignedOffset + l_sizeInBytes;
+			return m_buffer.get() + lv_alignedOffset;
+		}
+
+		using namespace LogSystem;
+
+		LOG(Severity::WARNING, Channel::MEMORY, "Frame arena of %zu bytes is full, allocating %zu bytes on the heap for the rest of the frame.", m_capacityInBytes, l_sizeInBytes);
+
+		m_overflowChunks.emplace_back(std::make_unique<unsigned char[]>(l_sizeInBytes));
+		m_numOverflowBytes += l_sizeInBytes;
+
+		return m_overflowChunks.back().get();
+	}
+
+
+	void FrameArena::Reset()
+	{
+#ifdef DEBUG
+		std::memset(m_buffer.get(), m_poisonValue, m_offset);
+#endif
+
+		if (false == m_overflowChunks.empty()) {
+			const size_t lv_newCapacity = std::max(m_capacityInBytes * 2U, m_capacityInBytes + m_numOverflowBytes);
+			Init(lv_newCapacity);
+			return;
+		}
+
+		m_offset = 0U;
+	}
+
+
+	size_t FrameArena::GetCapacityInBytes() const
+	{
+		return m_capacityInBytes;
+	}
+
+
+	size_t FrameArena::GetNumBytesAllocated() const
+	{
+		return m_offset + m_numOverflowBytes;
+	}
+
+
+
+	void DoubleBufferedFrameArena::Init(const size_t l_sizeInBytesPerArena)
+	{
+		for (auto& l_arena : m_arenas) {
+			l_arena.Init(l_sizeInBytesPerArena);
+		}
+		m_currentArenaIndex = 0U;
+	}
+
+
+	void DoubleBufferedFrameArena::SwapAndReset()
+	{
+		m_currentArenaIndex = (m_currentArenaIndex + 1U) % (uint32_t)m_arenas.size();
+		m_arenas[m_currentArenaIndex].Reset();
+	}
+
+
+	void DoubleBufferedFrameArena::ResetAll()
+	{
+		for (auto& l_arena : m_arenas) {
+			l_arena.Reset();
+		}
+	}
+
+
+	FrameArena& DoubleBufferedFrameArena::GetCurrent()
+	{
+		return m_arenas[m_currentArenaIndex];
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,258 @@
+
+
+
+#include "Systems/GameSave.hpp"
+#include "Systems/TimeRewind/Frame.hpp"
+#include "Systems/TimeRewind/FrameState.hpp"
+#include "Systems/TimeRewind/EntityMetaData.hpp"
+#include "Systems/DelayedCallbacks.hpp"
+#include "Systems/CallbacksTimer.hpp"
+#include "Systems/MappedFile.hpp"
+#include "Systems/SnapshotWriter.hpp"
+#include "Systems/SnapshotReader.hpp"
+#include "Systems/LogSystem.hpp"
+#include "Entities/Entity.hpp"
+#include "Entities/EntitySpawnerFromPools.hpp"
+#include <bitset>
+#include <random>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+
+namespace Asteroid
+{
+
+	/*
+	* Layout of a save:
+	* [GameSaveHeader][SavedDelayedCallback * m_totalNumPendingCallbacks]
+	* [snapshot of the active entities][spawner pools snapshot][random engine state as text]
+	* 
+	* The entities snapshot has the same layout as the one time rewind records for a frame.
+	*/
+	struct GameSaveHeader final
+	{
+		static constexpr uint32_t m_expectedMagic{ 0x56534741U };
+		static constexpr uint32_t m_currentVersion{ 4U };
+
+		uint32_t m_magic{ m_expectedMagic };
+		uint32_t m_version{ m_currentVersion };
+
+		uint32_t m_level{};
+		float m_time{};
+		uint32_t m_totalNumAsteroidsHitByBullets{};
+
+		std::bitset<FrameHeader::m_maxNumEntities> m_activeEntities{};
+		uint32_t m_totalNumActiveEntities{};
+
+		uint32_t m_totalNumPendingCallbacks{};
+		uint32_t m_entitiesSnapshotSizeInBytes{};
+		uint32_t m_poolsSnapshotSizeInBytes{};
+		uint32_t m_randomEngineStateSizeInBytes{};
+	};
+
+
+	struct SavedDelayedCallback final
+	{
+		DelayedCallbackDescriptor m_descriptor{};
+		uint32_t m_currentFrame{};
+		uint32_t m_maxNumFrames{};
+	};
+
+
+	namespace GameSave
+	{
+
+		bool Capture(const std::vector<Entity>& l_entities, const CallbacksTimer& l_callbacksTimer, const EntitySpawnerFromPools& l_spawner
+			, const GameSaveLevelState& l_levelState, std::vector<uint8_t>& l_save)
+		{
+			using namespace LogSystem;
+
+			std::vector<DelayedSetStateCallback> lv_pendingCallbacks{};
+			l_callbacksTimer.CopyPendingCallbacks(lv_pendingCallbacks);
+
+			l_save.clear();
+			l_save.resize(sizeof(GameSaveHeader));
+
+			SnapshotWriter lv_writer{ l_save };
+
+			for (const auto& l_callback : lv_pendingCallbacks) {
+
+				if (DelayedCallbackType::NONE == l_callback.m_descriptor.m_type) {
+					LOG(Severity::WARNING, Channel::PROGRAM_LOGIC, "The game was not saved since one of the pending callbacks cannot be saved.");
+					l_save.clear();
+					return false;
+				}
+
+				lv_writer.Write(SavedDelayedCallback{ .m_descriptor = l_callback.m_descriptor, .m_currentFrame = l_callback.m_currentFrame, .m_maxNumFrames = l_callback.m_maxNumFrames });
+			}
+
+			GameSaveHeader lv_header{};
+			lv_header.m_level = l_levelState.m_level;
+			lv_header.m_time = l_levelState.m_time;
+			lv_header.m_totalNumAsteroidsHitByBullets = l_levelState.m_totalNumAsteroidsHitByBullets;
+			lv_header.m_totalNumPendingCallbacks = (uint32_t)lv_pendingCallbacks.size();
+
+			size_t lv_sectionStart = l_save.size();
+
+			for (size_t i = 0; i < l_entities.size(); ++i) {
+
+				if (false == l_entities[i].GetActiveState()) {
+					continue;
+				}
+
+				lv_header.m_activeEntities.set(i);
+				++lv_header.m_totalNumActiveEntities;
+
+				l_entities[i].Snapshot(lv_writer);
+			}
+
+			lv_header.m_entitiesSnapshotSizeInBytes = (uint32_t)(l_save.size() - lv_sectionStart);
+			lv_sectionStart = l_save.size();
+
+			l_spawner.SnapshotPools(lv_writer);
+
+			lv_header.m_poolsSnapshotSizeInBytes = (uint32_t)(l_save.size() - lv_sectionStart);
+
+			std::ostringstream lv_randomEngineState{};
+			lv_randomEngineState << l_spawner.GetRandomEngine();
+			const std::string lv_randomEngineStateText = lv_randomEngineState.str();
+
+			lv_writer.WriteBytes(lv_randomEngineStateText.data(), lv_randomEngineStateText.size());
+			lv_header.m_randomEngineStateSizeInBytes = (uint32_t)lv_randomEngineStateText.size();
+
+			std::memcpy(l_save.data(), &lv_header, sizeof(GameSaveHeader));
+
+			return true;
+		}
+
+
+		bool Apply(const uint8_t* l_save, const size_t l_sizeInBytes, std::vector<Entity>& l_entities, CallbacksTimer& l_callbacksTimer
+			, EntitySpawnerFromPools& l_spawner, GameSaveLevelState& l_levelState)
+		{
+			using namespace LogSystem;
+
+			if (nullptr == l_save || l_sizeInBytes < sizeof(GameSaveHeader)) {
+				return false;
+			}
+
+			GameSaveHeader lv_header{};
+			std::memcpy(&lv_header, l_save, sizeof(GameSaveHeader));
+
+			const size_t lv_expectedSizeInBytes = sizeof(GameSaveHeader)
+				+ sizeof(SavedDelayedCallback) * (size_t)lv_header.m_totalNumPendingCallbacks
+				+ lv_header.m_entitiesSnapshotSizeInBytes
+				+ lv_header.m_poolsSnapshotSizeInBytes
+				+ lv_header.m_randomEngineStateSizeInBytes;
+
+			if (GameSaveHeader::m_expectedMagic != lv_header.m_magic || GameSaveHeader::m_currentVersion != lv_header.m_version
+				|| lv_expectedSizeInBytes != l_sizeInBytes || l_entities.size() > FrameHeader::m_maxNumEntities) {
+				LOG(Severity::WARNING, Channel::PROGRAM_LOGIC, "The save is either corrupted or from another version of the game.");
+				return false;
+			}
+
+			SnapshotReader lv_reader{ l_save + sizeof(GameSaveHeader), l_sizeInBytes - sizeof(GameSaveHeader) };
+
+			std::vector<SavedDelayedCallback> lv_savedCallbacks(lv_header.m_totalNumPendingCallbacks);
+			lv_reader.ReadArray(lv_savedCallbacks.data(), lv_header.m_totalNumPendingCallbacks);
+
+			for (const auto& l_savedCallback : lv_savedCallbacks) {
+				if (l_savedCallback.m_descriptor.m_entityID >= (uint32_t)l_entities.size() || DelayedCallbackType::NONE == l_savedCallback.m_descriptor.m_type
+					|| l_savedCallback.m_descriptor.m_type > DelayedCallbackType::ALLOW_PLAYER_COLLISION_AGAIN) {
+					LOG(Severity::WARNING, Channel::PROGRAM_LOGIC, "The save has a pending callback that does not belong to this game.");
+					return false;
+				}
+			}
+
+			const uint8_t* lv_entitiesSnapshot = l_save + sizeof(GameSaveHeader) + sizeof(SavedDelayedCallback) * (size_t)lv_header.m_totalNumPendingCallbacks;
+
+			if (false == FrameState::ValidateSnapshot(lv_header.m_activeEntities, lv_header.m_totalNumActiveEntities, lv_entitiesSnapshot
+				, lv_header.m_entitiesSnapshotSizeInBytes, l_entities)) {
+				LOG(Severity::WARNING, Channel::PROGRAM_LOGIC, "The save has an entity that does not belong to this game.");
+				return false;
+			}
+
+			SnapshotReader lv_poolsReader{ lv_entitiesSnapshot + lv_header.m_entitiesSnapshotSizeInBytes, lv_header.m_poolsSnapshotSizeInBytes };
+
+			if (false == l_spawner.ValidatePoolsSnapshot(lv_poolsReader)) {
+				LOG(Severity::WARNING, Channel::PROGRAM_LOGIC, "The save has entity pools that do not belong to this game.");
+				return false;
+			}
+
+			l_levelState.m_level = lv_header.m_level;
+			l_levelState.m_time = lv_header.m_time;
+			l_levelState.m_totalNumAsteroidsHitByBullets = lv_header.m_totalNumAsteroidsHitByBullets;
+
+			for (size_t i = 0; i < l_entities.size(); ++i) {
+				if (false == lv_header.m_activeEntities.test(i) && true == l_entities[i].GetActiveState()) {
+					FrameState::DeactivateEntity(l_entities[i]);
+				}
+			}
+
+			for (uint32_t i = 0; i < lv_header.m_totalNumActiveEntities; ++i) {
+
+				EntityMetaData lv_entityMetaData{};
+				lv_reader.Peek(lv_entityMetaData);
+
+				auto& lv_entity = l_entities[lv_entityMetaData.m_id];
+
+				lv_entity.SetActiveState(true);
+				lv_entity.Restore(lv_reader);
+			}
+
+			l_spawner.RestorePools(lv_reader);
+
+			std::string lv_randomEngineStateText(lv_header.m_randomEngineStateSizeInBytes, '\0');
+			lv_reader.ReadBytes(lv_randomEngineStateText.data(), lv_header.m_randomEngineStateSizeInBytes);
+
+			std::istringstream lv_randomEngineState{ lv_randomEngineStateText };
+			std::mt19937 lv_randomEngine{};
+			lv_randomEngineState >> lv_randomEngine;
+			l_spawner.SetRandomEngine(lv_randomEngine);
+
+			//The callables are built again from their descriptors since the ones that were saved pointed into another run.
+			std::vector<DelayedSetStateCallback> lv_pendingCallbacks{};
+			lv_pendingCallbacks.reserve(lv_savedCallbacks.size());
+
+			for (const auto& l_savedCallback : lv_savedCallbacks) {
+				auto& lv_callback = lv_pendingCallbacks.emplace_back(DelayedCallbacks::Create(l_entities
+					, l_savedCallback.m_descriptor, l_savedCallback.m_maxNumFrames));
+				lv_callback.m_currentFrame = l_savedCallback.m_currentFrame;
+			}
+
+			l_callbacksTimer.ReplacePendingCallbacks(lv_pendingCallbacks);
+
+			return true;
+		}
+
+
+		bool WriteToFile(const std::string& l_filePath, const std::vector<uint8_t>& l_save)
+		{
+			using namespace LogSystem;
+
+			std::ofstream lv_file{ l_filePath, std::ios::binary | std::ios::trunc };
+
+			if (false == lv_file.is_open()) {
+				LOG(Severity::WARNING, Channel::PROGRAM_LOGIC, "Failed to open the save file %s for writing.", l_filePath.c_str());
+				return false;
+			}
+
+			lv_file.write((const char*)l_save.data(), l_save.size());
+
+			return true == lv_file.good();
+		}
+
+
+		bool LoadFromFile(const std::string& l_filePath, std::vector<Entity>& l_entities, CallbacksTimer& l_callbacksTimer
+			, EntitySpawnerFromPools& l_spawner, GameSaveLevelState& l_levelState)
+		{
+			MappedFile lv_file{};
+
+			if (false == lv_file.OpenForReading(l_filePath)) {
+				return false;
+			}
+
+			return Apply(lv_file.GetData(), lv_file.GetSizeInBytes(), l_entities, l_callbacksTimer, l_spawner, l_levelState);
+		}
+	}
+}
\ No newline at end of file
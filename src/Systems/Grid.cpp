@@ -15,7 +15,9 @@
 #include "Components/StateComponents/ActiveBasedStateComponent.hpp"
 #include "Systems/EventSystem/EventManager.hpp"
 #include "Systems/LogSystem.hpp"
-#include "Systems/MemoryAlloc.hpp"
+#include "Systems/FrameArena.hpp"
+#include "Systems/JobSystem.hpp"
+#include "Entities/ArchetypeTable.hpp"
 #include "Systems/EventSystem/EventCollision.hpp"
 
 namespace Asteroid
@@ -44,7 +46,7 @@ namespace Asteroid
 	}
 
 
-	void Grid::Update(const glm::ivec2& l_currentWindowSize, const std::vector<Circle>& l_circleBounds, const std::vector<Entity>& l_entities)
+	void Grid::Update(const glm::ivec2& l_currentWindowSize, const std::vector<Circle>& l_circleBounds, const std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, JobSystem& l_jobSystem)
 	{
 		memset(m_cells.data(), 0, sizeof(uint32_t) * m_cells.size());
 		memset(m_centerPosOfCells.data(), 0, sizeof(float)*m_centerPosOfCells.size());
@@ -66,40 +68,46 @@ namespace Asteroid
 		}
 
 
-		for (uint32_t j = 0; j < m_totalNumDivisionsY; ++j) {
-			for (uint32_t i = 0; i < m_totalNumDivisionsX; ++i) {
+		auto lv_fillCells = [&](const uint32_t l_firstCell, const uint32_t l_endCell) -> void
+		{
+			for (uint32_t lv_cell = l_firstCell; lv_cell < l_endCell; ++lv_cell) {
+
+				const uint32_t i = lv_cell % m_totalNumDivisionsX;
+				const uint32_t j = lv_cell / m_totalNumDivisionsX;
 
 				const Rectangle lv_currentCellRectangle
 				{ .m_min{m_cellWidth * (i), m_cellHeight * (j)}
 				, .m_max{m_cellWidth*(i+1), m_cellHeight*(j+1)}};
 
-				for (uint32_t z = 0; z < (uint32_t)l_circleBounds.size(); ++z) {
-
-					CollisionComponent* lv_collisionComp = (CollisionComponent*)l_entities[z].GetComponent(ComponentTypes::COLLISION);
-					if (nullptr == lv_collisionComp) { continue; }
-					if (true == l_entities[z].GetActiveState() && true == lv_collisionComp->GetCollisionState()) {
-						if (true == CircleRectangleIntersection(l_circleBounds[z], lv_currentCellRectangle)) {
+				l_archetypes.ForEachActiveEntity([&](const uint32_t z) -> void
+					{
+						CollisionComponent* lv_collisionComp = l_entities[z].Get<CollisionComponent>();
+						if (nullptr == lv_collisionComp) { return; }
+						if (true == lv_collisionComp->GetCollisionState()) {
+							if (true == CircleRectangleIntersection(l_circleBounds[z], lv_currentCellRectangle)) {
 
-							const uint32_t lv_quotient = z / 32U;
-							const uint32_t lv_bitPlace = z % 32U;
+								const uint32_t lv_quotient = z / 32U;
+								const uint32_t lv_bitPlace = z % 32U;
 
-							const uint32_t lv_indexOfFirstUint32Cell = (j * m_totalNumDivisionsX + i) * m_totalNumUint32PerCell;
+								const uint32_t lv_indexOfFirstUint32Cell = lv_cell * m_totalNumUint32PerCell;
 
-							m_cells[lv_indexOfFirstUint32Cell + lv_quotient] |= (1 << lv_bitPlace);
+								m_cells[lv_indexOfFirstUint32Cell + lv_quotient] |= (1 << lv_bitPlace);
 
+							}
 						}
-					}
-
-				}
-
+					});
 			}
-		}
+		};
+
+		JobCounter lv_counter{};
+		l_jobSystem.ParallelFor(m_currentMaxNumCells, m_totalNumCellsPerJob, lv_fillCells, lv_counter);
+		l_jobSystem.Wait(lv_counter);
 
 	}
 
 
 
-	void Grid::DoCollisionDetection(const std::vector<Circle>& l_circleBounds, std::vector<Entity>& l_entities, CallbacksTimer& l_timer, EventManager& l_eventManager, MemoryAlloc& l_memAlloc)
+	void Grid::DoCollisionDetection(const std::vector<Circle>& l_circleBounds, std::vector<Entity>& l_entities, CallbacksTimer& l_timer, EventManager& l_eventManager, FrameArena& l_frameArena)
 	{
 
 		using namespace LogSystem;
@@ -123,8 +131,7 @@ namespace Asteroid
 				for (uint32_t k = 0; k < lv_temp; ++k) {
 
 					const auto& lv_circle1 = l_circleBounds[m_allIndicesInOneCell[k]];
-					CollisionComponent* lv_collisionComponentEntityK = (CollisionComponent*)l_entities[m_allIndicesInOneCell[k]].GetComponent(ComponentTypes::COLLISION);
-					assert(nullptr != lv_collisionComponentEntityK);
+					assert(nullptr != l_entities[m_allIndicesInOneCell[k]].Get<CollisionComponent>());
 					for (uint32_t d = k + 1; d < lv_temp; ++d) {
 
 						const auto& lv_circle2 = l_circleBounds[m_allIndicesInOneCell[d]];
@@ -133,19 +140,24 @@ namespace Asteroid
 
 						if (glm::dot(lv_differenceVector, lv_differenceVector) <= (lv_sumOfRadiuses* lv_sumOfRadiuses)) {
 							
-							CollisionComponent* lv_collisionComponentEntityD = (CollisionComponent*)l_entities[m_allIndicesInOneCell[d]].GetComponent(ComponentTypes::COLLISION);
-
-
-							EventCollision* lv_collisionEvent = static_cast<EventCollision*>(l_memAlloc.Allocate(sizeof(EventCollision)));
-							lv_collisionEvent = new(lv_collisionEvent) EventCollision(&l_entities[m_allIndicesInOneCell[d]], &l_entities[m_allIndicesInOneCell[k]], &l_timer);
+							EventCollision* lv_collisionEvent = l_frameArena.Create<EventCollision>(l_entities[m_allIndicesInOneCell[d]].GetHandle()
+								, l_entities[m_allIndicesInOneCell[k]].GetHandle(), &l_entities, &l_timer);
 
+							//Only the event is captured so the closure fits in the small buffer of std::function.
+							//The event lives in the frame arena and is never destroyed explicitly.
 							std::function<void()> lv_collisionDelegate{
-								[lv_collisionComponentEntityK, lv_collisionComponentEntityD, lv_collisionEvent, &l_memAlloc]() -> void
+								[lv_collisionEvent]() -> void
 								{
-									lv_collisionComponentEntityD->CollisionReaction(lv_collisionEvent);
-									lv_collisionComponentEntityK->CollisionReaction(lv_collisionEvent);
+									Entity* lv_entity1 = lv_collisionEvent->GetEntity1();
+									Entity* lv_entity2 = lv_collisionEvent->GetEntity2();
+
+									//One of them was recycled after the collision, so it is not the one that collided.
+									if (nullptr == lv_entity1 || nullptr == lv_entity2) {
+										return;
+									}
 
-									l_memAlloc.Destruct<EventCollision>(lv_collisionEvent, sizeof(EventCollision));
+									lv_entity1->Get<CollisionComponent>()->CollisionReaction(lv_collisionEvent);
+									lv_entity2->Get<CollisionComponent>()->CollisionReaction(lv_collisionEvent);
 								}
 							};
 
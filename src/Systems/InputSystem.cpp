@@ -54,6 +54,12 @@ namespace Asteroid
 		if (true == lv_keyStates[SDL_SCANCODE_T]) {
 			m_keyStates[(int)Keys::KEY_T] = KeyStates::KEY_DOWN_REPETITION_ALLOWED;
 		}
+		if (true == lv_keyStates[SDL_SCANCODE_F5]) {
+			m_keyStates[(int)Keys::KEY_F5] = KeyStates::KEY_DOWN_REPETITION_ALLOWED;
+		}
+		if (true == lv_keyStates[SDL_SCANCODE_F9]) {
+			m_keyStates[(int)Keys::KEY_F9] = KeyStates::KEY_DOWN_REPETITION_ALLOWED;
+		}
 
 
 
@@ -83,6 +89,12 @@ namespace Asteroid
 			if (SDL_SCANCODE_T == l_event.key.scancode && false == l_event.key.repeat) {
 				m_notAllowedRepetitionKeys[(int)Keys::KEY_T] = true;
 			}
+			if (SDL_SCANCODE_F5 == l_event.key.scancode && false == l_event.key.repeat) {
+				m_notAllowedRepetitionKeys[(int)Keys::KEY_F5] = true;
+			}
+			if (SDL_SCANCODE_F9 == l_event.key.scancode && false == l_event.key.repeat) {
+				m_notAllowedRepetitionKeys[(int)Keys::KEY_F9] = true;
+			}
 
 		}
 
@@ -114,6 +126,12 @@ namespace Asteroid
 			if (SDL_SCANCODE_T == l_event.key.scancode) {
 				m_keyStates[(int)Keys::KEY_T] = KeyStates::KEY_UP;
 			}
+			if (SDL_SCANCODE_F5 == l_event.key.scancode) {
+				m_keyStates[(int)Keys::KEY_F5] = KeyStates::KEY_UP;
+			}
+			if (SDL_SCANCODE_F9 == l_event.key.scancode) {
+				m_keyStates[(int)Keys::KEY_F9] = KeyStates::KEY_UP;
+			}
 
 		}
 
@@ -271,6 +289,69 @@ namespace Asteroid
 		m_mouseHidden = l_isHidden;
 	}
 
+	void InputSystem::GetInputFrame(InputFrame& l_inputFrame) const
+	{
+		l_inputFrame.m_keysDown = 0U;
+		l_inputFrame.m_keysUp = 0U;
+		l_inputFrame.m_keysPressedThisFrame = 0U;
+
+		for (uint32_t i = 0; i < m_totalNumRecordedKeys; ++i) {
+
+			if (KeyStates::KEY_DOWN_REPETITION_ALLOWED == m_keyStates[i]) {
+				l_inputFrame.m_keysDown |= (uint16_t)(1U << i);
+			}
+			if (KeyStates::KEY_UP == m_keyStates[i]) {
+				l_inputFrame.m_keysUp |= (uint16_t)(1U << i);
+			}
+			if (true == m_notAllowedRepetitionKeys[i]) {
+				l_inputFrame.m_keysPressedThisFrame |= (uint16_t)(1U << i);
+			}
+		}
+
+		l_inputFrame.m_mouseButtonsPressed = 0U;
+		l_inputFrame.m_mouseButtonsUp = 0U;
+
+		for (uint32_t i = 0; i < (uint32_t)m_mouseStatesPressed.size(); ++i) {
+			l_inputFrame.m_mouseButtonsPressed |= (uint8_t)((true == m_mouseStatesPressed[i]) ? 1U << i : 0U);
+			l_inputFrame.m_mouseButtonsUp |= (uint8_t)((true == m_mouseStatesUp[i]) ? 1U << i : 0U);
+		}
+
+		l_inputFrame.m_totalNumLeftMouseClicks = m_totalNumLeftMouseClicks;
+		l_inputFrame.m_totalNumRightMouseClicks = m_totalNumRightMouseClicks;
+		l_inputFrame.m_isMouseHidden = m_mouseHidden;
+		l_inputFrame.m_mousePos = m_mousePosRelToWindow;
+	}
+
+
+	void InputSystem::SetInputFrame(const InputFrame& l_inputFrame)
+	{
+		memset(m_keyStates.data(), (int)KeyStates::INVALID, sizeof(KeyStates) * m_keyStates.size());
+		memset(m_notAllowedRepetitionKeys.data(), 0, sizeof(bool) * m_notAllowedRepetitionKeys.size());
+
+		for (uint32_t i = 0; i < m_totalNumRecordedKeys; ++i) {
+
+			if (0U != (l_inputFrame.m_keysDown & (1U << i))) {
+				m_keyStates[i] = KeyStates::KEY_DOWN_REPETITION_ALLOWED;
+			}
+			if (0U != (l_inputFrame.m_keysUp & (1U << i))) {
+				m_keyStates[i] = KeyStates::KEY_UP;
+			}
+
+			m_notAllowedRepetitionKeys[i] = (0U != (l_inputFrame.m_keysPressedThisFrame & (1U << i)));
+		}
+
+		for (uint32_t i = 0; i < (uint32_t)m_mouseStatesPressed.size(); ++i) {
+			m_mouseStatesPressed[i] = (0U != (l_inputFrame.m_mouseButtonsPressed & (1U << i)));
+			m_mouseStatesUp[i] = (0U != (l_inputFrame.m_mouseButtonsUp & (1U << i)));
+		}
+
+		m_totalNumLeftMouseClicks = l_inputFrame.m_totalNumLeftMouseClicks;
+		m_totalNumRightMouseClicks = l_inputFrame.m_totalNumRightMouseClicks;
+		m_mouseHidden = l_inputFrame.m_isMouseHidden;
+		m_mousePosRelToWindow = l_inputFrame.m_mousePos;
+	}
+
+
 	bool InputSystem::IsMouseButtonPressed(const Mouse l_mouseButton) const
 	{
 		if (true == m_mouseStatesPressed[(int)l_mouseButton]) {
@@ -0,0 +1,96 @@
+
+
+#include "Systems/JobDeque.hpp"
+
+
+namespace Asteroid
+{
+
+	bool JobDeque::Push(const Job& l_job)
+	{
+		const int64_t lv_bottom = m_bottom.load(std::memory_order_relaxed);
+		const int64_t lv_top = m_top.load(std::memory_order_acquire);
+
+		if ((int64_t)m_capacity <= lv_bottom - lv_top) {
+			return false;
+		}
+
+		Write(m_jobs[lv_bottom & m_mask], l_job);
+		m_bottom.store(lv_bottom + 1, std::memory_order_release);
+
+		return true;
+	}
+
+
+	bool JobDeque::Pop(Job& l_job)
+	{
+		const int64_t lv_bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		m_bottom.store(lv_bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t lv_top = m_top.load(std::memory_order_relaxed);
+
+		if (lv_top > lv_bottom) {
+			m_bottom.store(lv_bottom + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		l_job = Read(m_jobs[lv_bottom & m_mask]);
+
+		if (lv_top < lv_bottom) {
+			return true;
+		}
+
+		//The last job can be stolen at the same time, whoever moves the top first gets it.
+		const bool lv_taken = m_top.compare_exchange_strong(lv_top, lv_top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		m_bottom.store(lv_bottom + 1, std::memory_order_relaxed);
+
+		return lv_taken;
+	}
+
+
+	bool JobDeque::Steal(Job& l_job)
+	{
+		int64_t lv_top = m_top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64_t lv_bottom = m_bottom.load(std::memory_order_acquire);
+
+		if (lv_top >= lv_bottom) {
+			return false;
+		}
+
+		//Copied before the top is moved. Once it is, the owner may reuse the slot right away.
+		//If another thread moved it first the copy is thrown away.
+		const Job lv_job = Read(m_jobs[lv_top & m_mask]);
+
+		if (false == m_top.compare_exchange_strong(lv_top, lv_top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return false;
+		}
+
+		l_job = lv_job;
+
+		return true;
+	}
+
+
+	void JobDeque::Write(JobSlot& l_slot, const Job& l_job)
+	{
+		l_slot.m_function.store(l_job.m_function, std::memory_order_relaxed);
+		l_slot.m_data.store(l_job.m_data, std::memory_order_relaxed);
+		l_slot.m_begin.store(l_job.m_begin, std::memory_order_relaxed);
+		l_slot.m_end.store(l_job.m_end, std::memory_order_relaxed);
+		l_slot.m_counter.store(l_job.m_counter, std::memory_order_relaxed);
+	}
+
+
+	Job JobDeque::Read(const JobSlot& l_slot)
+	{
+		return Job
+		{
+			.m_function = l_slot.m_function.load(std::memory_order_relaxed),
+			.m_data = l_slot.m_data.load(std::memory_order_relaxed),
+			.m_begin = l_slot.m_begin.load(std::memory_order_relaxed),
+			.m_end = l_slot.m_end.load(std::memory_order_relaxed),
+			.m_counter = l_slot.m_counter.load(std::memory_order_relaxed)
+		};
+	}
+}
\ No newline at end of file
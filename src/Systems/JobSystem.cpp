@@ -0,0 +1,269 @@
+
+
+#include "Systems/JobSystem.hpp"
+#include "Systems/LogSystem.hpp"
+#include <chrono>
+#include <algorithm>
+#include <cassert>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+namespace Asteroid
+{
+
+	static constexpr uint32_t lv_invalidThreadIndex{ UINT32_MAX };
+
+	static thread_local uint32_t lv_currentThreadIndex{ lv_invalidThreadIndex };
+
+	//How many times an idle worker looks for a job before it goes to sleep.
+	static constexpr uint32_t lv_totalNumSpinsBeforeSleeping{ 64U };
+
+
+	bool JobCounter::IsDone() const
+	{
+		return 0U == m_totalNumPendingJobs.load(std::memory_order_acquire);
+	}
+
+
+
+
+	JobSystem::~JobSystem()
+	{
+		{
+			std::lock_guard<std::mutex> lv_lock(m_sleepMutex);
+			m_stopWorkers.store(true);
+		}
+
+		m_wakeCondition.notify_all();
+
+		for (auto& l_worker : m_workers) {
+			l_worker.join();
+		}
+	}
+
+
+	void JobSystem::Init(const uint32_t l_totalNumWorkers, const bool l_pinWorkersToCores)
+	{
+		using namespace LogSystem;
+
+		assert(0U == m_totalNumThreads);
+
+		m_totalNumThreads = l_totalNumWorkers + 1U;
+		m_threadData = std::make_unique<ThreadData[]>(m_totalNumThreads);
+
+		lv_currentThreadIndex = 0U;
+
+		m_workers.reserve(l_totalNumWorkers);
+
+		for (uint32_t i = 1U; i < m_totalNumThreads; ++i) {
+			auto& lv_worker = m_workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+
+			if (false == l_pinWorkersToCores) {
+				continue;
+			}
+
+#ifdef __linux__
+			//The thread that called Init() keeps the first core to itself.
+			cpu_set_t lv_cpuSet;
+			CPU_ZERO(&lv_cpuSet);
+			CPU_SET(i % std::max(std::thread::hardware_concurrency(), 1U), &lv_cpuSet);
+
+			if (0 != pthread_setaffinity_np(lv_worker.native_handle(), sizeof(cpu_set_t), &lv_cpuSet)) {
+				LOG(Severity::WARNING, Channel::INITIALIZATION, "Failed to pin job worker %u to a core.", i);
+			}
+#else
+			(void)lv_worker;
+#endif
+		}
+	}
+
+
+	void JobSystem::Run(const JobFunction l_function, void* l_data, const uint32_t l_begin, const uint32_t l_end, JobCounter& l_counter)
+	{
+		l_counter.m_totalNumPendingJobs.fetch_add(1U, std::memory_order_relaxed);
+
+		Push(Job{ .m_function = l_function, .m_data = l_data, .m_begin = l_begin, .m_end = l_end, .m_counter = &l_counter });
+		WakeWorkers(1U);
+	}
+
+
+	void JobSystem::ParallelFor(const uint32_t l_count, const uint32_t l_grainSize, const JobFunction l_function, void* l_data, JobCounter& l_counter)
+	{
+		assert(0U != l_grainSize);
+
+		if (0U == l_count) {
+			return;
+		}
+
+		const uint32_t lv_totalNumJobs = (l_count + l_grainSize - 1U) / l_grainSize;
+
+		l_counter.m_totalNumPendingJobs.fetch_add(lv_totalNumJobs, std::memory_order_relaxed);
+
+		for (uint32_t lv_begin = 0U; lv_begin < l_count; lv_begin += l_grainSize) {
+			Push(Job{ .m_function = l_function, .m_data = l_data, .m_begin = lv_begin
+				, .m_end = std::min(lv_begin + l_grainSize, l_count), .m_counter = &l_counter });
+		}
+
+		WakeWorkers(lv_totalNumJobs);
+	}
+
+
+	void JobSystem::Wait(const JobCounter& l_counter)
+	{
+		const uint32_t lv_threadIndex = GetCurrentThreadIndex();
+
+		while (false == l_counter.IsDone()) {
+			if (false == TryExecuteJob(lv_threadIndex)) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+
+	uint32_t JobSystem::GetTotalNumThreads() const
+	{
+		return m_totalNumThreads;
+	}
+
+
+	bool JobSystem::IsIdle() const
+	{
+		return 0U == m_totalNumJobsInFlight.load(std::memory_order_acquire);
+	}
+
+
+	JobWorkerStats JobSystem::GetStats(const uint32_t l_threadIndex) const
+	{
+		assert(l_threadIndex < m_totalNumThreads);
+
+		const auto& lv_threadData = m_threadData[l_threadIndex];
+
+		return JobWorkerStats
+		{
+			.m_busyTimeInNanoseconds = lv_threadData.m_busyTimeInNanoseconds.load(std::memory_order_relaxed),
+			.m_totalNumJobsExecuted = lv_threadData.m_totalNumJobsExecuted.load(std::memory_order_relaxed),
+			.m_totalNumJobsStolen = lv_threadData.m_totalNumJobsStolen.load(std::memory_order_relaxed)
+		};
+	}
+
+
+	void JobSystem::Push(const Job& l_job)
+	{
+		const uint32_t lv_threadIndex = GetCurrentThreadIndex();
+
+		//Counted before it can be taken, so the counts never drop below zero.
+		m_totalNumJobsInFlight.fetch_add(1U);
+		m_totalNumQueuedJobs.fetch_add(1U);
+
+		if (false == m_threadData[lv_threadIndex].m_deque.Push(l_job)) {
+			m_totalNumQueuedJobs.fetch_sub(1U);
+			Execute(l_job, lv_threadIndex, false);
+		}
+	}
+
+
+	void JobSystem::WakeWorkers(const uint32_t l_totalNumNewJobs)
+	{
+		//Pairs with the sleeping count a worker raises before it checks for jobs, so either 
+		//the worker sees the new jobs or this sees the worker.
+		if (0U == m_totalNumSleepingWorkers.load()) {
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lv_lock(m_sleepMutex);
+		}
+
+		if (1U == l_totalNumNewJobs) {
+			m_wakeCondition.notify_one();
+		}
+		else {
+			m_wakeCondition.notify_all();
+		}
+	}
+
+
+	bool JobSystem::TryExecuteJob(const uint32_t l_threadIndex)
+	{
+		Job lv_job{};
+		bool lv_stolen{ false };
+		bool lv_found = m_threadData[l_threadIndex].m_deque.Pop(lv_job);
+
+		for (uint32_t i = 1U; false == lv_found && i < m_totalNumThreads; ++i) {
+			lv_found = m_threadData[(l_threadIndex + i) % m_totalNumThreads].m_deque.Steal(lv_job);
+			lv_stolen = true;
+		}
+
+		if (false == lv_found) {
+			return false;
+		}
+
+		m_totalNumQueuedJobs.fetch_sub(1U);
+
+		Execute(lv_job, l_threadIndex, lv_stolen);
+
+		return true;
+	}
+
+
+	void JobSystem::Execute(const Job& l_job, const uint32_t l_threadIndex, const bool l_stolen)
+	{
+		auto& lv_threadData = m_threadData[l_threadIndex];
+
+		const auto lv_start = std::chrono::steady_clock::now();
+		l_job.m_function(l_job.m_data, l_job.m_begin, l_job.m_end);
+		const auto lv_end = std::chrono::steady_clock::now();
+
+		//Jobs nested in this one through Wait() are counted twice, which is fine for a utilization figure.
+		lv_threadData.m_busyTimeInNanoseconds.fetch_add((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(lv_end - lv_start).count(), std::memory_order_relaxed);
+		lv_threadData.m_totalNumJobsExecuted.fetch_add(1U, std::memory_order_relaxed);
+
+		if (true == l_stolen) {
+			lv_threadData.m_totalNumJobsStolen.fetch_add(1U, std::memory_order_relaxed);
+		}
+
+		//Released before the counter, so a thread done waiting on it already sees the job gone.
+		m_totalNumJobsInFlight.fetch_sub(1U, std::memory_order_release);
+		l_job.m_counter->m_totalNumPendingJobs.fetch_sub(1U, std::memory_order_release);
+	}
+
+
+	void JobSystem::WorkerLoop(const uint32_t l_threadIndex)
+	{
+		lv_currentThreadIndex = l_threadIndex;
+
+		uint32_t lv_totalNumSpins{};
+
+		while (false == m_stopWorkers.load(std::memory_order_relaxed)) {
+
+			if (true == TryExecuteJob(l_threadIndex)) {
+				lv_totalNumSpins = 0U;
+				continue;
+			}
+
+			if (++lv_totalNumSpins < lv_totalNumSpinsBeforeSleeping) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			lv_totalNumSpins = 0U;
+
+			std::unique_lock<std::mutex> lv_lock(m_sleepMutex);
+
+			m_totalNumSleepingWorkers.fetch_add(1U);
+			m_wakeCondition.wait(lv_lock, [this]() {return true == m_stopWorkers.load() || 0U != m_totalNumQueuedJobs.load(); });
+			m_totalNumSleepingWorkers.fetch_sub(1U);
+		}
+	}
+
+
+	uint32_t JobSystem::GetCurrentThreadIndex()
+	{
+		assert(lv_invalidThreadIndex != lv_currentThreadIndex && "Only the thread that initialized the job system and its workers can use it.");
+		return lv_currentThreadIndex;
+	}
+}
\ No newline at end of file
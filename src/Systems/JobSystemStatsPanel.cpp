@@ -0,0 +1,90 @@
+
+
+
+#include "Systems/JobSystemStatsPanel.hpp"
+#include <imgui.h>
+#include <cassert>
+
+
+
+namespace Asteroid
+{
+
+	void JobSystemStatsPanel::Init(const JobSystem& l_jobSystem)
+	{
+		m_jobSystem = &l_jobSystem;
+		m_threads.resize(l_jobSystem.GetTotalNumThreads());
+
+		for (uint32_t i = 0; i < (uint32_t)m_threads.size(); ++i) {
+			m_threads[i].m_stats = l_jobSystem.GetStats(i);
+		}
+	}
+
+
+	void JobSystemStatsPanel::Update(const float l_timeInSeconds)
+	{
+		assert(nullptr != m_jobSystem);
+
+		const float lv_elapsedTime = l_timeInSeconds - m_lastSampleTime;
+
+		if (m_sampleIntervalInSeconds > lv_elapsedTime) {
+			return;
+		}
+
+		for (uint32_t i = 0; i < (uint32_t)m_threads.size(); ++i) {
+
+			auto& lv_trackedThread = m_threads[i];
+
+			const JobWorkerStats lv_stats = m_jobSystem->GetStats(i);
+			const JobWorkerStats& lv_previousStats = lv_trackedThread.m_stats;
+
+			const float lv_busyTimeInSeconds = (float)(lv_stats.m_busyTimeInNanoseconds - lv_previousStats.m_busyTimeInNanoseconds) / 1.0e9f;
+
+			lv_trackedThread.m_utilization = lv_busyTimeInSeconds / lv_elapsedTime;
+			lv_trackedThread.m_jobsPerSecond = (float)(lv_stats.m_totalNumJobsExecuted - lv_previousStats.m_totalNumJobsExecuted) / lv_elapsedTime;
+			lv_trackedThread.m_stealsPerSecond = (float)(lv_stats.m_totalNumJobsStolen - lv_previousStats.m_totalNumJobsStolen) / lv_elapsedTime;
+			lv_trackedThread.m_stats = lv_stats;
+		}
+
+		m_lastSampleTime = l_timeInSeconds;
+	}
+
+
+	void JobSystemStatsPanel::Render() const
+	{
+		ImGui::Begin("Job System Stats");
+
+		if (true == ImGui::BeginTable("JobSystemThreads", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+
+			ImGui::TableSetupColumn("Thread");
+			ImGui::TableSetupColumn("Busy");
+			ImGui::TableSetupColumn("Jobs/s");
+			ImGui::TableSetupColumn("Steals/s");
+			ImGui::TableHeadersRow();
+
+			for (uint32_t i = 0; i < (uint32_t)m_threads.size(); ++i) {
+
+				const auto& lv_trackedThread = m_threads[i];
+
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+
+				if (0U == i) {
+					ImGui::Text("Main");
+				}
+				else {
+					ImGui::Text("Worker %u", i);
+				}
+
+				ImGui::TableNextColumn(); ImGui::ProgressBar(lv_trackedThread.m_utilization);
+				ImGui::TableNextColumn(); ImGui::Text("%.1f", lv_trackedThread.m_jobsPerSecond);
+				ImGui::TableNextColumn(); ImGui::Text("%.1f", lv_trackedThread.m_stealsPerSecond);
+			}
+
+			ImGui::EndTable();
+		}
+
+		ImGui::End();
+	}
+
+}
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <cassert>
 #include <array>
 #include <fstream>
+#include <mutex>
 
 
 namespace Asteroid
@@ -21,9 +22,11 @@ namespace Asteroid
 			memset(&lv_finalMsg, 0, sizeof(wchar_t) * lv_maxSizeMsg);
 
 			size_t lv_totalNumCharConverted{};
-			assert(0 == mbstowcs_s<lv_maxSizeMsg>
+			const auto lv_result = mbstowcs_s<lv_maxSizeMsg>
 				(&lv_totalNumCharConverted, lv_finalMsg, l_string
-					, lv_maxSizeMsg - 1));
+					, lv_maxSizeMsg - 1);
+			assert(0 == lv_result);
+			(void)lv_result;
 
 			return lv_finalMsg;
 		}
@@ -184,6 +187,10 @@ namespace Asteroid
 			, const int l_lineNumber, const char* l_filePath
 			, const char* l_userMsg,...)
 		{
+			//Systems log from the worker threads of the SystemScheduler and every buffer used here is static.
+			static std::mutex lv_logMutex;
+			std::lock_guard<std::mutex> lv_lock(lv_logMutex);
+
 			static std::ofstream lv_logFile{};
 			static uint64_t lv_counter{};
 
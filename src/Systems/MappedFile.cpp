@@ -0,0 +1,248 @@
+
+
+
+
+#include "Systems/MappedFile.hpp"
+#include "Systems/LogSystem.hpp"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+namespace Asteroid
+{
+
+	MappedFile::MappedFile()
+	{
+
+	}
+
+
+	bool MappedFile::Open(const std::string& l_filePath, const size_t l_sizeInBytes)
+	{
+		return OpenForWriting(l_filePath, l_sizeInBytes, false);
+	}
+
+
+	bool MappedFile::OpenTemporary(const std::string& l_filePath, const size_t l_sizeInBytes)
+	{
+		return OpenForWriting(l_filePath, l_sizeInBytes, true);
+	}
+
+
+	bool MappedFile::OpenForWriting(const std::string& l_filePath, const size_t l_sizeInBytes, const bool l_isTemporary)
+	{
+		using namespace LogSystem;
+
+		Close();
+
+		if (0U == l_sizeInBytes) {
+			return false;
+		}
+
+#ifdef _WIN32
+
+		HANDLE lv_file = (true == l_isTemporary)
+			? CreateFileA(l_filePath.c_str(), GENERIC_READ | GENERIC_WRITE | DELETE, 0, nullptr
+				, CREATE_NEW, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, nullptr)
+			: CreateFileA(l_filePath.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr
+				, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (INVALID_HANDLE_VALUE == lv_file) {
+			LOG(Severity::FAILURE, Channel::MEMORY, "Failed to create the file %s to be mapped.", l_filePath.c_str());
+			return false;
+		}
+
+		const uint64_t lv_size = (uint64_t)l_sizeInBytes;
+		HANDLE lv_mapping = CreateFileMappingA(lv_file, nullptr, PAGE_READWRITE
+			, (DWORD)(lv_size >> 32U), (DWORD)(lv_size & 0xFFFFFFFFU), nullptr);
+
+		if (nullptr == lv_mapping) {
+			LOG(Severity::FAILURE, Channel::MEMORY, "Failed to create a file mapping for %s.", l_filePath.c_str());
+			CloseHandle(lv_file);
+			return false;
+		}
+
+		void* lv_view = MapViewOfFile(lv_mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, l_sizeInBytes);
+
+		if (nullptr == lv_view) {
+			LOG(Severity::FAILURE, Channel::MEMORY, "Failed to map a view of %s.", l_filePath.c_str());
+			CloseHandle(lv_mapping);
+			CloseHandle(lv_file);
+			return false;
+		}
+
+		m_fileHandle = lv_file;
+		m_mappingHandle = lv_mapping;
+		m_data = static_cast<uint8_t*>(lv_view);
+
+#else
+
+		const int lv_file = open(l_filePath.c_str(), O_RDWR | O_CREAT | ((true == l_isTemporary) ? O_EXCL : O_TRUNC), 0644);
+
+		if (-1 == lv_file) {
+			LOG(Severity::FAILURE, Channel::MEMORY, "Failed to create the file %s to be mapped.", l_filePath.c_str());
+			return false;
+		}
+
+		//The open descriptor keeps the data alive, the name is not needed past this point.
+		if (true == l_isTemporary) {
+			unlink(l_filePath.c_str());
+		}
+
+		if (0 != ftruncate(lv_file, (off_t)l_sizeInBytes)) {
+			LOG(Severity::FAILURE, Channel::MEMORY, "Failed to resize %s.", l_filePath.c_str());
+			close(lv_file);
+			return false;
+		}
+
+		void* lv_view = mmap(nullptr, l_sizeInBytes, PROT_READ | PROT_WRITE, MAP_SHARED, lv_file, 0);
+
+		if (MAP_FAILED == lv_view) {
+			LOG(Severity::FAILURE, Channel::MEMORY, "Failed to map %s.", l_filePath.c_str());
+			close(lv_file);
+			return false;
+		}
+
+		m_fileDescriptor = lv_file;
+		m_data = static_cast<uint8_t*>(lv_view);
+
+#endif
+
+		m_sizeInBytes = l_sizeInBytes;
+
+		return true;
+	}
+
+
+	bool MappedFile::OpenForReading(const std::string& l_filePath)
+	{
+		using namespace LogSystem;
+
+		Close();
+
+#ifdef _WIN32
+
+		HANDLE lv_file = CreateFileA(l_filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr
+			, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (INVALID_HANDLE_VALUE == lv_file) {
+			LOG(Severity::FAILURE, Channel::MEMORY, "Failed to open the file %s to be mapped.", l_filePath.c_str());
+			return false;
+		}
+
+		LARGE_INTEGER lv_fileSize{};
+
+		if (0 == GetFileSizeEx(lv_file, &lv_fileSize) || 0 == lv_fileSize.QuadPart) {
+			CloseHandle(lv_file);
+			return false;
+		}
+
+		HANDLE lv_mapping = CreateFileMappingA(lv_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (nullptr == lv_mapping) {
+			LOG(Severity::FAILURE, Channel::MEMORY, "Failed to create a file mapping for %s.", l_filePath.c_str());
+			CloseHandle(lv_file);
+			return false;
+		}
+
+		void* lv_view = MapViewOfFile(lv_mapping, FILE_MAP_READ, 0, 0, 0);
+
+		if (nullptr == lv_view) {
+			LOG(Severity::FAILURE, Channel::MEMORY, "Failed to map a view of %s.", l_filePath.c_str());
+			CloseHandle(lv_mapping);
+			CloseHandle(lv_file);
+			return false;
+		}
+
+		m_fileHandle = lv_file;
+		m_mappingHandle = lv_mapping;
+		m_data = static_cast<uint8_t*>(lv_view);
+		m_sizeInBytes = (size_t)lv_fileSize.QuadPart;
+
+#else
+
+		const int lv_file = open(l_filePath.c_str(), O_RDONLY);
+
+		if (-1 == lv_file) {
+			LOG(Severity::FAILURE, Channel::MEMORY, "Failed to open the file %s to be mapped.", l_filePath.c_str());
+			return false;
+		}
+
+		const off_t lv_fileSize = lseek(lv_file, 0, SEEK_END);
+
+		if (0 >= lv_fileSize) {
+			close(lv_file);
+			return false;
+		}
+
+		void* lv_view = mmap(nullptr, (size_t)lv_fileSize, PROT_READ, MAP_PRIVATE, lv_file, 0);
+
+		if (MAP_FAILED == lv_view) {
+			LOG(Severity::FAILURE, Channel::MEMORY, "Failed to map %s.", l_filePath.c_str());
+			close(lv_file);
+			return false;
+		}
+
+		m_fileDescriptor = lv_file;
+		m_data = static_cast<uint8_t*>(lv_view);
+		m_sizeInBytes = (size_t)lv_fileSize;
+
+#endif
+
+		return true;
+	}
+
+
+	void MappedFile::Close()
+	{
+		if (nullptr == m_data) {
+			return;
+		}
+
+#ifdef _WIN32
+		UnmapViewOfFile(m_data);
+		CloseHandle(m_mappingHandle);
+		CloseHandle(m_fileHandle);
+		m_mappingHandle = nullptr;
+		m_fileHandle = nullptr;
+#else
+		munmap(m_data, m_sizeInBytes);
+		close(m_fileDescriptor);
+		m_fileDescriptor = -1;
+#endif
+
+		m_data = nullptr;
+		m_sizeInBytes = 0U;
+	}
+
+
+	bool MappedFile::IsOpen() const
+	{
+		return nullptr != m_data;
+	}
+
+
+	uint8_t* MappedFile::GetData() const
+	{
+		return m_data;
+	}
+
+
+	size_t MappedFile::GetSizeInBytes() const
+	{
+		return m_sizeInBytes;
+	}
+
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+}
\ No newline at end of file
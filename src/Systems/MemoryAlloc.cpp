@@ -2,87 +2,353 @@
 
 
 
-
-
 #include "Systems/MemoryAlloc.hpp"
+#include "Systems/VirtualMemory.hpp"
+#include <cassert>
+#include <atomic>
+#include <algorithm>
+#include <stdexcept>
+#include <array>
 
 
 namespace Asteroid
 {
 
+	//Single writer counters need no read-modify-write.
+	static void AddToCounter(std::atomic<uint64_t>& l_counter, const uint64_t l_value)
+	{
+		l_counter.store(l_counter.load(std::memory_order_relaxed) + l_value, std::memory_order_relaxed);
+	}
+
+
+	struct ThreadCacheSlot
+	{
+		uint32_t m_allocatorInstanceID{ UINT32_MAX };
+		void* m_threadCache{};
+	};
+
+	//Each thread keeps one slot per allocator instance, picked by the instance ID, so a thread that
+	//alternates between allocators stays on the fast path. Instance IDs are never reused, so a slot
+	//left by a destroyed allocator can never be matched again.
+	static constexpr uint32_t lv_totalNumThreadCacheSlots{ 8U };
+
+	static std::atomic<uint32_t> lv_nextAllocatorInstanceID{};
+	static thread_local std::array<ThreadCacheSlot, lv_totalNumThreadCacheSlots> lv_threadCacheSlots{};
+
+
+
+	//Aligned to huge pages so slabs committed back to back can be backed by them.
+	static unsigned char* ReserveRegion()
+	{
+		using namespace LogSystem;
+
+		const size_t lv_alignment = std::max(VirtualMemory::GetHugePageSize(), VirtualMemory::GetPageSize());
+		void* lv_region = VirtualMemory::Reserve(MemoryAlloc::m_totalNumPools * MemoryAlloc::m_poolRegionSizeInBytes, lv_alignment, true);
+
+		if (nullptr == lv_region) {
+			LOG(Severity::FAILURE, Channel::MEMORY, "Allocator failed to reserve the address space of its pools.");
+			throw std::runtime_error("Allocator failed to reserve the address space of its pools.");
+		}
+
+		return static_cast<unsigned char*>(lv_region);
+	}
+
+
 
 	MemoryAlloc::MemoryAlloc()
-		: m_pool16(8192, 16)
-		, m_pool32(262144, 32)
-		, m_pool48(262144, 48)
-		, m_pool64(262144, 64)
-		, m_pool80(1024, 80)
-		, m_pool96(2048, 96)
+		: m_region(ReserveRegion())
+		, m_pool16(m_region, m_poolRegionSizeInBytes, 8192, 16)
+		, m_pool32(m_region + 1U * m_poolRegionSizeInBytes, m_poolRegionSizeInBytes, 262144, 32)
+		, m_pool48(m_region + 2U * m_poolRegionSizeInBytes, m_poolRegionSizeInBytes, 262144, 48)
+		, m_pool64(m_region + 3U * m_poolRegionSizeInBytes, m_poolRegionSizeInBytes, 262144, 64)
+		, m_pool80(m_region + 4U * m_poolRegionSizeInBytes, m_poolRegionSizeInBytes, 1024, 80)
+		, m_pool96(m_region + 5U * m_poolRegionSizeInBytes, m_poolRegionSizeInBytes, 2048, 96)
+		, m_pools{&m_pool16, &m_pool32, &m_pool48, &m_pool64, &m_pool80, &m_pool96}
+		, m_instanceID(lv_nextAllocatorInstanceID.fetch_add(1U))
 	{
 
 	}
 
 
+	//The pools never touch their slabs once destroyed, so the region can go before them.
+	MemoryAlloc::~MemoryAlloc()
+	{
+		VirtualMemory::Release(m_region, m_totalNumPools * m_poolRegionSizeInBytes);
+	}
 
-	void* MemoryAlloc::Allocate(const size_t l_blockSize)
+
+	uint32_t MemoryAlloc::GetPoolIndexOfBlock(const void* l_block) const
 	{
+		const auto lv_integerCastBlockPtr = reinterpret_cast<uintptr_t>(l_block);
+		const auto lv_regionStart = reinterpret_cast<uintptr_t>(m_region);
 
-		if (l_blockSize <= 16) {
-			return m_pool16.Allocate();
+		if (lv_integerCastBlockPtr < lv_regionStart) {
+			return m_totalNumPools;
 		}
-		else if (l_blockSize <= 32) {
-			return m_pool32.Allocate();
+
+		const uintptr_t lv_poolIndex = (lv_integerCastBlockPtr - lv_regionStart) >> m_poolRegionShift;
+
+		return (lv_poolIndex < m_totalNumPools) ? (uint32_t)lv_poolIndex : m_totalNumPools;
+	}
+
+
+	bool MemoryAlloc::OwnsBlock(const void* l_block) const
+	{
+		return m_totalNumPools != GetPoolIndexOfBlock(l_block);
+	}
+
+
+	bool MemoryAlloc::Free(void* l_block)
+	{
+		using namespace LogSystem;
+
+		if (nullptr == l_block) {
+			LOG(Severity::WARNING, Channel::MEMORY, "Tried to free a nullptr.");
+			return false;
+		}
+
+		const uint32_t lv_poolIndex = GetPoolIndexOfBlock(l_block);
+
+		if (m_totalNumPools == lv_poolIndex) {
+			LOG(Severity::WARNING, Channel::MEMORY, "Tried to free a block that was not allocated by this allocator.");
+			return false;
+		}
+
+		DeallocateBlock(lv_poolIndex, l_block, m_pools[lv_poolIndex]->GetBlockSizeInBytes());
+
+		return true;
+	}
+
+
+	MemoryAlloc::ThreadCache& MemoryAlloc::GetThreadCache()
+	{
+		auto& lv_threadCacheSlot = lv_threadCacheSlots[m_instanceID % lv_totalNumThreadCacheSlots];
+
+		if (m_instanceID == lv_threadCacheSlot.m_allocatorInstanceID) {
+			return *static_cast<ThreadCache*>(lv_threadCacheSlot.m_threadCache);
 		}
-		else if (l_blockSize <= 48) {
-			return m_pool48.Allocate();
+
+		std::scoped_lock lv_lock{ m_threadCachesMutex };
+
+		const auto lv_threadID = std::this_thread::get_id();
+		ThreadCache* lv_threadCache{};
+
+		//A thread whose slot was taken by another allocator gets its old cache back.
+		for (auto& l_threadCache : m_threadCaches) {
+			if (lv_threadID == l_threadCache->m_threadID) {
+				lv_threadCache = l_threadCache.get();
+				break;
+			}
+		}
+
+		if (nullptr == lv_threadCache) {
+			m_threadCaches.emplace_back(std::make_unique<ThreadCache>());
+			lv_threadCache = m_threadCaches.back().get();
+			lv_threadCache->m_threadID = lv_threadID;
+		}
+
+		lv_threadCacheSlot = ThreadCacheSlot{ .m_allocatorInstanceID = m_instanceID, .m_threadCache = lv_threadCache };
+
+		return *lv_threadCache;
+	}
+
+
+	void* MemoryAlloc::AllocateBlock(const uint32_t l_poolIndex, const size_t l_sizeInBytes)
+	{
+		auto& lv_magazine = GetThreadCache().m_magazines[l_poolIndex];
+
+		AddToCounter(lv_magazine.m_totalNumAllocations, 1U);
+		AddToCounter(lv_magazine.m_totalNumBytesAllocated, l_sizeInBytes);
+
+		if (0U == lv_magazine.m_totalNumBlocks) {
+
+			std::scoped_lock lv_lock{ m_poolMutexes[l_poolIndex] };
+
+			MarkPendingBlocksDirty(l_poolIndex, lv_magazine);
+
+			for (uint32_t i = 0; i < m_magazineBatchSize; ++i) {
+				lv_magazine.m_blocks[lv_magazine.m_totalNumBlocks++] = m_pools[l_poolIndex]->Allocate();
+			}
+
+			//Blocks coming from the pool are already marked dirty by Allocate().
+			--lv_magazine.m_totalNumBlocks;
+			return lv_magazine.m_blocks[lv_magazine.m_totalNumBlocks];
 		}
-		else if (l_blockSize <= 64) {
-			return m_pool64.Allocate();
+
+		void* lv_block = lv_magazine.m_blocks[--lv_magazine.m_totalNumBlocks];
+
+		if (m_magazineCapacity == lv_magazine.m_totalNumBlocksToMarkDirty) {
+			std::scoped_lock lv_lock{ m_poolMutexes[l_poolIndex] };
+			MarkPendingBlocksDirty(l_poolIndex, lv_magazine);
 		}
-		else if (l_blockSize <= 80) {
-			return m_pool80.Allocate();
+
+		lv_magazine.m_blocksToMarkDirty[lv_magazine.m_totalNumBlocksToMarkDirty++] = lv_block;
+
+		return lv_block;
+	}
+
+
+	void MemoryAlloc::DeallocateBlock(const uint32_t l_poolIndex, void* l_block, const size_t l_sizeInBytes)
+	{
+		auto& lv_magazine = GetThreadCache().m_magazines[l_poolIndex];
+
+		AddToCounter(lv_magazine.m_totalNumFrees, 1U);
+		AddToCounter(lv_magazine.m_totalNumBytesFreed, l_sizeInBytes);
+
+		//Handles to the object stop resolving right away, even while the block waits in the magazine.
+		//The generation is part of what a snapshot restores, so the block is dirty now.
+		m_pools[l_poolIndex]->IncrementBlockGeneration(l_block);
+
+		if (m_magazineCapacity == lv_magazine.m_totalNumBlocks || m_magazineCapacity == lv_magazine.m_totalNumBlocksToMarkDirty) {
+			std::scoped_lock lv_lock{ m_poolMutexes[l_poolIndex] };
+			MarkPendingBlocksDirty(l_poolIndex, lv_magazine);
+
+			if (m_magazineCapacity == lv_magazine.m_totalNumBlocks) {
+				ReturnBlocksToPool(l_poolIndex, lv_magazine, m_magazineBatchSize);
+			}
 		}
-		else if (l_blockSize <= 96) {
-			return m_pool96.Allocate();
+
+		lv_magazine.m_blocksToMarkDirty[lv_magazine.m_totalNumBlocksToMarkDirty++] = l_block;
+		lv_magazine.m_blocks[lv_magazine.m_totalNumBlocks++] = l_block;
+	}
+
+
+	void MemoryAlloc::MarkPendingBlocksDirty(const uint32_t l_poolIndex, Magazine& l_magazine)
+	{
+		for (uint32_t i = 0; i < l_magazine.m_totalNumBlocksToMarkDirty; ++i) {
+			m_pools[l_poolIndex]->MarkBlockDirty(l_magazine.m_blocksToMarkDirty[i]);
 		}
 
+		l_magazine.m_totalNumBlocksToMarkDirty = 0U;
+	}
+
 
-		return nullptr;
+	void MemoryAlloc::ReturnBlocksToPool(const uint32_t l_poolIndex, Magazine& l_magazine, const uint32_t l_totalNumBlocks)
+	{
+		assert(l_totalNumBlocks <= l_magazine.m_totalNumBlocks);
+
+		//The oldest blocks go back so the ones likely still in the cache stay.
+		for (uint32_t i = 0; i < l_totalNumBlocks; ++i) {
+			m_pools[l_poolIndex]->Deallocate(l_magazine.m_blocks[i]);
+		}
 
+		l_magazine.m_totalNumBlocks -= l_totalNumBlocks;
 
+		for (uint32_t i = 0; i < l_magazine.m_totalNumBlocks; ++i) {
+			l_magazine.m_blocks[i] = l_magazine.m_blocks[i + l_totalNumBlocks];
+		}
 	}
 
 
+	void MemoryAlloc::FlushThreadCaches()
+	{
+		std::scoped_lock lv_lock{ m_threadCachesMutex };
+
+		for (auto& l_threadCache : m_threadCaches) {
+			for (uint32_t i = 0; i < m_totalNumPools; ++i) {
+
+				std::scoped_lock lv_poolLock{ m_poolMutexes[i] };
+
+				auto& lv_magazine = l_threadCache->m_magazines[i];
+				MarkPendingBlocksDirty(i, lv_magazine);
+				ReturnBlocksToPool(i, lv_magazine, lv_magazine.m_totalNumBlocks);
+			}
+		}
+	}
 
-	bool MemoryAlloc::Deallocate(void* l_block, const size_t l_blockSize)
+
+	void MemoryAlloc::MarkDirty(const void* l_block)
 	{
+		const uint32_t lv_poolIndex = GetPoolIndexOfBlock(l_block);
 
-		using namespace LogSystem;
+		if (m_totalNumPools == lv_poolIndex) {
+			return;
+		}
+
+		std::scoped_lock lv_lock{ m_poolMutexes[lv_poolIndex] };
 
-		if (l_blockSize <= 16) {
-			return m_pool16.Deallocate(l_block);
+		if (true == m_pools[lv_poolIndex]->OwnsBlock(l_block)) {
+			m_pools[lv_poolIndex]->MarkBlockDirty(l_block);
 		}
-		else if (l_blockSize <= 32) {
-			return m_pool32.Deallocate(l_block);
+	}
+
+
+	void MemoryAlloc::MarkAllDirty()
+	{
+		for (auto* l_pool : m_pools) {
+			l_pool->MarkAllBlocksDirty();
 		}
-		else if (l_blockSize <= 48) {
-			return m_pool48.Deallocate(l_block);
+	}
+
+
+	void MemoryAlloc::ReleaseEmptySlabs()
+	{
+		//Blocks sitting in the magazines would keep their slabs alive.
+		FlushThreadCaches();
+
+		for (auto* l_pool : m_pools) {
+			l_pool->ReleaseEmptySlabs();
 		}
-		else if (l_blockSize <= 64) {
-			return m_pool64.Deallocate(l_block);
+	}
+
+
+	bool MemoryAlloc::LockPoolMemory()
+	{
+		bool lv_lockedAll{ true };
+
+		for (auto* l_pool : m_pools) {
+			if (false == l_pool->LockSlabs()) {
+				lv_lockedAll = false;
+			}
 		}
-		else if (l_blockSize <= 80) {
-			return m_pool80.Deallocate(l_block);
+
+		return lv_lockedAll;
+	}
+
+
+	MemoryPool& MemoryAlloc::GetPool(const uint32_t l_poolIndex)
+	{
+		assert(l_poolIndex < m_totalNumPools);
+		return *m_pools[l_poolIndex];
+	}
+
+
+	SizeClassStats MemoryAlloc::GetStats(const uint32_t l_poolIndex)
+	{
+		assert(l_poolIndex < m_totalNumPools);
+
+		SizeClassStats lv_stats{};
+
+		{
+			std::scoped_lock lv_lock{ m_poolMutexes[l_poolIndex] };
+			lv_stats.m_pool = m_pools[l_poolIndex]->GetStats();
 		}
-		else if (l_blockSize <= 96) {
-			return m_pool96.Deallocate(l_block);
+
+		uint64_t lv_totalNumBytesAllocated{};
+		uint64_t lv_totalNumBytesFreed{};
+
+		{
+			std::scoped_lock lv_lock{ m_threadCachesMutex };
+
+			//Objects may be freed by another thread than the one that created them, so only the sums mean anything.
+			for (const auto& l_threadCache : m_threadCaches) {
+				const auto& lv_magazine = l_threadCache->m_magazines[l_poolIndex];
+				lv_stats.m_totalNumAllocations += lv_magazine.m_totalNumAllocations.load(std::memory_order_relaxed);
+				lv_stats.m_totalNumFrees += lv_magazine.m_totalNumFrees.load(std::memory_order_relaxed);
+				lv_totalNumBytesAllocated += lv_magazine.m_totalNumBytesAllocated.load(std::memory_order_relaxed);
+				lv_totalNumBytesFreed += lv_magazine.m_totalNumBytesFreed.load(std::memory_order_relaxed);
+			}
 		}
-		else {
 
-			LOG(Severity::WARNING, Channel::MEMORY, "The requested blocksize to deallocate has not been allocated in any of the pools: Too big for it to fit in any of the blocks of the pools.");
-			return false;
+		if (lv_stats.m_totalNumAllocations >= lv_stats.m_totalNumFrees && lv_totalNumBytesAllocated >= lv_totalNumBytesFreed) {
+			const uint64_t lv_totalNumLiveObjects = lv_stats.m_totalNumAllocations - lv_stats.m_totalNumFrees;
+			const uint64_t lv_totalNumLiveBytes = lv_totalNumBytesAllocated - lv_totalNumBytesFreed;
+			const uint64_t lv_totalNumBlockBytes = lv_totalNumLiveObjects * lv_stats.m_pool.m_blockSizeInBytes;
+
+			lv_stats.m_totalNumWastedBytes = (lv_totalNumBlockBytes > lv_totalNumLiveBytes) ? lv_totalNumBlockBytes - lv_totalNumLiveBytes : 0U;
 		}
 
+		return lv_stats;
 	}
 
 
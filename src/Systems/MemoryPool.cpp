@@ -6,52 +6,180 @@
 
 #include "Systems/MemoryPool.hpp"
 #include "Systems/LogSystem.hpp"
+#include "Systems/VirtualMemory.hpp"
 #include <cmath>
 #include <stdexcept>
 #include <cassert>
+#include <algorithm>
+#include <cstring>
 
 
 namespace Asteroid
 {
 
 
-	MemoryPool::MemoryPool(const size_t l_minBytesToAllocate, const size_t l_blockSizes)
+
+	MemoryPool::MemoryPool(unsigned char* l_region, const size_t l_regionSizeInBytes, const size_t l_minBytesToAllocate, const size_t l_blockSizes)
 		: m_blockSizeInBytes(l_blockSizes)
+		, m_region(l_region)
+		, m_regionSizeInBytes(l_regionSizeInBytes)
 	{
 		using namespace LogSystem;
 
 		assert(0U == l_blockSizes % 16U);
 
-		if (0U == l_minBytesToAllocate % l_blockSizes) {
-			m_totalBytesAllocatedForPool = l_minBytesToAllocate;
+		//Slabs are whole pages, so the blocks fill up the last page too. The generations of the blocks
+		//are stored after the last block of every slab.
+		m_slabSizeInBytes = VirtualMemory::RoundUpToPageSize(std::max(l_minBytesToAllocate, l_blockSizes + sizeof(uint16_t)));
+		m_totalNumBlocksPerSlab = static_cast<uint32_t>(m_slabSizeInBytes / (m_blockSizeInBytes + sizeof(uint16_t)));
+		m_maxNumSlabs = static_cast<uint32_t>(std::min<uint64_t>(m_regionSizeInBytes / m_slabSizeInBytes, m_endOfFreeList / m_totalNumBlocksPerSlab));
+
+		if (nullptr == m_region || 0U == m_totalNumBlocksPerSlab || 0U == m_maxNumSlabs) {
+			throw std::runtime_error("Pool failed to initialize");
+		}
+
+		//Sized once so that looking up the slab of a block never races with chaining another one.
+		m_slabs.resize(m_maxNumSlabs, nullptr);
+		AddSlab();
+	}
+
+
+	void MemoryPool::AddSlab()
+	{
+		using namespace LogSystem;
+
+		//Slabs released earlier leave a hole whose block handles can be used again.
+		uint32_t lv_slabIndex = m_totalNumSlabSlots;
+
+		for (uint32_t i = 0; i < m_totalNumSlabSlots; ++i) {
+			if (nullptr == m_slabs[i]) {
+				lv_slabIndex = i;
+				break;
+			}
 		}
-		else {
-			m_totalBytesAllocatedForPool = (static_cast<size_t>(l_minBytesToAllocate / l_blockSizes) + 1U) * l_blockSizes;
+
+		if (lv_slabIndex >= m_maxNumSlabs) {
+			LOG(Severity::FAILURE, Channel::MEMORY, "Pool with block size %u filled its reserved region.", (uint32_t)m_blockSizeInBytes);
+			throw std::runtime_error("Pool filled its reserved region.");
 		}
 
-		m_totalNumFreeList = static_cast<uint32_t>(m_totalBytesAllocatedForPool / m_blockSizeInBytes);
+		unsigned char* lv_slab = m_region + (size_t)lv_slabIndex * m_slabSizeInBytes;
 
-		if (0U == m_totalNumFreeList) {
-			throw std::runtime_error("Pool failed to initialize");
+		if (false == VirtualMemory::Commit(lv_slab, m_slabSizeInBytes)) {
+			LOG(Severity::FAILURE, Channel::MEMORY, "Pool with block size %u failed to commit a slab.", (uint32_t)m_blockSizeInBytes);
+			throw std::runtime_error("Pool failed to commit a slab.");
 		}
 
-		
-		m_array = new unsigned char[m_totalBytesAllocatedForPool];
+		m_slabs[lv_slabIndex] = lv_slab;
 
+		if (lv_slabIndex == m_totalNumSlabSlots) {
+			++m_totalNumSlabSlots;
+			m_blockWriteGenerations.resize(m_totalNumSlabSlots * m_totalNumBlocksPerSlab);
+		}
 
-		for (size_t i = 0, j = 0; i < m_totalBytesAllocatedForPool; i += m_blockSizeInBytes, ++j) {
+		const uint32_t lv_firstBlockHandle = lv_slabIndex * m_totalNumBlocksPerSlab;
+		const uint32_t lv_lastBlockHandle = lv_firstBlockHandle + m_totalNumBlocksPerSlab - 1U;
 
-			//Violates strict aliasing rules which compiler assumes us to respect when doing optimization.
-			uint32_t* lv_tempArray = reinterpret_cast<uint32_t*>(&m_array[i]);
-			lv_tempArray[0] = m_gaurdDebugValue;
-			lv_tempArray[1] = (uint32_t)(j+1);
+		//A slab committed again in the place of a released one starts out zeroed, so its blocks get 
+		//generations that handles made before the release are unlikely to have.
+		for (uint32_t lv_handle = lv_firstBlockHandle; lv_handle <= lv_lastBlockHandle; ++lv_handle) {
+			SetBlockGeneration(lv_handle, m_slabLayoutVersion);
+		}
 
+		//The new blocks are chained in front of whatever is left of the free list. This writes to
+		//every page of the slab, so it is faulted in now rather than when the blocks are first used.
+		for (uint32_t lv_handle = lv_firstBlockHandle; lv_handle < lv_lastBlockHandle; ++lv_handle) {
+			WriteFreeBlock(lv_handle, lv_handle + 1U);
 		}
 
-		auto lv_sizeOfAllBlocksExceptLast = m_totalBytesAllocatedForPool - m_blockSizeInBytes;
-		uint32_t* lv_lastBlock = reinterpret_cast<uint32_t*>(&m_array[lv_sizeOfAllBlocksExceptLast]);
-		lv_lastBlock[1] = UINT32_MAX;
+		WriteFreeBlock(lv_lastBlockHandle, m_headHandleOfFreeList);
+
+		m_headHandleOfFreeList = lv_firstBlockHandle;
+		m_totalNumFreeList += m_totalNumBlocksPerSlab;
+		m_totalNumLiveBlocks += m_totalNumBlocksPerSlab;
+
+		std::fill(m_blockWriteGenerations.begin() + lv_firstBlockHandle, m_blockWriteGenerations.begin() + lv_lastBlockHandle + 1U, m_currentWriteGeneration);
+
+		++m_slabLayoutVersion;
 
+		if (1U < m_totalNumSlabSlots) {
+			LOG(Severity::INFO, Channel::MEMORY, "Pool with block size %u chained slab %u.", (uint32_t)m_blockSizeInBytes, lv_slabIndex);
+		}
+	}
+
+
+	//Free blocks hold no object, so the free list is read and written as raw bytes through memcpy.
+	//Casting the block to uint32_t* would let the optimizer reorder these accesses with the ones 
+	//made through the component pointers the same block was handed out as.
+	void MemoryPool::WriteFreeBlock(const uint32_t l_blockHandle, const uint32_t l_nextBlockHandle)
+	{
+		unsigned char* lv_block = GetBlock(l_blockHandle);
+		std::memcpy(lv_block, &m_gaurdDebugValue, sizeof(uint32_t));
+		std::memcpy(lv_block + sizeof(uint32_t), &l_nextBlockHandle, sizeof(uint32_t));
+	}
+
+
+	uint32_t MemoryPool::ReadNextFreeBlockHandle(const uint32_t l_blockHandle) const
+	{
+		uint32_t lv_nextBlockHandle{};
+		std::memcpy(&lv_nextBlockHandle, GetBlock(l_blockHandle) + sizeof(uint32_t), sizeof(uint32_t));
+		return lv_nextBlockHandle;
+	}
+
+
+	//Generations are kept as raw bytes like the free list, since nothing ever starts a uint16_t object there.
+	unsigned char* MemoryPool::GetGenerationOfBlock(const uint32_t l_blockHandle) const
+	{
+		return m_slabs[l_blockHandle / m_totalNumBlocksPerSlab] + (size_t)m_totalNumBlocksPerSlab * m_blockSizeInBytes + sizeof(uint16_t) * (l_blockHandle % m_totalNumBlocksPerSlab);
+	}
+
+
+	void MemoryPool::IncrementBlockGeneration(const void* l_block)
+	{
+		uint32_t lv_blockHandle{};
+		const bool lv_ownsBlock = FindBlockHandle(l_block, lv_blockHandle);
+		assert(true == lv_ownsBlock);
+
+		if (true == lv_ownsBlock) {
+			SetBlockGeneration(lv_blockHandle, GetBlockGeneration(lv_blockHandle) + 1U);
+		}
+	}
+
+
+	uint32_t MemoryPool::GetBlockGeneration(const uint32_t l_blockIndex) const
+	{
+		uint16_t lv_generation{};
+		std::memcpy(&lv_generation, GetGenerationOfBlock(l_blockIndex), sizeof(uint16_t));
+		return lv_generation;
+	}
+
+
+	void MemoryPool::SetBlockGeneration(const uint32_t l_blockIndex, const uint32_t l_generation)
+	{
+		const auto lv_generation = static_cast<uint16_t>(l_generation);
+		std::memcpy(GetGenerationOfBlock(l_blockIndex), &lv_generation, sizeof(uint16_t));
+	}
+
+
+	bool MemoryPool::FindBlockHandle(const void* l_block, uint32_t& l_blockHandle) const
+	{
+		const auto lv_integerCastBlockPtr = reinterpret_cast<uintptr_t>(l_block);
+		const auto lv_regionStart = reinterpret_cast<uintptr_t>(m_region);
+
+		if (lv_integerCastBlockPtr < lv_regionStart || lv_integerCastBlockPtr - lv_regionStart >= (size_t)m_maxNumSlabs * m_slabSizeInBytes) {
+			return false;
+		}
+
+		const size_t lv_offsetInRegion = lv_integerCastBlockPtr - lv_regionStart;
+		const uint32_t lv_slabIndex = static_cast<uint32_t>(lv_offsetInRegion / m_slabSizeInBytes);
+		const size_t lv_offsetInSlab = lv_offsetInRegion % m_slabSizeInBytes;
+
+		if (nullptr == m_slabs[lv_slabIndex] || lv_offsetInSlab >= (size_t)m_totalNumBlocksPerSlab * m_blockSizeInBytes) {
+			return false;
+		}
+
+		l_blockHandle = lv_slabIndex * m_totalNumBlocksPerSlab + static_cast<uint32_t>(lv_offsetInSlab / m_blockSizeInBytes);
+		return true;
 	}
 
 
@@ -61,16 +189,20 @@ namespace Asteroid
 		using namespace LogSystem;
 
 		if (0U == m_totalNumFreeList) {
-			return nullptr;
+			++m_totalNumExhaustedAllocations;
+			AddSlab();
 		}
 
-		//Violates strict aliasing rules which compiler assumes us to respect when doing optimization.
-		uint32_t* lv_blockToReturn = reinterpret_cast<uint32_t*>(&m_array[m_blockSizeInBytes * m_headHandleOfFreeList]);
-		uint32_t lv_nextBlockHandle = lv_blockToReturn[1];
+		unsigned char* lv_blockToReturn = GetBlock(m_headHandleOfFreeList);
+		const uint32_t lv_nextBlockHandle = ReadNextFreeBlockHandle(m_headHandleOfFreeList);
+
+		m_blockWriteGenerations[m_headHandleOfFreeList] = m_currentWriteGeneration;
 
 		m_headHandleOfFreeList = lv_nextBlockHandle;
 		--m_totalNumFreeList;
 
+		m_highWaterMarkBlocksInUse = std::max(m_highWaterMarkBlocksInUse, m_totalNumLiveBlocks - m_totalNumFreeList);
+
 		return static_cast<void*>(lv_blockToReturn);
 
 	}
@@ -81,42 +213,231 @@ namespace Asteroid
 	{
 		using namespace LogSystem;
 
-		auto lv_integerCastBlockPtr = reinterpret_cast<uintptr_t>(l_block);
-
 		if (nullptr == l_block) {
 			LOG(Severity::WARNING, Channel::MEMORY, "Tried to free nullptr from the pool");
 			return false;
 		}
 
-		if (reinterpret_cast<uintptr_t>(m_array) <= lv_integerCastBlockPtr && lv_integerCastBlockPtr <= reinterpret_cast<uintptr_t>(&m_array[m_totalBytesAllocatedForPool-1])) {
-			
-			unsigned char* lv_currentBlock = static_cast<unsigned char*>(l_block);
+		//Callers pick the pool from the address of the block, so a block outside of it is a bug.
+		uint32_t lv_blockToBeFreedHandle{};
+		const bool lv_ownsBlock = FindBlockHandle(l_block, lv_blockToBeFreedHandle);
+		assert(true == lv_ownsBlock);
 
-			size_t lv_totalNumBytesInBetween = lv_currentBlock - m_array;
+		if (false == lv_ownsBlock) {
+			LOG(Severity::WARNING, Channel::MEMORY, "Memory that was requested to be deallocated from the pool was not in the range of the pool");
+			return false;
+		}
 
-			uint32_t lv_blockToBeFreedHandle = static_cast<uint32_t>(lv_totalNumBytesInBetween / m_blockSizeInBytes);
+		WriteFreeBlock(lv_blockToBeFreedHandle, m_headHandleOfFreeList);
+		m_headHandleOfFreeList = lv_blockToBeFreedHandle;
+		++m_totalNumFreeList;
+		m_blockWriteGenerations[lv_blockToBeFreedHandle] = m_currentWriteGeneration;
+		return true;
+	}
 
-			//Violates strict aliasing rules which compiler assumes us to respect when doing optimization.
-			uint32_t* lv_currentBlockUint32 = reinterpret_cast<uint32_t*>(l_block);
-			lv_currentBlockUint32[0] = m_gaurdDebugValue;
-			lv_currentBlockUint32[1] = m_headHandleOfFreeList;
-			m_headHandleOfFreeList = lv_blockToBeFreedHandle;
-			++m_totalNumFreeList;
-			return true;
 
+	uint32_t MemoryPool::ReleaseEmptySlabs()
+	{
+		if (1U == m_totalNumSlabSlots) {
+			return 0U;
 		}
-		else {
 
-			throw std::runtime_error("Memory that was requested to be deallocated from the pool was not in the range of the pool");
+		//A slab is empty if all of its blocks are in the free list.
+		std::vector<uint32_t> lv_totalNumFreeBlocksPerSlab(m_totalNumSlabSlots, 0U);
 
+		for (uint32_t lv_handle = m_headHandleOfFreeList; m_endOfFreeList != lv_handle; lv_handle = ReadNextFreeBlockHandle(lv_handle)) {
+			++lv_totalNumFreeBlocksPerSlab[lv_handle / m_totalNumBlocksPerSlab];
 		}
 
+		uint32_t lv_totalNumReleasedSlabs{};
+		std::vector<bool> lv_isReleased(m_totalNumSlabSlots, false);
+
+		for (uint32_t i = 1; i < m_totalNumSlabSlots; ++i) {
+			if (nullptr != m_slabs[i] && m_totalNumBlocksPerSlab == lv_totalNumFreeBlocksPerSlab[i]) {
+				lv_isReleased[i] = true;
+				++lv_totalNumReleasedSlabs;
+			}
+		}
+
+		if (0U == lv_totalNumReleasedSlabs) {
+			return 0U;
+		}
+
+		//The free list is linked again without the blocks of the released slabs, keeping its order.
+		uint32_t lv_newHead{ m_endOfFreeList };
+		uint32_t lv_lastKeptHandle{ m_endOfFreeList };
+
+		for (uint32_t lv_handle = m_headHandleOfFreeList; m_endOfFreeList != lv_handle; ) {
+
+			const uint32_t lv_nextHandle = ReadNextFreeBlockHandle(lv_handle);
+
+			if (false == lv_isReleased[lv_handle / m_totalNumBlocksPerSlab]) {
+
+				if (m_endOfFreeList == lv_lastKeptHandle) {
+					lv_newHead = lv_handle;
+				}
+				else {
+					WriteFreeBlock(lv_lastKeptHandle, lv_handle);
+				}
+
+				lv_lastKeptHandle = lv_handle;
+			}
+
+			lv_handle = lv_nextHandle;
+		}
+
+		if (m_endOfFreeList != lv_lastKeptHandle) {
+			WriteFreeBlock(lv_lastKeptHandle, m_endOfFreeList);
+		}
+
+		m_headHandleOfFreeList = lv_newHead;
+		m_totalNumFreeList -= lv_totalNumReleasedSlabs * m_totalNumBlocksPerSlab;
+		m_totalNumLiveBlocks -= lv_totalNumReleasedSlabs * m_totalNumBlocksPerSlab;
+
+		for (uint32_t i = 1; i < m_totalNumSlabSlots; ++i) {
+			if (true == lv_isReleased[i]) {
+				VirtualMemory::Decommit(m_slabs[i], m_slabSizeInBytes);
+				m_slabs[i] = nullptr;
+			}
+		}
+
+		while (nullptr == m_slabs[m_totalNumSlabSlots - 1U]) {
+			--m_totalNumSlabSlots;
+		}
+
+		m_blockWriteGenerations.resize(m_totalNumSlabSlots * m_totalNumBlocksPerSlab);
+
+		//Blocks of released slabs in the middle of the chain must never look dirty.
+		for (uint32_t i = 1; i < m_totalNumSlabSlots; ++i) {
+			if (nullptr == m_slabs[i]) {
+				std::fill(m_blockWriteGenerations.begin() + i * m_totalNumBlocksPerSlab, m_blockWriteGenerations.begin() + (i + 1U) * m_totalNumBlocksPerSlab, 0U);
+			}
+		}
+
+		++m_slabLayoutVersion;
+
+		return lv_totalNumReleasedSlabs;
+	}
+
+	void MemoryPool::MarkBlockDirty(const void* l_block)
+	{
+		uint32_t lv_blockHandle{};
+		const bool lv_ownsBlock = FindBlockHandle(l_block, lv_blockHandle);
+		assert(true == lv_ownsBlock);
+
+		if (true == lv_ownsBlock) {
+			m_blockWriteGenerations[lv_blockHandle] = m_currentWriteGeneration;
+		}
+	}
+
+
+	void MemoryPool::MarkAllBlocksDirty()
+	{
+		for (uint32_t i = 0; i < m_totalNumSlabSlots; ++i) {
+			if (nullptr != m_slabs[i]) {
+				std::fill(m_blockWriteGenerations.begin() + i * m_totalNumBlocksPerSlab, m_blockWriteGenerations.begin() + (i + 1U) * m_totalNumBlocksPerSlab, m_currentWriteGeneration);
+			}
+		}
+	}
+
+
+	bool MemoryPool::IsBlockDirty(const uint32_t l_blockIndex) const
+	{
+		return m_currentWriteGeneration == m_blockWriteGenerations[l_blockIndex];
+	}
+
+
+	void MemoryPool::StartNewWriteGeneration()
+	{
+		++m_currentWriteGeneration;
+	}
+
+
+	bool MemoryPool::OwnsBlock(const void* l_block) const
+	{
+		uint32_t lv_blockHandle{};
+		return FindBlockHandle(l_block, lv_blockHandle);
+	}
+
+
+	uint32_t MemoryPool::GetTotalNumBlocks() const
+	{
+		return (uint32_t)m_blockWriteGenerations.size();
+	}
+
+
+	uint32_t MemoryPool::GetMaxNumBlocks() const
+	{
+		return m_maxNumSlabs * m_totalNumBlocksPerSlab;
+	}
+
+
+	size_t MemoryPool::GetBlockSizeInBytes() const
+	{
+		return m_blockSizeInBytes;
+	}
+
+
+	unsigned char* MemoryPool::GetBlock(const uint32_t l_blockIndex)
+	{
+		unsigned char* lv_slab = m_slabs[l_blockIndex / m_totalNumBlocksPerSlab];
+
+		return (nullptr == lv_slab) ? nullptr : &lv_slab[m_blockSizeInBytes * (l_blockIndex % m_totalNumBlocksPerSlab)];
+	}
+
+
+	const unsigned char* MemoryPool::GetBlock(const uint32_t l_blockIndex) const
+	{
+		const unsigned char* lv_slab = m_slabs[l_blockIndex / m_totalNumBlocksPerSlab];
+
+		return (nullptr == lv_slab) ? nullptr : &lv_slab[m_blockSizeInBytes * (l_blockIndex % m_totalNumBlocksPerSlab)];
 	}
 
-	MemoryPool::~MemoryPool()
+
+	uint32_t MemoryPool::GetSlabLayoutVersion() const
+	{
+		return m_slabLayoutVersion;
+	}
+
+
+	MemoryPoolState MemoryPool::GetState() const
 	{
-		delete[] m_array;
+		return MemoryPoolState{ .m_headHandleOfFreeList = m_headHandleOfFreeList, .m_totalNumFreeList = m_totalNumFreeList };
 	}
 
 
+	void MemoryPool::SetState(const MemoryPoolState& l_state)
+	{
+		m_headHandleOfFreeList = l_state.m_headHandleOfFreeList;
+		m_totalNumFreeList = l_state.m_totalNumFreeList;
+	}
+
+
+	bool MemoryPool::LockSlabs()
+	{
+		bool lv_lockedAll{ true };
+
+		for (auto* l_slab : m_slabs) {
+			if (nullptr != l_slab && false == VirtualMemory::Lock(l_slab, m_slabSizeInBytes)) {
+				lv_lockedAll = false;
+			}
+		}
+
+		return lv_lockedAll;
+	}
+
+
+	MemoryPoolStats MemoryPool::GetStats() const
+	{
+		return MemoryPoolStats
+		{
+			.m_blockSizeInBytes = m_blockSizeInBytes,
+			.m_totalNumSlabs = m_totalNumLiveBlocks / m_totalNumBlocksPerSlab,
+			.m_totalNumBlocks = m_totalNumLiveBlocks,
+			.m_totalNumBlocksInUse = m_totalNumLiveBlocks - m_totalNumFreeList,
+			.m_highWaterMarkBlocksInUse = m_highWaterMarkBlocksInUse,
+			.m_totalNumExhaustedAllocations = m_totalNumExhaustedAllocations
+		};
+	}
+
 }
\ No newline at end of file
@@ -0,0 +1,241 @@
+
+
+
+#include "Systems/MemorySnapshotHistory.hpp"
+#include "Systems/VirtualMemory.hpp"
+#include "Systems/SnapshotWriter.hpp"
+#include "Systems/SnapshotReader.hpp"
+#include <stdexcept>
+#include <cstring>
+#include <cassert>
+
+
+namespace Asteroid
+{
+
+	MemorySnapshotHistory::MemorySnapshotHistory()
+	{
+		m_undoRecord.reserve(64U * 1024U);
+	}
+
+
+	MemorySnapshotHistory::~MemorySnapshotHistory()
+	{
+		VirtualMemory::Free(m_arena, m_arenaSizeInBytes);
+	}
+
+
+	void MemorySnapshotHistory::Init(MemoryAlloc& l_allocator, const size_t l_historyBudgetInBytes)
+	{
+		m_allocator = &l_allocator;
+		m_historyBudgetInBytes = l_historyBudgetInBytes;
+
+		//Every mirror, its generations and the undo records start on their own page.
+		std::array<size_t, MemoryAlloc::m_totalNumPools> lv_mirrorOffsets{};
+		std::array<size_t, MemoryAlloc::m_totalNumPools> lv_mirrorGenerationsOffsets{};
+		size_t lv_arenaSizeInBytes{};
+
+		for (uint32_t i = 0; i < MemoryAlloc::m_totalNumPools; ++i) {
+			const auto& lv_pool = l_allocator.GetPool(i);
+
+			lv_mirrorOffsets[i] = lv_arenaSizeInBytes;
+			m_slabLayoutVersions[i] = lv_pool.GetSlabLayoutVersion();
+			lv_arenaSizeInBytes += VirtualMemory::RoundUpToPageSize(lv_pool.GetBlockSizeInBytes() * lv_pool.GetTotalNumBlocks());
+
+			lv_mirrorGenerationsOffsets[i] = lv_arenaSizeInBytes;
+			lv_arenaSizeInBytes += VirtualMemory::RoundUpToPageSize(sizeof(uint16_t) * lv_pool.GetTotalNumBlocks());
+		}
+
+		const size_t lv_undoRecordsOffset = lv_arenaSizeInBytes;
+		lv_arenaSizeInBytes += VirtualMemory::RoundUpToPageSize(l_historyBudgetInBytes);
+
+		VirtualMemory::Free(m_arena, m_arenaSizeInBytes);
+
+		m_arena = static_cast<uint8_t*>(VirtualMemory::Allocate(lv_arenaSizeInBytes, true));
+		m_arenaSizeInBytes = lv_arenaSizeInBytes;
+
+		if (nullptr == m_arena) {
+			throw std::runtime_error("Failed to allocate the arena of the pool snapshots.");
+		}
+
+		//The first snapshot copies every block into the mirrors, which would fault in all of them at once.
+		VirtualMemory::Prefault(m_arena, m_arenaSizeInBytes);
+
+		for (uint32_t i = 0; i < MemoryAlloc::m_totalNumPools; ++i) {
+			m_mirrors[i] = m_arena + lv_mirrorOffsets[i];
+			m_mirrorGenerations[i] = reinterpret_cast<uint16_t*>(m_arena + lv_mirrorGenerationsOffsets[i]);
+		}
+
+		m_undoRecords.Init(m_arena + lv_undoRecordsOffset, lv_arenaSizeInBytes - lv_undoRecordsOffset, sizeof(m_mirrorStates));
+
+		Clear();
+	}
+
+
+	void MemorySnapshotHistory::TakeSnapshot()
+	{
+		assert(nullptr != m_allocator);
+
+		//Blocks cached by the threads count as allocated in the pools, which only holds until the caches change.
+		m_allocator->FlushThreadCaches();
+
+		//Block indices of the older snapshots mean something else now, so the history starts over.
+		if (true == HasSlabLayoutChanged()) {
+			Init(*m_allocator, m_historyBudgetInBytes);
+		}
+
+		m_undoRecord.clear();
+		m_lastSnapshotSizeInBytes = 0U;
+
+		SnapshotWriter lv_writer{ m_undoRecord };
+		lv_writer.Write(m_mirrorStates);
+
+		for (uint32_t i = 0; i < MemoryAlloc::m_totalNumPools; ++i) {
+
+			auto& lv_pool = m_allocator->GetPool(i);
+			const size_t lv_blockSizeInBytes = lv_pool.GetBlockSizeInBytes();
+			const uint32_t lv_totalNumBlocks = lv_pool.GetTotalNumBlocks();
+
+			for (uint32_t j = 0; j < lv_totalNumBlocks; ++j) {
+
+				//Blocks of released slabs are never dirty.
+				if (false == lv_pool.IsBlockDirty(j)) {
+					continue;
+				}
+
+				uint8_t* lv_mirrorBlock = m_mirrors[i] + lv_blockSizeInBytes * j;
+
+				if (true == m_hasSnapshot) {
+					lv_writer.Write(UndoBlock{ .m_poolIndex = i, .m_blockIndex = j, .m_blockGeneration = m_mirrorGenerations[i][j] });
+					lv_writer.WriteBytes(lv_mirrorBlock, lv_blockSizeInBytes);
+				}
+
+				memcpy(lv_mirrorBlock, lv_pool.GetBlock(j), lv_blockSizeInBytes);
+				m_mirrorGenerations[i][j] = static_cast<uint16_t>(lv_pool.GetBlockGeneration(j));
+				m_lastSnapshotSizeInBytes += lv_blockSizeInBytes;
+			}
+
+			m_mirrorStates[i] = lv_pool.GetState();
+			lv_pool.StartNewWriteGeneration();
+		}
+
+		if (true == m_hasSnapshot) {
+			m_undoRecords.Append(m_undoRecord.data(), m_undoRecord.size(), nullptr);
+		}
+
+		m_hasSnapshot = true;
+	}
+
+
+	bool MemorySnapshotHistory::RestoreSnapshot(const uint32_t l_totalNumSnapshotsBack)
+	{
+		if (l_totalNumSnapshotsBack >= GetTotalNumSnapshots() || true == HasSlabLayoutChanged()) {
+			return false;
+		}
+
+		//The restored pool states know nothing about the blocks cached by the threads.
+		m_allocator->FlushThreadCaches();
+
+		RestoreNewestSnapshot();
+
+		for (uint32_t i = 0; i < l_totalNumSnapshotsBack; ++i) {
+
+			size_t lv_recordSizeInBytes{};
+			const uint8_t* lv_record = m_undoRecords.GetNewestRecord(lv_recordSizeInBytes);
+
+			ApplyUndoRecord(lv_record, lv_recordSizeInBytes);
+			m_undoRecords.PopNewestRecord();
+		}
+
+		return true;
+	}
+
+
+	void MemorySnapshotHistory::RestoreNewestSnapshot()
+	{
+		//Only the blocks written since the newest snapshot can differ from the mirror.
+		for (uint32_t i = 0; i < MemoryAlloc::m_totalNumPools; ++i) {
+
+			auto& lv_pool = m_allocator->GetPool(i);
+			const size_t lv_blockSizeInBytes = lv_pool.GetBlockSizeInBytes();
+			const uint32_t lv_totalNumBlocks = lv_pool.GetTotalNumBlocks();
+
+			for (uint32_t j = 0; j < lv_totalNumBlocks; ++j) {
+				if (true == lv_pool.IsBlockDirty(j)) {
+					memcpy(lv_pool.GetBlock(j), m_mirrors[i] + lv_blockSizeInBytes * j, lv_blockSizeInBytes);
+					lv_pool.SetBlockGeneration(j, m_mirrorGenerations[i][j]);
+				}
+			}
+
+			lv_pool.SetState(m_mirrorStates[i]);
+			lv_pool.StartNewWriteGeneration();
+		}
+	}
+
+
+	void MemorySnapshotHistory::ApplyUndoRecord(const uint8_t* l_record, const size_t l_sizeInBytes)
+	{
+		SnapshotReader lv_reader{ l_record, l_sizeInBytes };
+		lv_reader.Read(m_mirrorStates);
+
+		for (uint32_t i = 0; i < MemoryAlloc::m_totalNumPools; ++i) {
+			m_allocator->GetPool(i).SetState(m_mirrorStates[i]);
+		}
+
+		//The mirror and the pools are identical here, so both get the old contents.
+		while (false == lv_reader.IsAtEnd()) {
+
+			UndoBlock lv_undoBlock{};
+			lv_reader.Read(lv_undoBlock);
+
+			auto& lv_pool = m_allocator->GetPool(lv_undoBlock.m_poolIndex);
+			const size_t lv_blockSizeInBytes = lv_pool.GetBlockSizeInBytes();
+
+			uint8_t* lv_mirrorBlock = m_mirrors[lv_undoBlock.m_poolIndex] + lv_blockSizeInBytes * lv_undoBlock.m_blockIndex;
+
+			lv_reader.ReadBytes(lv_mirrorBlock, lv_blockSizeInBytes);
+			memcpy(lv_pool.GetBlock(lv_undoBlock.m_blockIndex), lv_mirrorBlock, lv_blockSizeInBytes);
+
+			m_mirrorGenerations[lv_undoBlock.m_poolIndex][lv_undoBlock.m_blockIndex] = static_cast<uint16_t>(lv_undoBlock.m_blockGeneration);
+			lv_pool.SetBlockGeneration(lv_undoBlock.m_blockIndex, lv_undoBlock.m_blockGeneration);
+		}
+	}
+
+
+	bool MemorySnapshotHistory::HasSlabLayoutChanged() const
+	{
+		for (uint32_t i = 0; i < MemoryAlloc::m_totalNumPools; ++i) {
+			if (m_slabLayoutVersions[i] != m_allocator->GetPool(i).GetSlabLayoutVersion()) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+
+	uint32_t MemorySnapshotHistory::GetTotalNumSnapshots() const
+	{
+		return (true == m_hasSnapshot) ? m_undoRecords.GetTotalNumRecords() + 1U : 0U;
+	}
+
+
+	size_t MemorySnapshotHistory::GetLastSnapshotSizeInBytes() const
+	{
+		return m_lastSnapshotSizeInBytes;
+	}
+
+
+	void MemorySnapshotHistory::Clear()
+	{
+		m_undoRecords.Clear();
+		m_hasSnapshot = false;
+		m_lastSnapshotSizeInBytes = 0U;
+
+		//The mirror is stale now, so the first snapshot has to copy everything again.
+		if (nullptr != m_allocator) {
+			m_allocator->MarkAllDirty();
+		}
+	}
+
+}
\ No newline at end of file
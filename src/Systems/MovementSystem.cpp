@@ -0,0 +1,37 @@
+
+
+#include "Systems/MovementSystem.hpp"
+#include "Entities/ArchetypeTable.hpp"
+#include "Systems/SystemAccess.hpp"
+
+
+namespace Asteroid
+{
+	namespace MovementSystem
+	{
+
+		void UpdateRayMovement(ArchetypeTable& l_archetype, const float l_deltaTime)
+		{
+			//Reported once for the whole pass rather than per row.
+			SystemAccessCheck::OnRead(l_archetype.m_type, EntityData::RAY_DIRECTIONS);
+			SystemAccessCheck::OnRead(l_archetype.m_type, EntityData::SPEEDS);
+			SystemAccessCheck::OnWrite(l_archetype.m_type, EntityData::POSITIONS);
+
+			glm::vec2* lv_positions = l_archetype.m_positions.data();
+			const glm::vec2* lv_rayDirections = l_archetype.m_rayDirections.data();
+			const float* lv_speeds = l_archetype.m_speeds.data();
+			const uint8_t* lv_flags = l_archetype.m_flags.data();
+			const auto& lv_activeRows = l_archetype.GetActiveRows();
+
+			constexpr uint8_t lv_pausedFlag{ (uint8_t)ArchetypeFlags::MOVEMENT_PAUSED };
+
+			//Paused rows take a step of zero instead of a branch, which leaves their position as it is.
+			for (const uint32_t l_row : lv_activeRows) {
+				const bool lv_isMoving = (0U == (lv_flags[l_row] & lv_pausedFlag));
+				const float lv_step = (true == lv_isMoving) ? lv_speeds[l_row] * l_deltaTime : 0.f;
+
+				lv_positions[l_row] += lv_step * lv_rayDirections[l_row];
+			}
+		}
+	}
+}
\ No newline at end of file
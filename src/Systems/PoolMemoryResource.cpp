@@ -0,0 +1,56 @@
+
+
+
+
+#include "Systems/PoolMemoryResource.hpp"
+#include "Systems/MemoryAlloc.hpp"
+
+
+
+namespace Asteroid
+{
+
+	PoolMemoryResource::PoolMemoryResource(MemoryAlloc& l_allocator, std::pmr::memory_resource* l_upstream)
+		:m_allocator(l_allocator)
+		,m_upstream(l_upstream)
+	{
+
+	}
+
+
+	bool PoolMemoryResource::FitsInPools(const size_t l_sizeInBytes, const size_t l_alignment) const
+	{
+		return MemoryAlloc::m_totalNumPools != MemoryAlloc::GetPoolIndexOfSize(l_sizeInBytes, l_alignment);
+	}
+
+
+	void* PoolMemoryResource::do_allocate(const size_t l_sizeInBytes, const size_t l_alignment)
+	{
+		if (false == FitsInPools(l_sizeInBytes, l_alignment)) {
+			return m_upstream->allocate(l_sizeInBytes, l_alignment);
+		}
+
+		return m_allocator.AllocateBlock(MemoryAlloc::GetPoolIndexOfSize(l_sizeInBytes, l_alignment), l_sizeInBytes);
+	}
+
+
+	void PoolMemoryResource::do_deallocate(void* l_block, const size_t l_sizeInBytes, const size_t l_alignment)
+	{
+		//The address alone tells whether the block came from the pools, and from which one.
+		const uint32_t lv_poolIndex = m_allocator.GetPoolIndexOfBlock(l_block);
+
+		if (MemoryAlloc::m_totalNumPools == lv_poolIndex) {
+			m_upstream->deallocate(l_block, l_sizeInBytes, l_alignment);
+			return;
+		}
+
+		m_allocator.DeallocateBlock(lv_poolIndex, l_block, l_sizeInBytes);
+	}
+
+
+	bool PoolMemoryResource::do_is_equal(const std::pmr::memory_resource& l_other) const noexcept
+	{
+		return this == &l_other;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+
+
+#include "Systems/RenderQueue.hpp"
+#include "Systems/Renderer.hpp"
+#include "Systems/SystemAccess.hpp"
+#include <algorithm>
+#include <cassert>
+
+
+namespace Asteroid
+{
+	namespace RenderSystem
+	{
+
+		void RenderQueue::Reserve(const uint32_t l_totalNumEntities)
+		{
+			m_submissions.reserve((size_t)l_totalNumEntities * (size_t)ComponentTypes::TOTAL_NUM_COMPONENT_TYPES);
+		}
+
+
+		void RenderQueue::Submit(const uint32_t l_entityIndex, const ComponentTypes l_componentSlot, const RenderingData& l_renderData)
+		{
+			SystemAccessCheck::OnWrite(SharedData::RENDER_QUEUE);
+			assert(m_submissions.size() < m_submissions.capacity());
+
+			const uint32_t lv_sortKey = l_entityIndex * (uint32_t)ComponentTypes::TOTAL_NUM_COMPONENT_TYPES + (uint32_t)l_componentSlot;
+
+			m_submissions.push_back(RenderSubmission{ .m_sortKey = lv_sortKey, .m_renderData = l_renderData });
+		}
+
+
+		bool RenderQueue::Flush(Renderer& l_renderer)
+		{
+			//An entity fills each slot at most once, so the keys are unique and the order does not depend on the sort.
+			std::sort(m_submissions.begin(), m_submissions.end()
+				, [](const RenderSubmission& l_a, const RenderSubmission& l_b) -> bool
+				{
+					return l_a.m_sortKey < l_b.m_sortKey;
+				});
+
+			bool lv_result{ true };
+
+			for (const auto& l_submission : m_submissions) {
+				if (false == l_renderer.RenderEntity(l_submission.m_renderData)) {
+					lv_result = false;
+					break;
+				}
+			}
+
+			m_submissions.clear();
+
+			return lv_result;
+		}
+	}
+}
\ No newline at end of file
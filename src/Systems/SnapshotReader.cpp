@@ -0,0 +1,56 @@
+
+
+
+
+#include "Systems/SnapshotReader.hpp"
+#include <cassert>
+#include <cstring>
+
+
+namespace Asteroid
+{
+
+	SnapshotReader::SnapshotReader(const uint8_t* l_data, const size_t l_sizeInBytes)
+		:m_data(l_data)
+		,m_sizeInBytes(l_sizeInBytes)
+	{
+
+	}
+
+
+	void SnapshotReader::ReadBytes(void* l_data, const size_t l_sizeInBytes)
+	{
+		PeekBytes(l_data, l_sizeInBytes);
+
+		m_currentOffset += l_sizeInBytes;
+	}
+
+
+	void SnapshotReader::PeekBytes(void* l_data, const size_t l_sizeInBytes) const
+	{
+		assert(m_currentOffset + l_sizeInBytes <= m_sizeInBytes);
+
+		memcpy(l_data, m_data + m_currentOffset, l_sizeInBytes);
+	}
+
+
+	void SnapshotReader::SkipBytes(const size_t l_sizeInBytes)
+	{
+		assert(m_currentOffset + l_sizeInBytes <= m_sizeInBytes);
+
+		m_currentOffset += l_sizeInBytes;
+	}
+
+
+	size_t SnapshotReader::GetTotalNumRemainingBytes() const
+	{
+		return (m_currentOffset < m_sizeInBytes) ? m_sizeInBytes - m_currentOffset : 0U;
+	}
+
+
+	bool SnapshotReader::IsAtEnd() const
+	{
+		return m_currentOffset >= m_sizeInBytes;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+
+
+
+
+#include "Systems/SnapshotWriter.hpp"
+
+
+namespace Asteroid
+{
+
+	SnapshotWriter::SnapshotWriter(std::vector<uint8_t>& l_buffer)
+		:m_buffer(l_buffer)
+	{
+
+	}
+
+
+	void SnapshotWriter::WriteBytes(const void* l_data, const size_t l_sizeInBytes)
+	{
+		const auto* lv_bytes = static_cast<const uint8_t*>(l_data);
+
+		m_buffer.insert(m_buffer.end(), lv_bytes, lv_bytes + l_sizeInBytes);
+	}
+
+
+	size_t SnapshotWriter::GetTotalBytesWritten() const
+	{
+		return m_buffer.size();
+	}
+
+}
\ No newline at end of file
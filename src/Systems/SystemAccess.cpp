@@ -0,0 +1,171 @@
+
+
+#include "Systems/SystemAccess.hpp"
+#include <atomic>
+#include <array>
+#include <cstdio>
+#include <cassert>
+
+
+namespace Asteroid
+{
+
+	static constexpr uint32_t lv_totalNumEntityDataBits{ (uint32_t)EntityType::TOTAL_NUM_ENTITY_TYPES * (uint32_t)EntityData::TOTAL_NUM_ENTITY_DATA };
+
+	static_assert(lv_totalNumEntityDataBits + (uint32_t)SharedData::TOTAL_NUM_SHARED_DATA <= 64U, "System access does not fit in 64 bits.");
+
+
+	SystemAccess& SystemAccess::Reads(const EntityType l_type, const EntityData l_data)
+	{
+		m_reads |= (1ULL << GetBit(l_type, l_data));
+		return *this;
+	}
+
+	SystemAccess& SystemAccess::Writes(const EntityType l_type, const EntityData l_data)
+	{
+		m_writes |= (1ULL << GetBit(l_type, l_data));
+		return *this;
+	}
+
+	SystemAccess& SystemAccess::Reads(const SharedData l_data)
+	{
+		m_reads |= (1ULL << GetBit(l_data));
+		return *this;
+	}
+
+	SystemAccess& SystemAccess::Writes(const SharedData l_data)
+	{
+		m_writes |= (1ULL << GetBit(l_data));
+		return *this;
+	}
+
+
+	bool SystemAccess::ConflictsWith(const SystemAccess& l_other) const
+	{
+		return 0U != (m_writes & (l_other.m_reads | l_other.m_writes)) || 0U != (l_other.m_writes & m_reads);
+	}
+
+
+	bool SystemAccess::CanRead(const uint32_t l_bit) const
+	{
+		return 0U != ((m_reads | m_writes) & (1ULL << l_bit));
+	}
+
+	bool SystemAccess::CanWrite(const uint32_t l_bit) const
+	{
+		return 0U != (m_writes & (1ULL << l_bit));
+	}
+
+
+	uint32_t SystemAccess::GetBit(const EntityType l_type, const EntityData l_data)
+	{
+		assert(l_type < EntityType::TOTAL_NUM_ENTITY_TYPES && l_data < EntityData::TOTAL_NUM_ENTITY_DATA);
+		return (uint32_t)l_type * (uint32_t)EntityData::TOTAL_NUM_ENTITY_DATA + (uint32_t)l_data;
+	}
+
+	uint32_t SystemAccess::GetBit(const SharedData l_data)
+	{
+		assert(l_data < SharedData::TOTAL_NUM_SHARED_DATA);
+		return lv_totalNumEntityDataBits + (uint32_t)l_data;
+	}
+
+
+
+
+	namespace SystemAccessCheck
+	{
+		static thread_local const char* lv_currentSystemName{};
+		static thread_local const SystemAccess* lv_currentSystemAccess{};
+		static thread_local uint64_t* lv_currentReportedViolations{};
+
+		static std::atomic<uint32_t> lv_totalNumViolations{};
+
+
+		static constexpr std::array<const char*, (size_t)EntityType::TOTAL_NUM_ENTITY_TYPES> lv_entityTypeNames
+		{ "player", "bullets", "asteroids", "cursor" };
+
+		static constexpr std::array<const char*, (size_t)EntityData::TOTAL_NUM_ENTITY_DATA> lv_entityDataNames
+		{ "positions", "ray directions", "speeds", "animation offsets", "flags"
+		, "movement components", "animation components", "collision components", "state components", "attribute components" };
+
+		static constexpr std::array<const char*, (size_t)SharedData::TOTAL_NUM_SHARED_DATA> lv_sharedDataNames
+		{ "input", "hit counter", "render queue" };
+
+
+		//Only called while a system runs with verification on.
+		static void Verify(const uint32_t l_bit, const bool l_write, const char* l_dataName, const char* l_ownerName)
+		{
+			const bool lv_allowed = (true == l_write) ? lv_currentSystemAccess->CanWrite(l_bit) : lv_currentSystemAccess->CanRead(l_bit);
+
+			if (true == lv_allowed) {
+				return;
+			}
+
+			lv_totalNumViolations.fetch_add(1U, std::memory_order_relaxed);
+
+			if (0U == (*lv_currentReportedViolations & (1ULL << l_bit))) {
+				*lv_currentReportedViolations |= (1ULL << l_bit);
+				std::fprintf(stderr, "System %s %s the %s%s%s without declaring it.\n", lv_currentSystemName
+					, (true == l_write) ? "writes" : "reads", l_dataName, (nullptr != l_ownerName) ? " of the " : "", (nullptr != l_ownerName) ? l_ownerName : "");
+			}
+		}
+
+
+		void BeginSystem(const char* l_systemName, const SystemAccess* l_access, uint64_t* l_reportedViolations)
+		{
+			lv_currentSystemName = l_systemName;
+			lv_currentSystemAccess = l_access;
+			lv_currentReportedViolations = l_reportedViolations;
+		}
+
+		void EndSystem()
+		{
+			lv_currentSystemName = nullptr;
+			lv_currentSystemAccess = nullptr;
+			lv_currentReportedViolations = nullptr;
+		}
+
+
+		void OnRead(const EntityType l_type, const EntityData l_data)
+		{
+			if (nullptr == lv_currentSystemAccess) {
+				return;
+			}
+
+			Verify(SystemAccess::GetBit(l_type, l_data), false, lv_entityDataNames[(uint32_t)l_data], lv_entityTypeNames[(uint32_t)l_type]);
+		}
+
+		void OnWrite(const EntityType l_type, const EntityData l_data)
+		{
+			if (nullptr == lv_currentSystemAccess) {
+				return;
+			}
+
+			Verify(SystemAccess::GetBit(l_type, l_data), true, lv_entityDataNames[(uint32_t)l_data], lv_entityTypeNames[(uint32_t)l_type]);
+		}
+
+		void OnRead(const SharedData l_data)
+		{
+			if (nullptr == lv_currentSystemAccess) {
+				return;
+			}
+
+			Verify(SystemAccess::GetBit(l_data), false, lv_sharedDataNames[(uint32_t)l_data], nullptr);
+		}
+
+		void OnWrite(const SharedData l_data)
+		{
+			if (nullptr == lv_currentSystemAccess) {
+				return;
+			}
+
+			Verify(SystemAccess::GetBit(l_data), true, lv_sharedDataNames[(uint32_t)l_data], nullptr);
+		}
+
+
+		uint32_t GetTotalNumViolations()
+		{
+			return lv_totalNumViolations.load(std::memory_order_relaxed);
+		}
+	}
+}
\ No newline at end of file
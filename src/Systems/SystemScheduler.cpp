@@ -0,0 +1,107 @@
+
+
+#include "Systems/SystemScheduler.hpp"
+#include "Systems/JobSystem.hpp"
+#include <cassert>
+
+
+namespace Asteroid
+{
+
+	void SystemScheduler::AddSystem(const char* l_name, const SystemAccess& l_access, SystemFunction&& l_function)
+	{
+		assert(false == m_isStarted);
+
+		m_systems.push_back(SystemNode{ .m_name = l_name, .m_access = l_access, .m_function = std::move(l_function) });
+	}
+
+
+	void SystemScheduler::Start(JobSystem& l_jobSystem, const bool l_verifyAccess)
+	{
+		assert(false == m_isStarted);
+
+		//A system depends on every earlier system it conflicts with. Some of these edges are implied
+		//by others, which costs a few extra decrements per frame but never changes the order.
+		for (uint32_t i = 0; i < (uint32_t)m_systems.size(); ++i) {
+			for (uint32_t j = 0; j < i; ++j) {
+				if (true == m_systems[i].m_access.ConflictsWith(m_systems[j].m_access)) {
+					m_systems[j].m_dependents.push_back(i);
+					++m_systems[i].m_totalNumDependencies;
+				}
+			}
+		}
+
+		m_totalNumPendingDependencies = std::vector<std::atomic<uint32_t>>(m_systems.size());
+		m_jobSystem = &l_jobSystem;
+		m_verifyAccess = l_verifyAccess;
+		m_isStarted = true;
+	}
+
+
+	bool SystemScheduler::Run(UpdateComponents& l_updateContext)
+	{
+		assert(true == m_isStarted);
+
+		const uint32_t lv_totalNumViolationsBefore = SystemAccessCheck::GetTotalNumViolations();
+
+		m_updateContext = &l_updateContext;
+		m_frameResult.store(true, std::memory_order_relaxed);
+
+		//Published to the workers by pushing the first jobs.
+		for (uint32_t i = 0; i < (uint32_t)m_systems.size(); ++i) {
+			m_totalNumPendingDependencies[i].store(m_systems[i].m_totalNumDependencies, std::memory_order_relaxed);
+		}
+
+		for (uint32_t i = 0; i < (uint32_t)m_systems.size(); ++i) {
+			if (0U == m_systems[i].m_totalNumDependencies) {
+				m_jobSystem->Run(&SystemScheduler::RunSystemJob, this, i, i + 1U, m_frameCounter);
+			}
+		}
+
+		//A system starts its dependents before it counts as done, so the counter only 
+		//reaches zero once the last system of the frame finished.
+		m_jobSystem->Wait(m_frameCounter);
+
+		m_updateContext = nullptr;
+
+		return true == m_frameResult.load(std::memory_order_relaxed) && lv_totalNumViolationsBefore == SystemAccessCheck::GetTotalNumViolations();
+	}
+
+
+	void SystemScheduler::RunSystemJob(void* l_scheduler, const uint32_t l_begin, const uint32_t l_end)
+	{
+		assert(l_begin + 1U == l_end);
+		(void)l_end;
+
+		static_cast<SystemScheduler*>(l_scheduler)->ExecuteSystem(l_begin);
+	}
+
+
+	void SystemScheduler::ExecuteSystem(const uint32_t l_systemIndex)
+	{
+		auto& lv_system = m_systems[l_systemIndex];
+
+		bool lv_result{};
+
+		if (false == m_verifyAccess) {
+			lv_result = lv_system.m_function(*m_updateContext);
+		}
+		else {
+			SystemAccessCheck::BeginSystem(lv_system.m_name, &lv_system.m_access, &lv_system.m_reportedAccessViolations);
+			lv_result = lv_system.m_function(*m_updateContext);
+			SystemAccessCheck::EndSystem();
+		}
+
+		if (false == lv_result) {
+			m_frameResult.store(false, std::memory_order_relaxed);
+		}
+
+		//The last dependency to finish starts the dependent. The acquire release pairs make what 
+		//every dependency wrote visible to it.
+		for (const uint32_t l_dependent : lv_system.m_dependents) {
+			if (1U == m_totalNumPendingDependencies[l_dependent].fetch_sub(1U, std::memory_order_acq_rel)) {
+				m_jobSystem->Run(&SystemScheduler::RunSystemJob, this, l_dependent, l_dependent + 1U, m_frameCounter);
+			}
+		}
+	}
+}
\ No newline at end of file
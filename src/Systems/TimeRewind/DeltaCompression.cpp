@@ -0,0 +1,91 @@
+
+
+
+
+#include "Systems/TimeRewind/DeltaCompression.hpp"
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+
+namespace Asteroid
+{
+	namespace DeltaCompression
+	{
+
+		void CompressXorDelta(const std::vector<uint8_t>& l_olderSnapshot, const std::vector<uint8_t>& l_newerSnapshot, std::vector<uint8_t>& l_compressedDelta)
+		{
+			l_compressedDelta.clear();
+
+			const size_t lv_deltaSizeInBytes = std::max(l_olderSnapshot.size(), l_newerSnapshot.size());
+
+			auto lv_xorByteAt = [&](const size_t l_index) -> uint8_t
+				{
+					const uint8_t lv_older = (l_index < l_olderSnapshot.size()) ? l_olderSnapshot[l_index] : 0U;
+					const uint8_t lv_newer = (l_index < l_newerSnapshot.size()) ? l_newerSnapshot[l_index] : 0U;
+					return lv_older ^ lv_newer;
+				};
+
+			size_t i = 0U;
+
+			while (i < lv_deltaSizeInBytes) {
+
+				uint16_t lv_zeroRun{};
+				while (i < lv_deltaSizeInBytes && UINT16_MAX != lv_zeroRun && 0U == lv_xorByteAt(i)) {
+					++lv_zeroRun;
+					++i;
+				}
+
+				const size_t lv_literalStart = i;
+				uint16_t lv_literalRun{};
+				while (i < lv_deltaSizeInBytes && UINT16_MAX != lv_literalRun && 0U != lv_xorByteAt(i)) {
+					++lv_literalRun;
+					++i;
+				}
+
+				//Nothing left to encode but zeros.
+				if (0U == lv_literalRun && i == lv_deltaSizeInBytes) {
+					break;
+				}
+
+				uint8_t lv_runHeader[2 * sizeof(uint16_t)];
+				memcpy(lv_runHeader, &lv_zeroRun, sizeof(uint16_t));
+				memcpy(lv_runHeader + sizeof(uint16_t), &lv_literalRun, sizeof(uint16_t));
+				l_compressedDelta.insert(l_compressedDelta.end(), lv_runHeader, lv_runHeader + sizeof(lv_runHeader));
+
+				for (size_t j = lv_literalStart; j < i; ++j) {
+					l_compressedDelta.push_back(lv_xorByteAt(j));
+				}
+			}
+		}
+
+
+		void ApplyCompressedXorDelta(const uint8_t* l_compressedDelta, const size_t l_compressedDeltaSizeInBytes, std::vector<uint8_t>& l_snapshot, const size_t l_resultSizeInBytes)
+		{
+			l_snapshot.resize(std::max(l_snapshot.size(), l_resultSizeInBytes), 0U);
+
+			size_t lv_snapshotOffset{};
+			size_t lv_deltaOffset{};
+
+			while (lv_deltaOffset < l_compressedDeltaSizeInBytes) {
+
+				uint16_t lv_zeroRun{};
+				uint16_t lv_literalRun{};
+				memcpy(&lv_zeroRun, l_compressedDelta + lv_deltaOffset, sizeof(uint16_t));
+				memcpy(&lv_literalRun, l_compressedDelta + lv_deltaOffset + sizeof(uint16_t), sizeof(uint16_t));
+				lv_deltaOffset += 2 * sizeof(uint16_t);
+
+				lv_snapshotOffset += lv_zeroRun;
+
+				assert(lv_snapshotOffset + lv_literalRun <= l_snapshot.size());
+
+				for (uint16_t j = 0U; j < lv_literalRun; ++j) {
+					l_snapshot[lv_snapshotOffset++] ^= l_compressedDelta[lv_deltaOffset++];
+				}
+			}
+
+			l_snapshot.resize(l_resultSizeInBytes);
+		}
+
+	}
+}
\ No newline at end of file
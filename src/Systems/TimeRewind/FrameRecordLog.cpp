@@ -0,0 +1,170 @@
+
+
+
+
+#include "Systems/TimeRewind/FrameRecordLog.hpp"
+#include <cstring>
+#include <cassert>
+
+
+namespace Asteroid
+{
+
+	FrameRecordLog::FrameRecordLog()
+	{
+
+	}
+
+
+	void FrameRecordLog::Init(uint8_t* l_storage, const size_t l_capacityInBytes, const size_t l_minRecordSizeInBytes)
+	{
+		assert(0U != l_minRecordSizeInBytes && 0U == reinterpret_cast<uintptr_t>(l_storage) % alignof(RecordLocation));
+
+		//Every record needs at least its minimum size plus a location.
+		m_maxNumRecords = (uint32_t)(l_capacityInBytes / (l_minRecordSizeInBytes + sizeof(RecordLocation)));
+
+		const size_t lv_locationsSizeInBytes = sizeof(RecordLocation) * m_maxNumRecords;
+
+		m_records = reinterpret_cast<RecordLocation*>(l_storage);
+		m_storage = l_storage + lv_locationsSizeInBytes;
+		m_capacityInBytes = (0U == m_maxNumRecords) ? 0U : l_capacityInBytes - lv_locationsSizeInBytes;
+		Clear();
+	}
+
+
+	void FrameRecordLog::Append(const uint8_t* l_record, const size_t l_sizeInBytes, FrameRecordLog* l_spillLog)
+	{
+		if (l_sizeInBytes > m_capacityInBytes) {
+
+			//Can never fit in here, but everything already stored is older so it has to leave first.
+			while (0U != m_totalNumRecords) {
+				EvictOldestRecord(l_spillLog);
+			}
+
+			if (nullptr != l_spillLog) {
+				l_spillLog->Append(l_record, l_sizeInBytes, nullptr);
+			}
+
+			return;
+		}
+
+		/*
+		* Records at or after the write offset are always older than the ones before it, 
+		* and the oldest of them is at the front. If the record does not fit at the end 
+		* of the storage, everything after the write offset is evicted and we wrap around.
+		*/
+		if (m_writeOffset + l_sizeInBytes > m_capacityInBytes) {
+
+			while (0U != m_totalNumRecords && GetRecordLocation(0U).m_offset >= m_writeOffset) {
+				EvictOldestRecord(l_spillLog);
+			}
+
+			m_writeOffset = 0U;
+		}
+
+		while (0U != m_totalNumRecords && GetRecordLocation(0U).m_offset >= m_writeOffset
+			&& GetRecordLocation(0U).m_offset < m_writeOffset + l_sizeInBytes) {
+			EvictOldestRecord(l_spillLog);
+		}
+
+		//Only reachable if records smaller than the minimum were appended, the oldest one makes room.
+		if (m_maxNumRecords == m_totalNumRecords) {
+			EvictOldestRecord(l_spillLog);
+		}
+
+		memcpy(m_storage + m_writeOffset, l_record, l_sizeInBytes);
+		++m_totalNumRecords;
+		GetRecordLocation(m_totalNumRecords - 1U) = RecordLocation{ .m_offset = m_writeOffset, .m_sizeInBytes = l_sizeInBytes };
+
+		m_writeOffset += l_sizeInBytes;
+	}
+
+
+	void FrameRecordLog::EvictOldestRecord(FrameRecordLog* l_spillLog)
+	{
+		const auto& lv_oldest = GetRecordLocation(0U);
+
+		if (nullptr != l_spillLog) {
+			l_spillLog->Append(m_storage + lv_oldest.m_offset, lv_oldest.m_sizeInBytes, nullptr);
+		}
+
+		m_oldestRecord = (m_oldestRecord + 1U) % m_maxNumRecords;
+		--m_totalNumRecords;
+	}
+
+
+	FrameRecordLog::RecordLocation& FrameRecordLog::GetRecordLocation(const uint32_t l_index) const
+	{
+		assert(l_index < m_totalNumRecords);
+
+		return m_records[(m_oldestRecord + l_index) % m_maxNumRecords];
+	}
+
+
+	const uint8_t* FrameRecordLog::GetNewestRecord(size_t& l_sizeInBytes) const
+	{
+		assert(0U != m_totalNumRecords);
+
+		const auto& lv_newest = GetRecordLocation(m_totalNumRecords - 1U);
+
+		l_sizeInBytes = lv_newest.m_sizeInBytes;
+		return m_storage + lv_newest.m_offset;
+	}
+
+
+	const uint8_t* FrameRecordLog::GetOldestRecord(size_t& l_sizeInBytes) const
+	{
+		assert(0U != m_totalNumRecords);
+
+		const auto& lv_oldest = GetRecordLocation(0U);
+
+		l_sizeInBytes = lv_oldest.m_sizeInBytes;
+		return m_storage + lv_oldest.m_offset;
+	}
+
+
+	const uint8_t* FrameRecordLog::GetRecord(const uint32_t l_index, size_t& l_sizeInBytes) const
+	{
+		const auto& lv_record = GetRecordLocation(l_index);
+
+		l_sizeInBytes = lv_record.m_sizeInBytes;
+		return m_storage + lv_record.m_offset;
+	}
+
+
+	void FrameRecordLog::PopNewestRecord()
+	{
+		assert(0U != m_totalNumRecords);
+
+		//The newest record is always the last one written, so its space can be reused right away.
+		m_writeOffset = GetRecordLocation(m_totalNumRecords - 1U).m_offset;
+		--m_totalNumRecords;
+	}
+
+
+	bool FrameRecordLog::IsEmpty() const
+	{
+		return 0U == m_totalNumRecords;
+	}
+
+
+	uint32_t FrameRecordLog::GetTotalNumRecords() const
+	{
+		return m_totalNumRecords;
+	}
+
+
+	size_t FrameRecordLog::GetCapacityInBytes() const
+	{
+		return m_capacityInBytes;
+	}
+
+
+	void FrameRecordLog::Clear()
+	{
+		m_writeOffset = 0U;
+		m_oldestRecord = 0U;
+		m_totalNumRecords = 0U;
+	}
+
+}
\ No newline at end of file
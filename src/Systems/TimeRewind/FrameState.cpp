@@ -0,0 +1,150 @@
+
+
+
+#include "Systems/TimeRewind/FrameState.hpp"
+#include "Systems/TimeRewind/EntityMetaData.hpp"
+#include "Entities/Entity.hpp"
+#include "Entities/ArchetypeTable.hpp"
+#include "Components/OnceRepeatableAnimationComponent.hpp"
+#include "Systems/InputSystem.hpp"
+#include "Systems/CallbacksTimer.hpp"
+#include "Systems/SnapshotWriter.hpp"
+#include "Systems/SnapshotReader.hpp"
+#include <cassert>
+
+
+namespace Asteroid
+{
+	namespace FrameState
+	{
+
+		void DeactivateEntity(Entity& l_entity)
+		{
+			l_entity.SetActiveState(false);
+
+			//Once repeatable animations keep their progress while the entity is inactive,
+			//so they are reset here the same way a level restart does it.
+			if (EntityType::ASTEROID == l_entity.GetType()) {
+				auto* lv_explosionAnim = l_entity.Get<OnceRepeatableAnimationComponent>(ComponentTypes::EXPLOSION_FIRE_ASTEROID_ANIMATION);
+				auto* lv_warpAnim = l_entity.Get<OnceRepeatableAnimationComponent>(ComponentTypes::WARP_ASTEROID_ANIMATION);
+
+				lv_explosionAnim->Reset();
+				lv_warpAnim->Reset();
+			}
+		}
+
+
+		void Capture(const std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, const InputSystem& l_inputSystem, const float l_time, const uint32_t l_totalNumBulletsHitAsteroid, const CallbacksTimer& l_callbackTimer, FrameCapture& l_capture)
+		{
+			auto& lv_header = l_capture.m_frame.m_header;
+
+			lv_header.m_time = l_time;
+			lv_header.m_totalNumBulletsHitAsteroid = l_totalNumBulletsHitAsteroid;
+
+			lv_header.m_mousePos = l_inputSystem.GetMousePosRelativeToWindow();
+			lv_header.m_isMouseHidden = l_inputSystem.IsMouseHidden();
+
+			lv_header.m_oldestDelayedCallbackID = l_callbackTimer.GetDelayedCallbackStates(l_capture.m_frame.m_delayedCallbacks);
+			lv_header.m_totalNumDelayedCallbacks = (uint32_t)l_capture.m_frame.m_delayedCallbacks.size();
+
+			lv_header.m_activeEntities.reset();
+			l_capture.m_activeEntitiesSnapshot.clear();
+			uint32_t lv_totalNumActiveEntities{};
+
+			SnapshotWriter lv_writer{ l_capture.m_activeEntitiesSnapshot };
+
+			//Entities are written in the order of the active rows, Apply() finds each one by its id.
+			l_archetypes.ForEachActiveEntity([&](const uint32_t l_entityIndex) -> void
+				{
+					lv_header.m_activeEntities.set(l_entityIndex);
+					++lv_totalNumActiveEntities;
+
+					l_entities[l_entityIndex].Snapshot(lv_writer);
+				});
+
+			lv_header.m_totalNumActiveEntities = lv_totalNumActiveEntities;
+			lv_header.m_snapshotSizeInBytes = (uint32_t)l_capture.m_activeEntitiesSnapshot.size();
+		}
+
+
+		bool ValidateSnapshot(const std::bitset<FrameHeader::m_maxNumEntities>& l_activeEntities, const uint32_t l_totalNumActiveEntities
+			, const uint8_t* l_snapshot, const size_t l_sizeInBytes, const std::vector<Entity>& l_entities)
+		{
+			if (l_totalNumActiveEntities != (uint32_t)l_activeEntities.count() || l_entities.size() > FrameHeader::m_maxNumEntities) {
+				return false;
+			}
+
+			SnapshotReader lv_reader{ l_snapshot, l_sizeInBytes };
+			std::bitset<FrameHeader::m_maxNumEntities> lv_seenEntities{};
+
+			//An entity's snapshot has a fixed size for its components, which is taken from the live entity.
+			std::vector<uint8_t> lv_scratch{};
+
+			for (uint32_t i = 0; i < l_totalNumActiveEntities; ++i) {
+
+				if (lv_reader.GetTotalNumRemainingBytes() < sizeof(EntityMetaData)) {
+					return false;
+				}
+
+				EntityMetaData lv_entityMetaData{};
+				lv_reader.Peek(lv_entityMetaData);
+
+				if (lv_entityMetaData.m_id >= (uint32_t)l_entities.size() || false == l_activeEntities.test(lv_entityMetaData.m_id)
+					|| true == lv_seenEntities.test(lv_entityMetaData.m_id) || l_entities[lv_entityMetaData.m_id].GetType() != lv_entityMetaData.m_type) {
+					return false;
+				}
+
+				lv_seenEntities.set(lv_entityMetaData.m_id);
+
+				lv_scratch.clear();
+				SnapshotWriter lv_writer{ lv_scratch };
+				l_entities[lv_entityMetaData.m_id].Snapshot(lv_writer);
+
+				if (lv_reader.GetTotalNumRemainingBytes() < lv_scratch.size()) {
+					return false;
+				}
+
+				lv_reader.SkipBytes(lv_scratch.size());
+			}
+
+			return true == lv_reader.IsAtEnd();
+		}
+
+
+		void Apply(const Frame& l_frame, const std::vector<uint8_t>& l_snapshot, std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, InputSystem& l_inputSystem, float& l_time, uint32_t& l_totalNumBulletsHitAsteroid, CallbacksTimer& l_callbackTimer)
+		{
+			const auto& lv_header = l_frame.m_header;
+
+			l_time = lv_header.m_time;
+			l_totalNumBulletsHitAsteroid = lv_header.m_totalNumBulletsHitAsteroid;
+			l_inputSystem.SetHiddenStateOfMouse(lv_header.m_isMouseHidden);
+			l_inputSystem.SetMousePos(lv_header.m_mousePos);
+			l_callbackTimer.RestoreDelayedCallbacks(l_frame.m_delayedCallbacks.data(), lv_header.m_totalNumDelayedCallbacks);
+
+			//Entities that are active now but were not active in the recorded frame are simply turned off.
+			l_archetypes.ForEachActiveEntity([&](const uint32_t l_entityIndex) -> void
+				{
+					if (false == lv_header.m_activeEntities.test(l_entityIndex)) {
+						DeactivateEntity(l_entities[l_entityIndex]);
+					}
+				});
+
+			assert(lv_header.m_snapshotSizeInBytes == l_snapshot.size());
+
+			SnapshotReader lv_reader{ l_snapshot.data(), l_snapshot.size() };
+
+			for (uint32_t i = 0; i < lv_header.m_totalNumActiveEntities; ++i) {
+
+				EntityMetaData lv_entityMetaData{};
+				lv_reader.Peek(lv_entityMetaData);
+
+				auto& lv_entity = l_entities[lv_entityMetaData.m_id];
+
+				lv_entity.SetActiveState(true);
+				lv_entity.Restore(lv_reader);
+			}
+
+			assert(true == lv_reader.IsAtEnd());
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,316 @@
+
+
+
+#include "Systems/TimeRewind/InputReplayLog.hpp"
+#include "Systems/TimeRewind/FrameState.hpp"
+#include "Entities/EntitySpawnerFromPools.hpp"
+#include "Systems/SnapshotWriter.hpp"
+#include "Systems/SnapshotReader.hpp"
+#include "Systems/LogSystem.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cassert>
+#include <utility>
+
+
+namespace Asteroid
+{
+
+	/*
+	* Layout of a replay file:
+	* [ReplayFileHeader][FrameHeader of the first keyframe][its entities snapshot]
+	* [pools snapshot][random engine state as text][InputFrame * m_totalNumFrames]
+	*/
+	struct ReplayFileHeader final
+	{
+		static constexpr uint32_t m_expectedMagic{ 0x50525341U };
+		static constexpr uint32_t m_currentVersion{ 4U };
+
+		uint32_t m_magic{ m_expectedMagic };
+		uint32_t m_version{ m_currentVersion };
+		uint32_t m_totalNumFrames{};
+		uint32_t m_framesBetweenKeyframes{};
+		uint32_t m_level{};
+		uint32_t m_poolsSnapshotSizeInBytes{};
+		uint32_t m_randomEngineStateSizeInBytes{};
+	};
+
+
+	InputReplayLog::InputReplayLog()
+	{
+
+	}
+
+
+	void InputReplayLog::Init(const uint32_t l_framesBetweenKeyframes)
+	{
+		assert(0U != l_framesBetweenKeyframes);
+
+		m_framesBetweenKeyframes = l_framesBetweenKeyframes;
+		m_inputFrames.reserve(8192U);
+
+		Clear();
+	}
+
+
+	void InputReplayLog::RecordFrame(const InputFrame& l_inputFrame, const std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, const InputSystem& l_inputSystem, const uint32_t l_totalNumBulletsHitAsteroid, const CallbacksTimer& l_callbackTimer, const EntitySpawnerFromPools& l_spawner)
+	{
+		const uint32_t lv_frameIndex = (uint32_t)m_inputFrames.size();
+
+		m_inputFrames.push_back(l_inputFrame);
+
+		CaptureKeyframeIfMissing(lv_frameIndex, l_entities, l_archetypes, l_inputSystem, l_totalNumBulletsHitAsteroid, l_callbackTimer, l_spawner);
+	}
+
+
+	void InputReplayLog::CaptureKeyframeIfMissing(const uint32_t l_frameIndex, const std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, const InputSystem& l_inputSystem, const uint32_t l_totalNumBulletsHitAsteroid, const CallbacksTimer& l_callbackTimer, const EntitySpawnerFromPools& l_spawner)
+	{
+		if (0U != l_frameIndex % m_framesBetweenKeyframes || l_frameIndex / m_framesBetweenKeyframes != m_totalNumKeyframes) {
+			return;
+		}
+
+		CaptureKeyframe(l_frameIndex, m_inputFrames[l_frameIndex].m_time, l_entities, l_archetypes, l_inputSystem, l_totalNumBulletsHitAsteroid, l_callbackTimer, l_spawner);
+	}
+
+
+	void InputReplayLog::CaptureKeyframe(const uint32_t l_frameIndex, const float l_time, const std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, const InputSystem& l_inputSystem, const uint32_t l_totalNumBulletsHitAsteroid, const CallbacksTimer& l_callbackTimer, const EntitySpawnerFromPools& l_spawner)
+	{
+		if (m_keyframes.size() == m_totalNumKeyframes) {
+			m_keyframes.emplace_back();
+		}
+
+		auto& lv_keyframe = m_keyframes[m_totalNumKeyframes];
+		++m_totalNumKeyframes;
+
+		lv_keyframe.m_frameIndex = l_frameIndex;
+		lv_keyframe.m_randomEngine = l_spawner.GetRandomEngine();
+
+		FrameState::Capture(l_entities, l_archetypes, l_inputSystem, l_time, l_totalNumBulletsHitAsteroid, l_callbackTimer, lv_keyframe.m_state);
+
+		lv_keyframe.m_poolsSnapshot.clear();
+		SnapshotWriter lv_writer{ lv_keyframe.m_poolsSnapshot };
+		l_spawner.SnapshotPools(lv_writer);
+	}
+
+
+	uint32_t InputReplayLog::RestoreKeyframe(const uint32_t l_frameIndex, std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, InputSystem& l_inputSystem, float& l_time, uint32_t& l_totalNumBulletsHitAsteroid, CallbacksTimer& l_callbackTimer, EntitySpawnerFromPools& l_spawner) const
+	{
+		assert(0U != m_totalNumKeyframes);
+
+		const uint32_t lv_keyframeIndex = std::min(l_frameIndex / m_framesBetweenKeyframes, m_totalNumKeyframes - 1U);
+		const auto& lv_keyframe = m_keyframes[lv_keyframeIndex];
+
+		FrameState::Apply(lv_keyframe.m_state.m_frame, lv_keyframe.m_state.m_activeEntitiesSnapshot, l_entities, l_archetypes, l_inputSystem, l_time, l_totalNumBulletsHitAsteroid, l_callbackTimer);
+
+		SnapshotReader lv_reader{ lv_keyframe.m_poolsSnapshot.data(), lv_keyframe.m_poolsSnapshot.size() };
+		l_spawner.RestorePools(lv_reader);
+		l_spawner.SetRandomEngine(lv_keyframe.m_randomEngine);
+
+		return lv_keyframe.m_frameIndex;
+	}
+
+
+	const InputFrame& InputReplayLog::GetInputFrame(const uint32_t l_frameIndex) const
+	{
+		assert(l_frameIndex < (uint32_t)m_inputFrames.size());
+		return m_inputFrames[l_frameIndex];
+	}
+
+
+	uint32_t InputReplayLog::GetTotalNumFrames() const
+	{
+		return (uint32_t)m_inputFrames.size();
+	}
+
+
+	uint32_t InputReplayLog::FindFrameAtTime(const float l_time) const
+	{
+		auto lv_iter = std::upper_bound(m_inputFrames.begin(), m_inputFrames.end(), l_time
+			, [](const float l_targetTime, const InputFrame& l_frame) {return l_targetTime < l_frame.m_time; });
+
+		return (m_inputFrames.begin() == lv_iter) ? 0U : (uint32_t)(lv_iter - m_inputFrames.begin()) - 1U;
+	}
+
+
+	void InputReplayLog::GetTimelineRange(float& l_oldestTime, float& l_newestTime) const
+	{
+		l_oldestTime = (true == m_inputFrames.empty()) ? 0.f : m_inputFrames.front().m_time;
+		l_newestTime = (true == m_inputFrames.empty()) ? 0.f : m_inputFrames.back().m_time;
+	}
+
+
+	void InputReplayLog::Truncate(const uint32_t l_totalNumFrames)
+	{
+		if (l_totalNumFrames >= (uint32_t)m_inputFrames.size()) {
+			return;
+		}
+
+		m_inputFrames.resize(l_totalNumFrames);
+
+		const uint32_t lv_totalNumKeyframesToKeep = (l_totalNumFrames + m_framesBetweenKeyframes - 1U) / m_framesBetweenKeyframes;
+		m_totalNumKeyframes = std::min(m_totalNumKeyframes, lv_totalNumKeyframesToKeep);
+	}
+
+
+	uint32_t InputReplayLog::GetOldestReferencedCallbackID() const
+	{
+		if (0U == m_totalNumKeyframes) {
+			return 0U;
+		}
+
+		return m_keyframes[0].m_state.m_frame.m_header.m_oldestDelayedCallbackID;
+	}
+
+
+	void InputReplayLog::Clear()
+	{
+		m_inputFrames.clear();
+		m_totalNumKeyframes = 0U;
+	}
+
+
+	void InputReplayLog::SetLevel(const uint32_t l_level)
+	{
+		m_level = l_level;
+	}
+
+
+	uint32_t InputReplayLog::GetLevel() const
+	{
+		return m_level;
+	}
+
+
+	bool InputReplayLog::SaveToFile(const std::string& l_filePath) const
+	{
+		using namespace LogSystem;
+
+		if (0U == m_totalNumKeyframes) {
+			return false;
+		}
+
+		const auto& lv_keyframe = m_keyframes[0];
+		const auto& lv_keyframeHeader = lv_keyframe.m_state.m_frame.m_header;
+
+		if (0U != lv_keyframeHeader.m_totalNumDelayedCallbacks) {
+			LOG(Severity::WARNING, Channel::PROGRAM_LOGIC, "Replay was not saved since its first frame has pending delayed callbacks.");
+			return false;
+		}
+
+		std::ostringstream lv_randomEngineState{};
+		lv_randomEngineState << lv_keyframe.m_randomEngine;
+		const std::string lv_randomEngineStateText = lv_randomEngineState.str();
+
+		ReplayFileHeader lv_fileHeader{};
+		lv_fileHeader.m_totalNumFrames = (uint32_t)m_inputFrames.size();
+		lv_fileHeader.m_framesBetweenKeyframes = m_framesBetweenKeyframes;
+		lv_fileHeader.m_level = m_level;
+		lv_fileHeader.m_poolsSnapshotSizeInBytes = (uint32_t)lv_keyframe.m_poolsSnapshot.size();
+		lv_fileHeader.m_randomEngineStateSizeInBytes = (uint32_t)lv_randomEngineStateText.size();
+
+		std::ofstream lv_file{ l_filePath, std::ios::binary | std::ios::trunc };
+
+		if (false == lv_file.is_open()) {
+			LOG(Severity::WARNING, Channel::PROGRAM_LOGIC, "Failed to open the replay file %s for writing.", l_filePath.c_str());
+			return false;
+		}
+
+		lv_file.write((const char*)&lv_fileHeader, sizeof(ReplayFileHeader));
+		lv_file.write((const char*)&lv_keyframeHeader, sizeof(FrameHeader));
+		lv_file.write((const char*)lv_keyframe.m_state.m_activeEntitiesSnapshot.data(), lv_keyframe.m_state.m_activeEntitiesSnapshot.size());
+		lv_file.write((const char*)lv_keyframe.m_poolsSnapshot.data(), lv_keyframe.m_poolsSnapshot.size());
+		lv_file.write(lv_randomEngineStateText.data(), lv_randomEngineStateText.size());
+		lv_file.write((const char*)m_inputFrames.data(), sizeof(InputFrame) * m_inputFrames.size());
+
+		return true == lv_file.good();
+	}
+
+
+	bool InputReplayLog::LoadFromFile(const std::string& l_filePath, const std::vector<Entity>& l_entities, const EntitySpawnerFromPools& l_spawner)
+	{
+		using namespace LogSystem;
+
+		std::ifstream lv_file{ l_filePath, std::ios::binary | std::ios::ate };
+
+		if (false == lv_file.is_open()) {
+			LOG(Severity::WARNING, Channel::PROGRAM_LOGIC, "Failed to open the replay file %s.", l_filePath.c_str());
+			return false;
+		}
+
+		const uint64_t lv_fileSizeInBytes = (uint64_t)lv_file.tellg();
+		lv_file.seekg(0);
+
+		ReplayFileHeader lv_fileHeader{};
+		FrameHeader lv_keyframeHeader{};
+		lv_file.read((char*)&lv_fileHeader, sizeof(ReplayFileHeader));
+		lv_file.read((char*)&lv_keyframeHeader, sizeof(FrameHeader));
+
+		if (false == lv_file.good() || ReplayFileHeader::m_expectedMagic != lv_fileHeader.m_magic 
+			|| ReplayFileHeader::m_currentVersion != lv_fileHeader.m_version || 0U == lv_fileHeader.m_framesBetweenKeyframes) {
+			LOG(Severity::WARNING, Channel::PROGRAM_LOGIC, "%s is not a replay file this version of the game can play.", l_filePath.c_str());
+			return false;
+		}
+
+		//The sizes come from the file itself, so they are checked against its length before anything is allocated for them.
+		const uint64_t lv_expectedSizeInBytes = sizeof(ReplayFileHeader) + sizeof(FrameHeader)
+			+ (uint64_t)lv_keyframeHeader.m_snapshotSizeInBytes
+			+ (uint64_t)lv_fileHeader.m_poolsSnapshotSizeInBytes
+			+ (uint64_t)lv_fileHeader.m_randomEngineStateSizeInBytes
+			+ sizeof(InputFrame) * (uint64_t)lv_fileHeader.m_totalNumFrames;
+
+		if (lv_expectedSizeInBytes != lv_fileSizeInBytes || 0U == lv_fileHeader.m_totalNumFrames || 0U != lv_keyframeHeader.m_totalNumDelayedCallbacks) {
+			LOG(Severity::WARNING, Channel::PROGRAM_LOGIC, "Replay file %s is corrupted.", l_filePath.c_str());
+			return false;
+		}
+
+		std::vector<uint8_t> lv_entitiesSnapshot(lv_keyframeHeader.m_snapshotSizeInBytes);
+		lv_file.read((char*)lv_entitiesSnapshot.data(), lv_entitiesSnapshot.size());
+
+		std::vector<uint8_t> lv_poolsSnapshot(lv_fileHeader.m_poolsSnapshotSizeInBytes);
+		lv_file.read((char*)lv_poolsSnapshot.data(), lv_poolsSnapshot.size());
+
+		std::string lv_randomEngineStateText(lv_fileHeader.m_randomEngineStateSizeInBytes, '\0');
+		lv_file.read(lv_randomEngineStateText.data(), lv_randomEngineStateText.size());
+
+		std::vector<InputFrame> lv_inputFrames(lv_fileHeader.m_totalNumFrames);
+		lv_file.read((char*)lv_inputFrames.data(), sizeof(InputFrame) * lv_inputFrames.size());
+
+		std::istringstream lv_randomEngineState{ lv_randomEngineStateText };
+		std::mt19937 lv_randomEngine{};
+		lv_randomEngineState >> lv_randomEngine;
+
+		SnapshotReader lv_poolsReader{ lv_poolsSnapshot.data(), lv_poolsSnapshot.size() };
+
+		if (false == lv_file.good() || true == lv_randomEngineState.fail()
+			|| false == FrameState::ValidateSnapshot(lv_keyframeHeader.m_activeEntities, lv_keyframeHeader.m_totalNumActiveEntities
+				, lv_entitiesSnapshot.data(), lv_entitiesSnapshot.size(), l_entities)
+			|| false == l_spawner.ValidatePoolsSnapshot(lv_poolsReader)) {
+			LOG(Severity::WARNING, Channel::PROGRAM_LOGIC, "Replay file %s is corrupted.", l_filePath.c_str());
+			return false;
+		}
+
+		//Everything was checked, only now is the log replaced.
+		Init(lv_fileHeader.m_framesBetweenKeyframes);
+		m_level = lv_fileHeader.m_level;
+		m_inputFrames.assign(lv_inputFrames.begin(), lv_inputFrames.end());
+
+		if (true == m_keyframes.empty()) {
+			m_keyframes.emplace_back();
+		}
+
+		auto& lv_keyframe = m_keyframes[0];
+
+		lv_keyframe.m_frameIndex = 0U;
+		lv_keyframe.m_state.m_frame.m_header = lv_keyframeHeader;
+		lv_keyframe.m_state.m_frame.m_delayedCallbacks.clear();
+		lv_keyframe.m_state.m_activeEntitiesSnapshot = std::move(lv_entitiesSnapshot);
+		lv_keyframe.m_poolsSnapshot = std::move(lv_poolsSnapshot);
+		lv_keyframe.m_randomEngine = lv_randomEngine;
+
+		m_totalNumKeyframes = 1U;
+
+		return true;
+	}
+
+}
\ No newline at end of file
@@ -5,18 +5,14 @@
 
 
 #include "Systems/TimeRewind/TimeRewind.hpp"
-#include "Entities/Entity.hpp"
-#include "Components/StateComponents/ActiveBasedStateComponent.hpp"
-#include "Components/AttributeComponents/AsteroidAttributeComponent.hpp"
-#include "Components/IndefiniteRepeatableAnimationComponent.hpp"
-#include "Components/CollisionComponents/AsteroidCollisionComponent.hpp"
-#include "Components/CollisionComponents/BulletCollisionComponent.hpp"
-#include "Components/CollisionComponents/PlayerCollisionComponent.hpp"
-#include "Components/RayMovementComponent.hpp"
-#include "Components/MovementComponents/UserInputBasedMovementComponent.hpp"
-#include "Components/OnceRepeatableAnimationComponent.hpp"
-#include "Systems/InputSystem.hpp"
+#include "Systems/TimeRewind/DeltaCompression.hpp"
+#include "Systems/TimeRewind/FrameState.hpp"
 #include "Systems/CallbacksTimer.hpp"
+#include "Systems/LogSystem.hpp"
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
 
 
 
@@ -24,337 +20,429 @@ namespace Asteroid
 {
 
 	TimeRewind::TimeRewind()
-		:m_startIndex(0U)
-		,m_endIndex(m_startIndex)
 	{
-		m_pastFrame.resize(m_totalNumPastFramesToRecord);
-		
-
-		for (auto& l_frame : m_pastFrame) {
-			
-			l_frame.m_allEntitysMetaDataInThisFrame[0].m_collisionMetaData.m_alreadyRegisteredCollisionEntityIDs.reserve(128U);
-			l_frame.m_delayedCallbacks.reserve(1024U);
+		for (auto& l_capture : m_captures) {
+			l_capture.m_frame.m_delayedCallbacks.reserve(1024U);
 		}
 
+		m_newestFrame.m_delayedCallbacks.reserve(1024U);
+		m_decodedFrame.m_delayedCallbacks.reserve(1024U);
+
+		m_worker = std::thread(&TimeRewind::WorkerLoop, this);
 	}
 
 
-	void TimeRewind::Update(const std::vector<Entity>& l_entities, const InputSystem& l_inputSystem,const float l_time, const uint32_t l_totalNumBulletsHitAsteroid, const std::vector<DelayedSetStateCallback>& l_delayedCallbacks)
+	TimeRewind::~TimeRewind()
 	{
-		auto& lv_frame = m_pastFrame[m_endIndex];
-		lv_frame.m_time = l_time;
-		lv_frame.m_totalNumBulletsHitAsteroid = l_totalNumBulletsHitAsteroid;
+		{
+			std::lock_guard<std::mutex> lv_lock(m_captureMutex);
+			m_stopWorker = true;
+		}
 
-		lv_frame.m_mousePos = l_inputSystem.GetMousePosRelativeToWindow();
-		lv_frame.m_isMouseHidden = l_inputSystem.IsMouseHidden();
-		lv_frame.m_delayedCallbacks = l_delayedCallbacks;
+		m_captureCondition.notify_all();
+		m_worker.join();
+	}
 
-		for (size_t i = 0; i < l_entities.size(); ++i) {
 
-			auto& lv_entity = lv_frame.m_allEntitysMetaDataInThisFrame[i];
+	bool TimeRewind::Init(const TimeRewindInitData& l_initData)
+	{
+		using namespace LogSystem;
 
-			const auto lv_entityType = l_entities[i].GetType();
+		WaitForWorkerToBeIdle();
 
-			const auto* lv_activeComp = (ActiveBasedStateComponent*)l_entities[i].GetComponent(ComponentTypes::ACTIVE_BASED_STATE);
+		assert(0U != l_initData.m_framesBetweenKeyframes);
+		m_framesBetweenKeyframes = l_initData.m_framesBetweenKeyframes;
 
-			if (nullptr != lv_activeComp) {
-				lv_entity.m_activeMetaData.m_delayedActivateCallbackAlreadySet = lv_activeComp->IsDelayedCallbackAlreadySet();
-			}
+		m_inMemoryStorage.resize(l_initData.m_memoryBudgetInBytes);
+		m_inMemoryRecords.Init(m_inMemoryStorage.data(), m_inMemoryStorage.size(), sizeof(FrameHeader));
 
+		if (0U == l_initData.m_spillFileSizeInBytes) {
+			return true;
+		}
 
-			lv_entity.m_entityMetaData.m_id = l_entities[i].GetID();
-			lv_entity.m_entityMetaData.m_isActive = l_entities[i].GetActiveState();
-			lv_entity.m_entityMetaData.m_pos = l_entities[i].GetCurrentPos();
-			lv_entity.m_entityMetaData.m_type = lv_entityType;
+		std::error_code lv_error{};
+		const std::string lv_spillFilePath = (false == l_initData.m_spillFilePath.empty()) ? l_initData.m_spillFilePath
+			: (std::filesystem::temp_directory_path(lv_error) / "AsteroidTimeRewindHistory.bin").string();
 
+		if (true == bool(lv_error) || false == m_spillFile.OpenTemporary(lv_spillFilePath, l_initData.m_spillFileSizeInBytes)) {
+			LOG(Severity::WARNING, Channel::MEMORY, "Time rewind history is not going to spill to disk.");
+			return false;
+		}
 
-			const auto* lv_indefiniteRepeatAnimComponent = (IndefiniteRepeatableAnimationComponent*)l_entities[i].GetComponent(ComponentTypes::INDEFINITE_ENTITY_ANIMATION);
-			lv_entity.m_indefRepAnimMetaData.m_currentOffset = lv_indefiniteRepeatAnimComponent->GetCurrentOffset();
-			lv_entity.m_indefRepAnimMetaData.m_isInWindowBounds = lv_indefiniteRepeatAnimComponent->IsInWindowBounds();
-			lv_entity.m_indefRepAnimMetaData.m_isVisible = lv_indefiniteRepeatAnimComponent->GetVisibility();
+		m_spilledRecords.Init(m_spillFile.GetData(), m_spillFile.GetSizeInBytes(), sizeof(FrameHeader));
 
+		return true;
+	}
 
-			const AsteroidAttributeComponent* lv_asteroidAttribComponent{};
-			const AsteroidCollisionComponent* lv_asteroidCollisionComp{};
-			const RayMovementComponent* lv_asteroidMovComponent{};
-			const OnceRepeatableAnimationComponent* lv_explosionAnim{};
-			const OnceRepeatableAnimationComponent* lv_warpAnim{};
-			const BulletCollisionComponent* lv_bulletCollisionComp{};
-			const RayMovementComponent* lv_bulletMovComponent{};
-			AttributeComponent* lv_playerAttribComponent{};
-			const UserInputBasedMovementComponent* lv_playerMovComponent{};
-			const PlayerCollisionComponent* lv_playerCollisionComp{};
 
+	void TimeRewind::Update(const std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, const InputSystem& l_inputSystem,const float l_time, const uint32_t l_totalNumBulletsHitAsteroid, CallbacksTimer& l_callbackTimer)
+	{
+		l_callbackTimer.ReleaseRegisteredCallbacksOlderThan(m_oldestReferencedCallbackID.load());
 
-			switch (lv_entityType) {
+		uint32_t lv_captureIndex{};
 
-			case EntityType::ASTEROID:
+		{
+			std::lock_guard<std::mutex> lv_lock(m_captureMutex);
 
-				lv_asteroidAttribComponent = (AsteroidAttributeComponent*)l_entities[i].GetComponent(ComponentTypes::ATTRIBUTE);
-				lv_entity.m_attribMetaData.m_hp = lv_asteroidAttribComponent->GetHp();
-				lv_entity.m_attribMetaData.m_asteroidStates = lv_asteroidAttribComponent->GetState();
+			if ((uint32_t)m_captures.size() == m_totalNumPendingCaptures) {
+				++m_totalNumDroppedCaptures;
+				LOG(Severity::WARNING, Channel::MEMORY, "Time rewind worker is behind, dropped frame capture (%u so far).", m_totalNumDroppedCaptures);
+				return;
+			}
 
+			//Only the main thread adds captures, so this slot stays free until it is handed over below.
+			lv_captureIndex = (m_oldestPendingCapture + m_totalNumPendingCaptures) % (uint32_t)m_captures.size();
+		}
 
-				lv_asteroidCollisionComp = (AsteroidCollisionComponent*)l_entities[i].GetComponent(ComponentTypes::COLLISION);
-				lv_entity.m_collisionMetaData.m_firstCollision = lv_asteroidCollisionComp->IsFirstCollision();
-				lv_entity.m_collisionMetaData.m_hitBullet = lv_asteroidCollisionComp->IsHitByBullet();
-				lv_entity.m_collisionMetaData.m_isCollisionActive = lv_asteroidCollisionComp->GetCollisionState();
-				lv_entity.m_collisionMetaData.m_resetCollision = lv_asteroidCollisionComp->IsCollisionReset();
+		FrameState::Capture(l_entities, l_archetypes, l_inputSystem, l_time, l_totalNumBulletsHitAsteroid, l_callbackTimer, m_captures[lv_captureIndex]);
 
-				lv_asteroidMovComponent = (RayMovementComponent*)l_entities[i].GetComponent(ComponentTypes::MOVEMENT);
-				lv_entity.m_movementMetaData.m_speed = lv_asteroidMovComponent->GetSpeed();
-				lv_entity.m_movementMetaData.m_thetaDegrees = lv_asteroidMovComponent->GetCurrentAngleOfRotation();
-				lv_entity.m_movementMetaData.m_pauseMovement = lv_asteroidMovComponent->GetPauseState();
-				lv_entity.m_movementMetaData.m_rayDirection = lv_asteroidMovComponent->GetRayDirection();
-				lv_entity.m_movementMetaData.m_initialT = lv_asteroidMovComponent->GetInitalT();
-				lv_entity.m_movementMetaData.m_initialPos = lv_asteroidMovComponent->GetInitialPos();
+		{
+			std::lock_guard<std::mutex> lv_lock(m_captureMutex);
+			++m_totalNumPendingCaptures;
+		}
 
+		m_captureCondition.notify_all();
+	}
 
-				lv_explosionAnim = (OnceRepeatableAnimationComponent*)l_entities[i].GetComponent(ComponentTypes::EXPLOSION_FIRE_ASTEROID_ANIMATION);
-				lv_warpAnim = (OnceRepeatableAnimationComponent*)l_entities[i].GetComponent(ComponentTypes::WARP_ASTEROID_ANIMATION);
 
-				lv_entity.m_onceRepAnimMetaData[0].m_currentOffset = lv_explosionAnim->GetCurrentOffset();
-				lv_entity.m_onceRepAnimMetaData[0].m_initialPos = lv_explosionAnim->GetInitialAnimationPos();
-				lv_entity.m_onceRepAnimMetaData[0].m_startAnimation = lv_explosionAnim->AnimationHasStarted();
+	void TimeRewind::WorkerLoop()
+	{
+		while (true) {
 
+			std::unique_lock<std::mutex> lv_lock(m_captureMutex);
+			m_captureCondition.wait(lv_lock, [this]() {return 0U != m_totalNumPendingCaptures || true == m_stopWorker; });
 
-				lv_entity.m_onceRepAnimMetaData[1].m_currentOffset = lv_warpAnim->GetCurrentOffset();
-				lv_entity.m_onceRepAnimMetaData[1].m_initialPos = lv_warpAnim->GetInitialAnimationPos();
-				lv_entity.m_onceRepAnimMetaData[1].m_startAnimation = lv_warpAnim->AnimationHasStarted();
+			if (true == m_stopWorker) {
+				return;
+			}
 
-				break;
+			auto& lv_capture = m_captures[m_oldestPendingCapture];
+			lv_lock.unlock();
 
-			case EntityType::BULLET:
+			InsertCaptureIntoHistory(lv_capture);
 
-				lv_bulletCollisionComp = (BulletCollisionComponent*)l_entities[i].GetComponent(ComponentTypes::COLLISION);
-				lv_entity.m_collisionMetaData.m_isCollisionActive = lv_bulletCollisionComp->GetCollisionState();
-				lv_entity.m_collisionMetaData.m_firstCollision = lv_bulletCollisionComp->IsFirstCollision();
-				lv_entity.m_collisionMetaData.m_resetCollision = lv_bulletCollisionComp->IsCollisionReset();
-				
+			lv_lock.lock();
+			m_oldestPendingCapture = (m_oldestPendingCapture + 1U) % (uint32_t)m_captures.size();
+			--m_totalNumPendingCaptures;
+			lv_lock.unlock();
 
+			m_captureCondition.notify_all();
+		}
+	}
 
-				lv_bulletMovComponent = (RayMovementComponent*)l_entities[i].GetComponent(ComponentTypes::MOVEMENT);
-				lv_entity.m_movementMetaData.m_speed = lv_bulletMovComponent->GetSpeed();
-				lv_entity.m_movementMetaData.m_thetaDegrees = lv_bulletMovComponent->GetCurrentAngleOfRotation();
-				lv_entity.m_movementMetaData.m_pauseMovement = lv_bulletMovComponent->GetPauseState();
-				lv_entity.m_movementMetaData.m_rayDirection = lv_bulletMovComponent->GetRayDirection();
-				lv_entity.m_movementMetaData.m_initialT = lv_bulletMovComponent->GetInitalT();
-				lv_entity.m_movementMetaData.m_initialPos = lv_bulletMovComponent->GetInitialPos();
 
+	void TimeRewind::WaitForWorkerToBeIdle()
+	{
+		std::unique_lock<std::mutex> lv_lock(m_captureMutex);
+		m_captureCondition.wait(lv_lock, [this]() {return 0U == m_totalNumPendingCaptures; });
+	}
 
-				break;
 
-			case EntityType::PLAYER:
+	void TimeRewind::InsertCaptureIntoHistory(FrameCapture& l_capture)
+	{
+		l_capture.m_frame.m_header.m_frameNumber = (true == m_hasNewestFrame) ? m_newestFrame.m_header.m_frameNumber + 1U : 0U;
 
-				lv_playerAttribComponent = (AttributeComponent*)l_entities[i].GetComponent(ComponentTypes::ATTRIBUTE);
-				lv_entity.m_attribMetaData.m_hp = lv_playerAttribComponent->GetHp();
+		//The newest frame now becomes a record that only keeps the delta
+		//which brings it back from the snapshot being inserted.
+		if (true == m_hasNewestFrame) {
 
+			auto& lv_header = m_newestFrame.m_header;
+			lv_header.m_isKeyframe = (0U == lv_header.m_frameNumber % m_framesBetweenKeyframes);
 
-				lv_playerMovComponent = (UserInputBasedMovementComponent*)l_entities[i].GetComponent(ComponentTypes::MOVEMENT);
-				lv_entity.m_movementMetaData.m_speed = lv_playerMovComponent->GetSpeed();
-				lv_entity.m_movementMetaData.m_thetaDegrees = lv_playerMovComponent->GetCurrentAngleOfRotation();
-				lv_entity.m_movementMetaData.m_pauseMovement = lv_playerMovComponent->GetPauseState();
-				
+			if (true == lv_header.m_isKeyframe) {
+				DeltaCompression::CompressXorDelta(std::vector<uint8_t>{}, m_newestSnapshot, m_compressedDelta);
+			}
+			else {
+				DeltaCompression::CompressXorDelta(m_newestSnapshot, l_capture.m_activeEntitiesSnapshot, m_compressedDelta);
+			}
 
-				lv_playerCollisionComp = (PlayerCollisionComponent*)l_entities[i].GetComponent(ComponentTypes::COLLISION);
-				lv_entity.m_collisionMetaData.m_firstCollision = lv_playerCollisionComp->IsFirstCollision();
-				lv_entity.m_collisionMetaData.m_isCollisionActive = lv_playerCollisionComp->GetCollisionState();
-				lv_entity.m_collisionMetaData.m_resetCollision = lv_playerCollisionComp->IsCollisionReset();
-				lv_entity.m_collisionMetaData.m_alreadyRegisteredCollisionEntityIDs = lv_playerCollisionComp->GetAlreadyRegisteredCollisionIDs();
-				break;
+			lv_header.m_compressedDeltaSizeInBytes = (uint32_t)m_compressedDelta.size();
 
+			const size_t lv_callbacksSizeInBytes = sizeof(DelayedCallbackState) * lv_header.m_totalNumDelayedCallbacks;
 
-			}
+			m_record.resize(sizeof(FrameHeader) + lv_callbacksSizeInBytes + m_compressedDelta.size());
+			memcpy(m_record.data(), &lv_header, sizeof(FrameHeader));
+			memcpy(m_record.data() + sizeof(FrameHeader), m_newestFrame.m_delayedCallbacks.data(), lv_callbacksSizeInBytes);
+			memcpy(m_record.data() + sizeof(FrameHeader) + lv_callbacksSizeInBytes, m_compressedDelta.data(), m_compressedDelta.size());
 
+			FrameRecordLog* lv_spillLog = (true == m_spillFile.IsOpen()) ? &m_spilledRecords : nullptr;
+			m_inMemoryRecords.Append(m_record.data(), m_record.size(), lv_spillLog);
 		}
 
+		m_newestFrame.m_header = l_capture.m_frame.m_header;
 
-		++m_endIndex;
-		m_endIndex %= m_totalNumPastFramesToRecord;
+		//Swapping hands the old buffers back to the capture so their capacity gets reused.
+		m_newestFrame.m_delayedCallbacks.swap(l_capture.m_frame.m_delayedCallbacks);
+		m_newestSnapshot.swap(l_capture.m_activeEntitiesSnapshot);
+		m_hasNewestFrame = true;
+
+		PublishHistoryBounds();
+	}
+
+
+	void TimeRewind::PublishHistoryBounds()
+	{
+		FrameHeader lv_oldestHeader{};
 
-		if (m_endIndex == m_startIndex) {
-			++m_startIndex;
-			m_startIndex %= m_totalNumPastFramesToRecord;
+		if (0U != GetTotalNumFrames()) {
+			ReadRecordHeader(0U, lv_oldestHeader);
 		}
 
+		m_oldestReferencedCallbackID.store(lv_oldestHeader.m_oldestDelayedCallbackID);
 
+		std::lock_guard<std::mutex> lv_lock(m_captureMutex);
+		m_oldestFrameTime = lv_oldestHeader.m_time;
+		m_newestFrameTime = m_newestFrame.m_header.m_time;
 	}
 
 
-	void TimeRewind::RewindTimeByOneFrame(std::vector<Entity>& l_entities, InputSystem& l_inputSystem,float& l_time, uint32_t& l_totalNumBulletsHitAsteroid, CallbacksTimer& l_callbackTimer)
+	void TimeRewind::GetTimelineRange(float& l_oldestTime, float& l_newestTime)
 	{
-		uint32_t lv_index{};
+		std::lock_guard<std::mutex> lv_lock(m_captureMutex);
+		l_oldestTime = m_oldestFrameTime;
+		l_newestTime = m_newestFrameTime;
+	}
 
-		if (m_endIndex == m_startIndex) {
-			lv_index = m_startIndex;
-		}
-		else if (0U == m_endIndex) {
-			m_endIndex = m_totalNumPastFramesToRecord - 1U;
-			lv_index = m_endIndex;
+
+	uint32_t TimeRewind::GetTotalNumFrames() const
+	{
+		if (false == m_hasNewestFrame) {
+			return 0U;
 		}
-		else {
-			--m_endIndex;
-			lv_index = m_endIndex;
+
+		return m_spilledRecords.GetTotalNumRecords() + m_inMemoryRecords.GetTotalNumRecords() + 1U;
+	}
+
+
+	const uint8_t* TimeRewind::GetRecord(const uint32_t l_position, size_t& l_sizeInBytes) const
+	{
+		const uint32_t lv_totalNumSpilledRecords = m_spilledRecords.GetTotalNumRecords();
+
+		if (l_position < lv_totalNumSpilledRecords) {
+			return m_spilledRecords.GetRecord(l_position, l_sizeInBytes);
 		}
 
-		auto& lv_frame = m_pastFrame[lv_index];
+		return m_inMemoryRecords.GetRecord(l_position - lv_totalNumSpilledRecords, l_sizeInBytes);
+	}
 
-		l_time = lv_frame.m_time;
-		l_totalNumBulletsHitAsteroid = lv_frame.m_totalNumBulletsHitAsteroid;
-		l_inputSystem.SetHiddenStateOfMouse(lv_frame.m_isMouseHidden);
-		l_inputSystem.SetMousePos(lv_frame.m_mousePos);
-		l_callbackTimer.SetDelayedCallbacks(lv_frame.m_delayedCallbacks);
 
-		for (size_t i = 0; i < l_entities.size(); ++i) {
+	void TimeRewind::ReadRecordHeader(const uint32_t l_position, FrameHeader& l_header) const
+	{
+		if (l_position + 1U == GetTotalNumFrames()) {
+			l_header = m_newestFrame.m_header;
+			return;
+		}
 
-			auto& lv_entity = lv_frame.m_allEntitysMetaDataInThisFrame[i];
+		size_t lv_recordSizeInBytes{};
+		memcpy(&l_header, GetRecord(l_position, lv_recordSizeInBytes), sizeof(FrameHeader));
+	}
 
 
-			auto* lv_activeComp = (ActiveBasedStateComponent*)l_entities[i].GetComponent(ComponentTypes::ACTIVE_BASED_STATE);
+	void TimeRewind::DecodeFrame(const uint32_t l_position, Frame& l_frame, std::vector<uint8_t>& l_snapshot) const
+	{
+		const uint32_t lv_newestPosition = GetTotalNumFrames() - 1U;
 
-			if (nullptr != lv_activeComp) {
-				lv_activeComp->SetDelayedActivationCallbackFlag(lv_entity.m_activeMetaData.m_delayedActivateCallbackAlreadySet);
-			}
+		if (l_position == lv_newestPosition) {
+			l_frame.m_header = m_newestFrame.m_header;
+			l_frame.m_delayedCallbacks = m_newestFrame.m_delayedCallbacks;
+			l_snapshot = m_newestSnapshot;
+			return;
+		}
 
-			l_entities[i].SetActiveState(lv_entity.m_entityMetaData.m_isActive);
-			l_entities[i].SetCurrentPos(lv_entity.m_entityMetaData.m_pos);
+		//Keyframes are every m_framesBetweenKeyframes frame numbers and frame numbers are
+		//consecutive, so this loop runs at most that many times.
+		uint32_t lv_keyframePosition = l_position;
+		FrameHeader lv_header{};
 
-			auto* lv_indefiniteRepeatAnimComponent = (IndefiniteRepeatableAnimationComponent*)l_entities[i].GetComponent(ComponentTypes::INDEFINITE_ENTITY_ANIMATION);
-			lv_indefiniteRepeatAnimComponent->SetCurrentOffset(lv_entity.m_indefRepAnimMetaData.m_currentOffset);
-			lv_indefiniteRepeatAnimComponent->SetVisibleState(lv_entity.m_indefRepAnimMetaData.m_isVisible);
-			lv_indefiniteRepeatAnimComponent->SetWindowsBound(lv_entity.m_indefRepAnimMetaData.m_isInWindowBounds);
+		while (true) {
 
+			if (lv_keyframePosition == lv_newestPosition) {
+				l_snapshot = m_newestSnapshot;
+				break;
+			}
 
+			ReadRecordHeader(lv_keyframePosition, lv_header);
 
-			AsteroidAttributeComponent* lv_asteroidAttribComponent{};
-			AsteroidCollisionComponent* lv_asteroidCollisionComp{};
-			RayMovementComponent* lv_asteroidMovComponent{};
-			OnceRepeatableAnimationComponent* lv_explosionAnim{};
-			OnceRepeatableAnimationComponent* lv_warpAnim{};
-			BulletCollisionComponent* lv_bulletCollisionComp{};
-			RayMovementComponent* lv_bulletMovComponent{};
-			AttributeComponent* lv_playerAttribComponent{};
-			UserInputBasedMovementComponent* lv_playerMovComponent{};
-			PlayerCollisionComponent* lv_playerCollisionComp{};
+			if (true == lv_header.m_isKeyframe) {
+				l_snapshot.clear();
+				break;
+			}
 
+			++lv_keyframePosition;
+		}
 
+		//Walking back from the keyframe. The keyframe itself is decoded against an empty snapshot.
+		const uint32_t lv_firstPositionToDecode = (lv_keyframePosition == lv_newestPosition) ? lv_keyframePosition - 1U : lv_keyframePosition;
 
+		for (int64_t i = (int64_t)lv_firstPositionToDecode; i >= (int64_t)l_position; --i) {
 
-			switch (lv_entity.m_entityMetaData.m_type) {
+			size_t lv_recordSizeInBytes{};
+			const uint8_t* lv_record = GetRecord((uint32_t)i, lv_recordSizeInBytes);
 
-			case EntityType::ASTEROID:
+			memcpy(&lv_header, lv_record, sizeof(FrameHeader));
 
-				lv_asteroidAttribComponent = (AsteroidAttributeComponent*)l_entities[i].GetComponent(ComponentTypes::ATTRIBUTE);
-				lv_asteroidAttribComponent->SetHP(lv_entity.m_attribMetaData.m_hp);
-				lv_asteroidAttribComponent->SetState(lv_entity.m_attribMetaData.m_asteroidStates);
+			const size_t lv_callbacksSizeInBytes = sizeof(DelayedCallbackState) * lv_header.m_totalNumDelayedCallbacks;
+			DeltaCompression::ApplyCompressedXorDelta(lv_record + sizeof(FrameHeader) + lv_callbacksSizeInBytes
+				, lv_header.m_compressedDeltaSizeInBytes, l_snapshot, lv_header.m_snapshotSizeInBytes);
 
+			if ((uint32_t)i == l_position) {
+				l_frame.m_header = lv_header;
+				l_frame.m_delayedCallbacks.resize(lv_header.m_totalNumDelayedCallbacks);
+				memcpy(l_frame.m_delayedCallbacks.data(), lv_record + sizeof(FrameHeader), lv_callbacksSizeInBytes);
+			}
+		}
+	}
 
-				lv_asteroidCollisionComp = (AsteroidCollisionComponent*)l_entities[i].GetComponent(ComponentTypes::COLLISION);				
-				lv_asteroidCollisionComp->SetCollisionFirstFlag(lv_entity.m_collisionMetaData.m_firstCollision);
-				lv_asteroidCollisionComp->SetCollisionState(lv_entity.m_collisionMetaData.m_isCollisionActive);
-				lv_asteroidCollisionComp->SetCollisionResetFlag(lv_entity.m_collisionMetaData.m_resetCollision);
-				lv_asteroidCollisionComp->SetBulletHitFlag(lv_entity.m_collisionMetaData.m_hitBullet);
 
-				lv_asteroidMovComponent = (RayMovementComponent*)l_entities[i].GetComponent(ComponentTypes::MOVEMENT);
-				lv_asteroidMovComponent->SetAngleOfRotation(lv_entity.m_movementMetaData.m_thetaDegrees);
-				lv_asteroidMovComponent->SetSpeed(lv_entity.m_movementMetaData.m_speed);
-				lv_asteroidMovComponent->SetInitialPos(lv_entity.m_movementMetaData.m_initialPos);
-				lv_asteroidMovComponent->SetInitialT(lv_entity.m_movementMetaData.m_initialT);
-				lv_asteroidMovComponent->SetPauseState(lv_entity.m_movementMetaData.m_pauseMovement);
-				lv_asteroidMovComponent->SetRayDirection(lv_entity.m_movementMetaData.m_rayDirection);
+	uint32_t TimeRewind::FindFrameAtTime(const float l_time) const
+	{
+		//Frame times never decrease, so the last frame at or before l_time can be binary searched.
+		uint32_t lv_low = 0U;
+		uint32_t lv_high = GetTotalNumFrames();
+		FrameHeader lv_header{};
 
+		while (lv_low < lv_high) {
 
-				lv_explosionAnim = (OnceRepeatableAnimationComponent*)l_entities[i].GetComponent(ComponentTypes::EXPLOSION_FIRE_ASTEROID_ANIMATION);
-				lv_warpAnim = (OnceRepeatableAnimationComponent*)l_entities[i].GetComponent(ComponentTypes::WARP_ASTEROID_ANIMATION);
+			const uint32_t lv_middle = lv_low + (lv_high - lv_low) / 2U;
+			ReadRecordHeader(lv_middle, lv_header);
 
-				lv_explosionAnim->SetAnimationStartState(lv_entity.m_onceRepAnimMetaData[0].m_startAnimation);
-				lv_explosionAnim->SetCurrentOffset(lv_entity.m_onceRepAnimMetaData[0].m_currentOffset);
-				lv_explosionAnim->SetInitialAnimationPos(lv_entity.m_onceRepAnimMetaData[0].m_initialPos);
+			if (lv_header.m_time <= l_time) {
+				lv_low = lv_middle + 1U;
+			}
+			else {
+				lv_high = lv_middle;
+			}
+		}
 
-				lv_warpAnim->SetAnimationStartState(lv_entity.m_onceRepAnimMetaData[1].m_startAnimation);
-				lv_warpAnim->SetCurrentOffset(lv_entity.m_onceRepAnimMetaData[1].m_currentOffset);
-				lv_warpAnim->SetInitialAnimationPos(lv_entity.m_onceRepAnimMetaData[1].m_initialPos);
+		return (0U == lv_low) ? 0U : lv_low - 1U;
+	}
 
-				break;
 
-			case EntityType::BULLET:
+	void TimeRewind::PopNewestRecordIntoNewestFrame()
+	{
+		FrameRecordLog* lv_log{};
 
-				lv_bulletCollisionComp = (BulletCollisionComponent*)l_entities[i].GetComponent(ComponentTypes::COLLISION);
-				lv_bulletCollisionComp->SetCollisionFirstFlag(lv_entity.m_collisionMetaData.m_firstCollision);
-				lv_bulletCollisionComp->SetCollisionResetFlag(lv_entity.m_collisionMetaData.m_resetCollision);
-				lv_bulletCollisionComp->SetCollisionState(lv_entity.m_collisionMetaData.m_isCollisionActive);
+		if (false == m_inMemoryRecords.IsEmpty()) {
+			lv_log = &m_inMemoryRecords;
+		}
+		else if (false == m_spilledRecords.IsEmpty()) {
+			lv_log = &m_spilledRecords;
+		}
 
+		//Reached the oldest frame we have. It stays the newest one.
+		if (nullptr == lv_log) {
+			return;
+		}
 
-				lv_bulletMovComponent = (RayMovementComponent*)l_entities[i].GetComponent(ComponentTypes::MOVEMENT);
-				lv_bulletMovComponent->SetAngleOfRotation(lv_entity.m_movementMetaData.m_thetaDegrees);
-				lv_bulletMovComponent->SetSpeed(lv_entity.m_movementMetaData.m_speed);
-				lv_bulletMovComponent->SetInitialPos(lv_entity.m_movementMetaData.m_initialPos);
-				lv_bulletMovComponent->SetInitialT(lv_entity.m_movementMetaData.m_initialT);
-				lv_bulletMovComponent->SetPauseState(lv_entity.m_movementMetaData.m_pauseMovement);
-				lv_bulletMovComponent->SetRayDirection(lv_entity.m_movementMetaData.m_rayDirection);
+		size_t lv_recordSizeInBytes{};
+		const uint8_t* lv_record = lv_log->GetNewestRecord(lv_recordSizeInBytes);
 
-				break;
+		auto& lv_header = m_newestFrame.m_header;
+		memcpy(&lv_header, lv_record, sizeof(FrameHeader));
 
-			case EntityType::PLAYER:
+		const size_t lv_callbacksSizeInBytes = sizeof(DelayedCallbackState) * lv_header.m_totalNumDelayedCallbacks;
+		assert(sizeof(FrameHeader) + lv_callbacksSizeInBytes + lv_header.m_compressedDeltaSizeInBytes == lv_recordSizeInBytes);
 
-				lv_playerAttribComponent = (AttributeComponent*)l_entities[i].GetComponent(ComponentTypes::ATTRIBUTE);
-				lv_playerAttribComponent->SetHP(lv_entity.m_attribMetaData.m_hp);
+		m_newestFrame.m_delayedCallbacks.resize(lv_header.m_totalNumDelayedCallbacks);
+		memcpy(m_newestFrame.m_delayedCallbacks.data(), lv_record + sizeof(FrameHeader), lv_callbacksSizeInBytes);
 
+		if (true == lv_header.m_isKeyframe) {
+			m_newestSnapshot.clear();
+		}
 
-				lv_playerMovComponent = (UserInputBasedMovementComponent*)l_entities[i].GetComponent(ComponentTypes::MOVEMENT);
-				lv_playerMovComponent->SetAngleOfRotation(lv_entity.m_movementMetaData.m_thetaDegrees);
-				lv_playerMovComponent->SetPauseState(lv_entity.m_movementMetaData.m_pauseMovement);
-				lv_playerMovComponent->SetSpeed(lv_entity.m_movementMetaData.m_speed);
+		DeltaCompression::ApplyCompressedXorDelta(lv_record + sizeof(FrameHeader) + lv_callbacksSizeInBytes
+			, lv_header.m_compressedDeltaSizeInBytes, m_newestSnapshot, lv_header.m_snapshotSizeInBytes);
 
+		lv_log->PopNewestRecord();
+	}
 
-				lv_playerCollisionComp = (PlayerCollisionComponent*)l_entities[i].GetComponent(ComponentTypes::COLLISION);
-				lv_playerCollisionComp->SetAlreadyRegisteredCollisionIDs(lv_entity.m_collisionMetaData.m_alreadyRegisteredCollisionEntityIDs);
-				lv_playerCollisionComp->SetCollisionFirstFlag(lv_entity.m_collisionMetaData.m_firstCollision);
-				lv_playerCollisionComp->SetCollisionResetFlag(lv_entity.m_collisionMetaData.m_resetCollision);
-				lv_playerCollisionComp->SetCollisionState(lv_entity.m_collisionMetaData.m_isCollisionActive);
-				break;
 
+	void TimeRewind::RewindTimeByFrames(const uint32_t l_totalNumFrames, std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, InputSystem& l_inputSystem,float& l_time, uint32_t& l_totalNumBulletsHitAsteroid, CallbacksTimer& l_callbackTimer)
+	{
+		WaitForWorkerToBeIdle();
 
-			}
+		const uint32_t lv_totalNumFramesInHistory = GetTotalNumFrames();
 
+		//Nothing has been recorded yet.
+		if (0U == lv_totalNumFramesInHistory) {
+			return;
 		}
 
+		//Going back 1 frame means restoring the newest one since the current state is not recorded yet.
+		const uint32_t lv_totalNumFramesBack = (0U == l_totalNumFrames) ? 1U : l_totalNumFrames;
+		const uint32_t lv_position = (lv_totalNumFramesBack >= lv_totalNumFramesInHistory) ? 0U : lv_totalNumFramesInHistory - lv_totalNumFramesBack;
+
+		RestoreFrame(lv_position, true, l_entities, l_archetypes, l_inputSystem, l_time, l_totalNumBulletsHitAsteroid, l_callbackTimer);
+	}
+
 
+	void TimeRewind::SeekToTime(const float l_targetTime, const bool l_truncateHistory, std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, InputSystem& l_inputSystem, float& l_time, uint32_t& l_totalNumBulletsHitAsteroid, CallbacksTimer& l_callbackTimer)
+	{
+		WaitForWorkerToBeIdle();
 
+		if (0U == GetTotalNumFrames()) {
+			return;
+		}
 
+		RestoreFrame(FindFrameAtTime(l_targetTime), l_truncateHistory, l_entities, l_archetypes, l_inputSystem, l_time, l_totalNumBulletsHitAsteroid, l_callbackTimer);
 	}
 
 
-	void TimeRewind::Flush()
+	void TimeRewind::RestoreFrame(const uint32_t l_position, const bool l_truncateHistory, std::vector<Entity>& l_entities, const ArchetypeTables& l_archetypes, InputSystem& l_inputSystem, float& l_time, uint32_t& l_totalNumBulletsHitAsteroid, CallbacksTimer& l_callbackTimer)
 	{
-		m_startIndex = 0U;
-		m_endIndex = m_startIndex;
-		
-		for (auto& l_frame : m_pastFrame) {
-			l_frame.m_time = 0.f;
-			l_frame.m_mousePos = glm::vec2(0.f);
-			l_frame.m_totalNumBulletsHitAsteroid = 0U;
-			l_frame.m_isMouseHidden = false;
-			
-			for (auto& l_entityData : l_frame.m_allEntitysMetaDataInThisFrame) {
-
-				if (EntityType::CURSOR != l_entityData.m_entityMetaData.m_type) {
-
-					l_entityData.m_activeMetaData.m_delayedActivateCallbackAlreadySet = false;
-					l_entityData.m_attribMetaData.m_asteroidStates = AsteroidStates::AGGRESIVE;
-					l_entityData.m_attribMetaData.m_hp = 10;
-					l_entityData.m_collisionMetaData.m_alreadyRegisteredCollisionEntityIDs.clear();
-					l_entityData.m_collisionMetaData.m_firstCollision = true;
-					l_entityData.m_collisionMetaData.m_hitBullet = 0U;
-					l_entityData.m_collisionMetaData.m_isCollisionActive = true;
-					l_entityData.m_collisionMetaData.m_resetCollision = true;
-
-					memset(&l_entityData.m_indefRepAnimMetaData, 0, sizeof(l_entityData.m_indefRepAnimMetaData));
-					memset(&l_entityData.m_movementMetaData, 0, sizeof(l_entityData.m_movementMetaData));
-					memset(l_entityData.m_onceRepAnimMetaData.data(), 0, sizeof(OnceRepeatAnimationMetaData) * l_entityData.m_onceRepAnimMetaData.size());
+		const uint32_t lv_newestPosition = GetTotalNumFrames() - 1U;
+
+		if (l_position == lv_newestPosition) {
+			FrameState::Apply(m_newestFrame, m_newestSnapshot, l_entities, l_archetypes, l_inputSystem, l_time, l_totalNumBulletsHitAsteroid, l_callbackTimer);
+		}
+		else {
+			DecodeFrame(l_position, m_decodedFrame, m_decodedSnapshot);
+			FrameState::Apply(m_decodedFrame, m_decodedSnapshot, l_entities, l_archetypes, l_inputSystem, l_time, l_totalNumBulletsHitAsteroid, l_callbackTimer);
+		}
+
+		if (false == l_truncateHistory) {
+			return;
+		}
+
+		//Everything after the restored frame is dropped without being decoded and the restored
+		//frame becomes the newest one.
+		if (l_position != lv_newestPosition) {
+
+			for (uint32_t i = l_position; i < lv_newestPosition; ++i) {
+				if (false == m_inMemoryRecords.IsEmpty()) {
+					m_inMemoryRecords.PopNewestRecord();
+				}
+				else {
+					m_spilledRecords.PopNewestRecord();
 				}
 			}
+
+			m_newestFrame.m_header = m_decodedFrame.m_header;
+			m_newestFrame.m_delayedCallbacks.swap(m_decodedFrame.m_delayedCallbacks);
+			m_newestSnapshot.swap(m_decodedSnapshot);
 		}
+
+		//The state of the game is now the one of the newest frame. The next capture is going 
+		//to record it again, so the frame before it becomes the newest in the history.
+		PopNewestRecordIntoNewestFrame();
+
+		PublishHistoryBounds();
+	}
+
+
+	void TimeRewind::Flush()
+	{
+		WaitForWorkerToBeIdle();
+
+		m_hasNewestFrame = false;
+		m_newestFrame.m_header = FrameHeader{};
+		m_newestFrame.m_delayedCallbacks.clear();
+		m_newestSnapshot.clear();
+
+		m_inMemoryRecords.Clear();
+		m_spilledRecords.Clear();
+
+		PublishHistoryBounds();
 	}
 
 }
\ No newline at end of file
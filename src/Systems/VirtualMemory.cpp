@@ -0,0 +1,254 @@
+
+
+
+
+#include "Systems/VirtualMemory.hpp"
+#include "Systems/LogSystem.hpp"
+#include <algorithm>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+namespace Asteroid
+{
+	namespace VirtualMemory
+	{
+
+		size_t GetPageSize()
+		{
+#ifdef _WIN32
+			static const size_t lv_pageSize = []() {
+				SYSTEM_INFO lv_systemInfo{};
+				GetSystemInfo(&lv_systemInfo);
+				return (size_t)lv_systemInfo.dwPageSize;
+			}();
+#else
+			static const size_t lv_pageSize = (size_t)sysconf(_SC_PAGESIZE);
+#endif
+			return lv_pageSize;
+		}
+
+
+		size_t GetHugePageSize()
+		{
+#ifdef _WIN32
+			//Large pages need the lock pages privilege, which games do not get by default.
+			return 0U;
+#elif defined(MADV_HUGEPAGE)
+			return 2U * 1024U * 1024U;
+#else
+			return 0U;
+#endif
+		}
+
+
+		size_t RoundUpToPageSize(const size_t l_sizeInBytes)
+		{
+			const size_t lv_pageSize = GetPageSize();
+			return ((l_sizeInBytes + lv_pageSize - 1U) / lv_pageSize) * lv_pageSize;
+		}
+
+
+		void* Allocate(const size_t l_sizeInBytes, const bool l_preferHugePages)
+		{
+			using namespace LogSystem;
+
+			const size_t lv_sizeInBytes = RoundUpToPageSize(l_sizeInBytes);
+
+#ifdef _WIN32
+
+			(void)l_preferHugePages;
+
+			void* lv_memory = VirtualAlloc(nullptr, lv_sizeInBytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+			if (nullptr == lv_memory) {
+				LOG(Severity::FAILURE, Channel::MEMORY, "VirtualAlloc failed to allocate %zu bytes.", lv_sizeInBytes);
+			}
+
+			return lv_memory;
+
+#else
+
+			void* lv_memory = mmap(nullptr, lv_sizeInBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+			if (MAP_FAILED == lv_memory) {
+				LOG(Severity::FAILURE, Channel::MEMORY, "mmap failed to allocate %zu bytes.", lv_sizeInBytes);
+				return nullptr;
+			}
+
+#ifdef MADV_HUGEPAGE
+			//Only advice, so failing here just means regular pages.
+			if (true == l_preferHugePages) {
+				madvise(lv_memory, lv_sizeInBytes, MADV_HUGEPAGE);
+			}
+#else
+			(void)l_preferHugePages;
+#endif
+
+			return lv_memory;
+
+#endif
+		}
+
+
+		void Free(void* l_memory, const size_t l_sizeInBytes)
+		{
+			if (nullptr == l_memory) {
+				return;
+			}
+
+#ifdef _WIN32
+			(void)l_sizeInBytes;
+			VirtualFree(l_memory, 0, MEM_RELEASE);
+#else
+			munmap(l_memory, RoundUpToPageSize(l_sizeInBytes));
+#endif
+		}
+
+
+		void Prefault(void* l_memory, const size_t l_sizeInBytes)
+		{
+			const size_t lv_sizeInBytes = RoundUpToPageSize(l_sizeInBytes);
+
+#ifdef MADV_POPULATE_WRITE
+			if (0 == madvise(l_memory, lv_sizeInBytes, MADV_POPULATE_WRITE)) {
+				return;
+			}
+#endif
+
+			//Writing back a byte of every page faults it in everywhere without changing the contents.
+			volatile uint8_t* lv_bytes = static_cast<volatile uint8_t*>(l_memory);
+			const size_t lv_pageSize = GetPageSize();
+
+			for (size_t i = 0; i < lv_sizeInBytes; i += lv_pageSize) {
+				lv_bytes[i] = lv_bytes[i];
+			}
+		}
+
+
+		bool Lock(void* l_memory, const size_t l_sizeInBytes)
+		{
+			using namespace LogSystem;
+
+			const size_t lv_sizeInBytes = RoundUpToPageSize(l_sizeInBytes);
+
+#ifdef _WIN32
+			const bool lv_locked = (0 != VirtualLock(l_memory, lv_sizeInBytes));
+#else
+			const bool lv_locked = (0 == mlock(l_memory, lv_sizeInBytes));
+#endif
+
+			if (false == lv_locked) {
+				LOG(Severity::WARNING, Channel::MEMORY, "Failed to lock %zu bytes of memory.", lv_sizeInBytes);
+			}
+
+			return lv_locked;
+		}
+
+
+		void* Reserve(const size_t l_sizeInBytes, const size_t l_alignment, const bool l_preferHugePages)
+		{
+			using namespace LogSystem;
+
+			const size_t lv_sizeInBytes = RoundUpToPageSize(l_sizeInBytes);
+
+#ifdef _WIN32
+
+			//Reservations are always aligned to the allocation granularity, which is as far as alignment matters without large pages.
+			(void)l_alignment;
+			(void)l_preferHugePages;
+
+			void* lv_memory = VirtualAlloc(nullptr, lv_sizeInBytes, MEM_RESERVE, PAGE_NOACCESS);
+
+			if (nullptr == lv_memory) {
+				LOG(Severity::FAILURE, Channel::MEMORY, "VirtualAlloc failed to reserve %zu bytes.", lv_sizeInBytes);
+			}
+
+			return lv_memory;
+
+#else
+
+			//More than asked for is reserved so an aligned range fits, and the rest is unmapped again.
+			const size_t lv_alignment = std::max(l_alignment, GetPageSize());
+			const size_t lv_totalSizeInBytes = lv_sizeInBytes + lv_alignment - GetPageSize();
+
+			void* lv_memory = mmap(nullptr, lv_totalSizeInBytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+			if (MAP_FAILED == lv_memory) {
+				LOG(Severity::FAILURE, Channel::MEMORY, "mmap failed to reserve %zu bytes.", lv_totalSizeInBytes);
+				return nullptr;
+			}
+
+			const auto lv_start = reinterpret_cast<uintptr_t>(lv_memory);
+			const auto lv_alignedStart = (lv_start + lv_alignment - 1U) & ~(uintptr_t)(lv_alignment - 1U);
+			const auto lv_alignedEnd = lv_alignedStart + lv_sizeInBytes;
+
+			if (lv_start != lv_alignedStart) {
+				munmap(lv_memory, lv_alignedStart - lv_start);
+			}
+
+			if (lv_start + lv_totalSizeInBytes != lv_alignedEnd) {
+				munmap(reinterpret_cast<void*>(lv_alignedEnd), lv_start + lv_totalSizeInBytes - lv_alignedEnd);
+			}
+
+#ifdef MADV_HUGEPAGE
+			//The advice stays on the range, so every part committed later can be backed by huge pages.
+			if (true == l_preferHugePages) {
+				madvise(reinterpret_cast<void*>(lv_alignedStart), lv_sizeInBytes, MADV_HUGEPAGE);
+			}
+#else
+			(void)l_preferHugePages;
+#endif
+
+			return reinterpret_cast<void*>(lv_alignedStart);
+
+#endif
+		}
+
+
+		bool Commit(void* l_memory, const size_t l_sizeInBytes)
+		{
+			using namespace LogSystem;
+
+			const size_t lv_sizeInBytes = RoundUpToPageSize(l_sizeInBytes);
+
+#ifdef _WIN32
+			const bool lv_committed = (nullptr != VirtualAlloc(l_memory, lv_sizeInBytes, MEM_COMMIT, PAGE_READWRITE));
+#else
+			const bool lv_committed = (0 == mprotect(l_memory, lv_sizeInBytes, PROT_READ | PROT_WRITE));
+#endif
+
+			if (false == lv_committed) {
+				LOG(Severity::FAILURE, Channel::MEMORY, "Failed to commit %zu bytes of reserved memory.", lv_sizeInBytes);
+			}
+
+			return lv_committed;
+		}
+
+
+		void Decommit(void* l_memory, const size_t l_sizeInBytes)
+		{
+			const size_t lv_sizeInBytes = RoundUpToPageSize(l_sizeInBytes);
+
+#ifdef _WIN32
+			VirtualFree(l_memory, lv_sizeInBytes, MEM_DECOMMIT);
+#else
+			//The pages are dropped and the range faults again if it is touched before the next Commit().
+			madvise(l_memory, lv_sizeInBytes, MADV_DONTNEED);
+			mprotect(l_memory, lv_sizeInBytes, PROT_NONE);
+#endif
+		}
+
+
+		void Release(void* l_memory, const size_t l_sizeInBytes)
+		{
+			Free(l_memory, l_sizeInBytes);
+		}
+
+	}
+}
\ No newline at end of file
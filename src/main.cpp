@@ -3,6 +3,7 @@
 #include "Engine.hpp"
 #include "Utilities/UtilityFunctions.hpp"
 #include <iostream>
+#include <cstdlib>
 
 
 void FillMeta(Asteroid::AnimationMetaData& l_meta, uint32_t l_firstIndex
@@ -16,7 +17,7 @@ void FillMeta(Asteroid::AnimationMetaData& l_meta, uint32_t l_firstIndex
 }
 
 
-int main()
+int main(int argc, char* argv[])
 {
 
 	using namespace Asteroid;
@@ -68,6 +69,39 @@ int main()
 		, 250, 150));
 	
 
+	//--input-replay rewinds by re-simulating recorded input instead of storing snapshots.
+	//--play-replay <file> plays back a replay saved in that mode.
+	//--rewind-spill-mb <n> lets the rewind history overflow into a temporary mapped file of that many MB.
+	//--alloc-check <frames> fails if any of that many frames after the warm up allocates on the heap.
+	//--job-workers <n> sets how many worker threads run jobs next to the main thread.
+	//--pin-job-workers pins every job worker to its own core on Linux.
+	//--verify-system-access fails if a system touches data it did not declare.
+	for (int i = 1; i < argc; ++i) {
+		const std::string lv_argument{ argv[i] };
+
+		if ("--input-replay" == lv_argument) {
+			lv_engineInitialData.m_timeRewindInitData.m_mode = TimeRewindMode::INPUT_REPLAY;
+		}
+		else if ("--play-replay" == lv_argument && i + 1 < argc) {
+			lv_engineInitialData.m_timeRewindInitData.m_replayToPlayPath = argv[++i];
+		}
+		else if ("--rewind-spill-mb" == lv_argument && i + 1 < argc) {
+			lv_engineInitialData.m_timeRewindInitData.m_spillFileSizeInBytes = (size_t)std::strtoul(argv[++i], nullptr, 10) * 1024U * 1024U;
+		}
+		else if ("--alloc-check" == lv_argument && i + 1 < argc) {
+			lv_engineInitialData.m_totalNumAllocationCheckFrames = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+		}
+		else if ("--job-workers" == lv_argument && i + 1 < argc) {
+			lv_engineInitialData.m_totalNumJobWorkers = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+		}
+		else if ("--pin-job-workers" == lv_argument) {
+			lv_engineInitialData.m_pinJobWorkersToCores = true;
+		}
+		else if ("--verify-system-access" == lv_argument) {
+			lv_engineInitialData.m_verifySystemAccess = true;
+		}
+	}
+
 	
 		std::unique_ptr<Engine> lv_engine = std::make_unique<Engine>(std::move(lv_engineInitialData));
 